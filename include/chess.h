@@ -5,17 +5,29 @@
 extern "C" {
 #endif
 
+#include <chess/allocator.h>
+#include <chess/book.h>
 #include <chess/castling_rights.h>
 #include <chess/color.h>
 #include <chess/file.h>
+#include <chess/game.h>
+#include <chess/game_tree.h>
+#include <chess/mate.h>
 #include <chess/move.h>
 #include <chess/moves.h>
+#include <chess/network.h>
+#include <chess/pawn_table.h>
 #include <chess/piece.h>
 #include <chess/piece_type.h>
 #include <chess/position.h>
 #include <chess/position_counter.h>
 #include <chess/rank.h>
+#include <chess/score.h>
+#include <chess/search.h>
 #include <chess/square.h>
+#include <chess/tablebase.h>
+#include <chess/transposition_table.h>
+#include <chess/unmoves.h>
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,81 @@
+/**
+ * @file chess/allocator.h
+ * @brief Defines the chess allocator type, through which containers of the library get their memory.
+ * @author Tarek Saeed
+ * @date 2026-10-19
+ */
+
+#ifndef CHESS_ALLOCATOR_H_INCLUDED
+#define CHESS_ALLOCATOR_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <chess/macros.h>
+
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 202311L
+	#include <stdbool.h>
+#endif
+#include <stddef.h>
+
+/**
+ * @brief Function allocating a block of memory.
+ * @param[in] size The size of the block in bytes, never zero.
+ * @param[in] data The data given with the function in the allocator.
+ * @return Pointer to the block, aligned for any type, or `CHESS_NULL` if the allocation failed.
+ */
+typedef void *ChessAllocateFunction(size_t size, void *data);
+
+/**
+ * @brief Function releasing a block of memory returned by the allocation function of the same allocator.
+ * @param[in] pointer Pointer to the block, never `CHESS_NULL`.
+ * @param[in] size The size the block was allocated with.
+ * @param[in] data The data given with the function in the allocator.
+ */
+typedef void ChessDeallocateFunction(void *pointer, size_t size, void *data);
+
+/**
+ * @struct ChessAllocator
+ * @brief Represents a source of memory, such as a pool or an arena shared by the containers of a game.
+ */
+typedef struct ChessAllocator {
+	ChessAllocateFunction *allocate;     /**< Pointer to the function to allocate blocks with. */
+	ChessDeallocateFunction *deallocate; /**< Pointer to the function to release blocks with. */
+	void *data;                          /**< The data passed to the functions. */
+} ChessAllocator;
+
+/**
+ * @brief Checks if the given allocator is valid.
+ * @param[in] allocator Pointer to the allocator to check.
+ * @return true if the allocator is valid, false otherwise.
+ */
+bool chess_allocator_is_valid(const ChessAllocator *allocator);
+
+/**
+ * @brief Gets the default allocator, which allocates with `malloc` and releases with `free`.
+ * @return The default allocator.
+ */
+ChessAllocator chess_allocator_default(void);
+
+/**
+ * @brief Allocates a block of memory from the given allocator.
+ * @param[in] allocator Pointer to the allocator.
+ * @param[in] size The size of the block in bytes, not zero.
+ * @return Pointer to the block, or `CHESS_NULL` if the allocation failed.
+ */
+void *chess_allocator_allocate(const ChessAllocator *allocator, size_t size);
+
+/**
+ * @brief Releases a block of memory allocated from the given allocator.
+ * @param[in] allocator Pointer to the allocator.
+ * @param[in] pointer Pointer to the block, or `CHESS_NULL` to do nothing.
+ * @param[in] size The size the block was allocated with.
+ */
+void chess_allocator_deallocate(const ChessAllocator *allocator, void *pointer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_ALLOCATOR_H_INCLUDED
@@ -0,0 +1,124 @@
+/**
+ * @file chess/book.h
+ * @brief Defines the chess book type and related functions for looking up moves in Polyglot opening books.
+ * @author Tarek Saeed
+ * @date 2026-10-19
+ */
+
+#ifndef CHESS_BOOK_H_INCLUDED
+#define CHESS_BOOK_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <chess/macros.h>
+#include <chess/move.h>
+
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 202311L
+	#include <stdbool.h>
+#endif
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Forward declaration of ChessPosition.
+ */
+typedef struct ChessPosition ChessPosition;
+
+/**
+ * @brief The size in bytes of an entry of a book file.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_BOOK_ENTRY_SIZE, 16);
+
+/**
+ * @enum ChessBookSelection
+ * @brief Represents how a move is chosen among the moves a book holds for a position.
+ */
+CHESS_ENUM(uint8_t, ChessBookSelection){
+	CHESS_BOOK_SELECTION_BEST,     /**< The move with the largest weight. */
+	CHESS_BOOK_SELECTION_WEIGHTED, /**< A random move, chosen with probability proportional to its weight. */
+};
+
+/**
+ * @struct ChessBook
+ * @brief Represents a memory-mapped Polyglot opening book.
+ *
+ * A book file consists of 16-byte big-endian entries sorted by key, each holding a 64-bit Polyglot key of a position, a
+ * 16-bit move, a 16-bit weight and 32 bits of learning data which is ignored. The move holds the destination file and
+ * rank in bits 0 to 5, the source file and rank in bits 6 to 11 and the promotion (knight 1 to queen 4) in bits 12 to
+ * 14, castlings being encoded as the king capturing its own rook.
+ */
+typedef struct ChessBook {
+	const uint8_t *entries; /**< The entries of the book. */
+	size_t entry_count;     /**< The number of entries. */
+	void *mapping;          /**< The memory mapping of the book file, or `CHESS_NULL` if no book is loaded. */
+	size_t mapping_size;    /**< The size of the memory mapping in bytes. */
+} ChessBook;
+
+/**
+ * @brief Checks if the given book is valid.
+ * @param[in] book Pointer to the book to check.
+ * @return true if the book is valid, false otherwise.
+ */
+bool chess_book_is_valid(const ChessBook *book);
+
+/**
+ * @brief Creates a new, empty book.
+ * @return The created book.
+ */
+ChessBook chess_book_new(void);
+
+/**
+ * @brief Releases resources held by the given book, unmapping its file.
+ * @param[inout] book Pointer to the book to drop.
+ */
+void chess_book_drop(ChessBook *book);
+
+/**
+ * @brief Memory-maps the book file at the given path into the given book, replacing the book already loaded.
+ *
+ * The entries are read lazily as positions are looked up, so only a sample of them is checked for being sorted.
+ *
+ * @param[inout] book Pointer to the book.
+ * @param[in] path The path of the book file.
+ * @return true if successful, false otherwise.
+ */
+bool chess_book_load(ChessBook *book, const char *path);
+
+/**
+ * @brief Computes the Polyglot key of the given position, which differs from `chess_position_hash` and only includes
+ * the en passant file when a pawn of the side to move can capture en passant.
+ * @param[in] position Pointer to the position.
+ * @return The Polyglot key of the position.
+ */
+uint64_t chess_book_key(const ChessPosition *position);
+
+/**
+ * @brief Encodes the given move of the given position as the move of a book entry.
+ * @param[in] position Pointer to the position.
+ * @param[in] move The move to encode, which must be legal in the position.
+ * @return The encoded move.
+ */
+uint16_t chess_book_encode_move(const ChessPosition *position, ChessMove move);
+
+/**
+ * @brief Looks up a move for the given position in the given book, by binary search on the keys of its entries.
+ *
+ * Entries whose move is illegal in the position are skipped, as are those with a weight of 0 when the move is chosen
+ * randomly.
+ *
+ * @param[in] book Pointer to the book.
+ * @param[in] position Pointer to the position.
+ * @param[in] selection How the move is chosen among the moves of the position.
+ * @param[in] random A random number choosing the move for `CHESS_BOOK_SELECTION_WEIGHTED`, ignored otherwise.
+ * @param[out] move Pointer to store the move.
+ * @return true if the book holds a move for the position, false otherwise.
+ */
+bool chess_book_probe(const ChessBook *book, const ChessPosition *position, ChessBookSelection selection, uint32_t random, ChessMove *move);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_BOOK_H_INCLUDED
@@ -0,0 +1,158 @@
+/**
+ * @file chess/game.h
+ * @brief Defines the chess game type and related functions for playing moves while keeping the history of a game.
+ * @author Tarek Saeed
+ * @date 2026-10-19
+ */
+
+#ifndef CHESS_GAME_H_INCLUDED
+#define CHESS_GAME_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <chess/allocator.h>
+#include <chess/macros.h>
+#include <chess/move.h>
+#include <chess/position.h>
+#include <chess/position_counter.h>
+
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 202311L
+	#include <stdbool.h>
+#endif
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @struct ChessGame
+ * @brief Represents a game, the current position together with the history of the moves leading to it.
+ *
+ * The game owns the history and the repetition counts, so that the position itself holds no resources and copies of it
+ * are independent of each other. The keys of the positions the moves were played from are kept in order, oldest first,
+ * so they can be handed to the search as the game before its root.
+ *
+ * Moves taken back stay in the history after the moves played until a different move is played, so that browsing back
+ * and forth through a game replays its recorded moves in constant time, without checking them again.
+ */
+typedef struct ChessGame {
+	ChessPosition position;                /**< The current position. */
+	uint64_t *keys;                        /**< Array of the hashes of the positions the moves were played from, followed in the same allocation by the array of moves. */
+	ChessMove *moves;                      /**< Array of the moves played, oldest first. */
+	size_t move_count;                     /**< The number of moves played. */
+	size_t redo_count;                     /**< The number of moves taken back that can be played again, kept after the moves played. */
+	size_t move_capacity;                  /**< The allocated size of the arrays of moves and keys. */
+	ChessPositionCounter position_counter; /**< Counter of the occurrences of the positions of the game, for the threefold repetition rule. */
+	ChessAllocator allocator;              /**< The allocator the history and the counter are allocated from. */
+} ChessGame;
+
+/**
+ * @brief Checks if the given game is valid.
+ * @param[in] game Pointer to the game to check.
+ * @return true if the game is valid, false otherwise.
+ */
+bool chess_game_is_valid(const ChessGame *game);
+
+/**
+ * @brief Creates a new game from the standard starting position.
+ * @return The created game.
+ */
+ChessGame chess_game_new(void);
+
+/**
+ * @brief Creates a new game from the standard starting position that allocates from the given allocator.
+ * @param[in] allocator The allocator to allocate the history of the game from.
+ * @return The created game.
+ */
+ChessGame chess_game_new_with_allocator(ChessAllocator allocator);
+
+/**
+ * @brief Releases resources held by the given game.
+ * @param[inout] game Pointer to the game to drop.
+ */
+void chess_game_drop(ChessGame *game);
+
+/**
+ * @brief Restarts the given game from the given position, forgetting its history.
+ * @param[inout] game Pointer to the game.
+ * @param[in] position Pointer to the position to start from.
+ * @return true on success, false if the allocation failed.
+ */
+bool chess_game_reset(ChessGame *game, const ChessPosition *position);
+
+/**
+ * @brief Makes room in the given game for playing the given number of further moves, so that playing them does not
+ * allocate.
+ * @param[inout] game Pointer to the game.
+ * @param[in] move_count The number of further moves.
+ * @return true on success, false if the allocation failed.
+ */
+bool chess_game_reserve(ChessGame *game, size_t move_count);
+
+/**
+ * @brief Gets the current position of the given game.
+ * @param[in] game Pointer to the game.
+ * @return Pointer to the current position.
+ */
+const ChessPosition *chess_game_position(const ChessGame *game);
+
+/**
+ * @brief Plays the given move in the given game, if it is legal.
+ * @param[inout] game Pointer to the game.
+ * @param[in] move The move to play.
+ * @return true if the move was played, false if it is illegal or the allocation failed.
+ */
+bool chess_game_do_move(ChessGame *game, ChessMove move);
+
+/**
+ * @brief Plays the given moves in order in the given game, stopping at the first illegal one.
+ * @param[inout] game Pointer to the game.
+ * @param[in] moves Pointer to the array of moves.
+ * @param[in] count The number of moves.
+ * @return The number of moves played, which is the index of the first illegal move if it is less than `count`.
+ */
+size_t chess_game_do_moves(ChessGame *game, const ChessMove *moves, size_t count);
+
+/**
+ * @brief Plays the given whitespace separated moves in UCI notation (e.g., "e2e4 e7e5 g1f3") in order in the given game,
+ * stopping at the first one that is malformed or illegal.
+ * @param[inout] game Pointer to the game.
+ * @param[in] string The string containing the moves.
+ * @param[out] move_count Pointer to store the number of moves played.
+ * @return The number of characters read, which stops short of the end of the string at the first move not played.
+ */
+size_t chess_game_do_uci_moves(ChessGame *game, const char *string, size_t *move_count);
+
+/**
+ * @brief Takes back the last move played in the given game, in constant time.
+ * @param[inout] game Pointer to the game.
+ * @return true if a move was taken back, false if no move was played.
+ */
+bool chess_game_undo_move(ChessGame *game);
+
+/**
+ * @brief Plays again the last move taken back in the given game.
+ * @param[inout] game Pointer to the game.
+ * @return true if a move was played again, false if no move can be or the allocation failed.
+ */
+bool chess_game_redo_move(ChessGame *game);
+
+/**
+ * @brief Gets the number of times the current position of the given game has occurred in it.
+ * @param[in] game Pointer to the game.
+ * @return The number of occurrences, including the current one.
+ */
+unsigned int chess_game_repetition_count(const ChessGame *game);
+
+/**
+ * @brief Checks if the current position of the given game has occurred three or more times (threefold repetition).
+ * @param[in] game Pointer to the game.
+ * @return true if the position has occurred three or more times, false otherwise.
+ */
+bool chess_game_is_threefold_repetition(const ChessGame *game);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_GAME_H_INCLUDED
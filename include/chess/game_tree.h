@@ -0,0 +1,164 @@
+/**
+ * @file chess/game_tree.h
+ * @brief Defines the chess game tree type and related functions for storing games together with their variations.
+ * @author Tarek Saeed
+ * @date 2026-10-19
+ */
+
+#ifndef CHESS_GAME_TREE_H_INCLUDED
+#define CHESS_GAME_TREE_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <chess/allocator.h>
+#include <chess/macros.h>
+#include <chess/move.h>
+#include <chess/position.h>
+
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 202311L
+	#include <stdbool.h>
+#endif
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief The index of the root node of a game tree, which stands for its starting position.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint32_t, CHESS_GAME_TREE_ROOT, 0);
+
+/**
+ * @brief The index standing for no node of a game tree.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint32_t, CHESS_GAME_TREE_NONE, INT32_MAX);
+
+/**
+ * @brief The largest number of moves between a node of a game tree and the nearest node whose position is cached.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_GAME_TREE_CHECKPOINT_INTERVAL, 32);
+
+/**
+ * @struct ChessGameTreeNode
+ * @brief Represents a node of a game tree, the position reached by playing a move from the position of its parent.
+ */
+typedef struct ChessGameTreeNode {
+	ChessMove move;        /**< The move leading to the node from its parent, unused for the root. */
+	uint32_t parent;       /**< The index of the parent node, or `CHESS_GAME_TREE_NONE` for the root. */
+	uint32_t first_child;  /**< The index of the first child node, the main line, or `CHESS_GAME_TREE_NONE` if there is none. */
+	uint32_t next_sibling; /**< The index of the next child node of the parent, or `CHESS_GAME_TREE_NONE` if there is none. */
+	uint32_t checkpoint;   /**< The index of the cached position of the node, or `CHESS_GAME_TREE_NONE` if it is not cached. */
+} ChessGameTreeNode;
+
+/**
+ * @struct ChessGameTree
+ * @brief Represents a game together with its variations, as a tree of moves.
+ *
+ * The nodes are kept in a single array and refer to each other by index, and only store the move leading to them. The
+ * position of a node is rebuilt when needed by replaying the moves from the nearest node above it whose position is
+ * cached, which is at most `CHESS_GAME_TREE_CHECKPOINT_INTERVAL` moves away, so that a tree takes a fraction of the
+ * memory of a position per node. The children of a node are in order of importance, the first one being the main line.
+ */
+typedef struct ChessGameTree {
+	ChessGameTreeNode *nodes;   /**< Array of the nodes, the first one being the root once a move is added. */
+	size_t node_count;          /**< The number of nodes. */
+	size_t node_capacity;       /**< The allocated size of the array of nodes. */
+	ChessPosition *checkpoints; /**< Array of the cached positions of the nodes. */
+	size_t checkpoint_count;    /**< The number of cached positions. */
+	size_t checkpoint_capacity; /**< The allocated size of the array of cached positions. */
+	ChessPosition position;     /**< The starting position, the position of the root. */
+	ChessAllocator allocator;   /**< The allocator the arrays are allocated from. */
+} ChessGameTree;
+
+/**
+ * @brief Checks if the given game tree is valid.
+ * @param[in] tree Pointer to the game tree to check.
+ * @return true if the game tree is valid, false otherwise.
+ */
+bool chess_game_tree_is_valid(const ChessGameTree *tree);
+
+/**
+ * @brief Creates a new game tree with no moves from the given starting position.
+ * @param[in] position Pointer to the starting position.
+ * @return The created game tree.
+ */
+ChessGameTree chess_game_tree_new(const ChessPosition *position);
+
+/**
+ * @brief Creates a new game tree with no moves from the given starting position that allocates from the given
+ * allocator.
+ * @param[in] position Pointer to the starting position.
+ * @param[in] allocator The allocator to allocate the nodes and the cached positions from.
+ * @return The created game tree.
+ */
+ChessGameTree chess_game_tree_new_with_allocator(const ChessPosition *position, ChessAllocator allocator);
+
+/**
+ * @brief Releases resources held by the given game tree.
+ * @param[inout] tree Pointer to the game tree to drop.
+ */
+void chess_game_tree_drop(ChessGameTree *tree);
+
+/**
+ * @brief Adds the given move from the given node of the given game tree, as its last child.
+ * @param[inout] tree Pointer to the game tree.
+ * @param[in] node The index of the node to play the move from.
+ * @param[in] move The move to add.
+ * @return The index of the node reached by the move, which is the existing child if the move was already added, or
+ * `CHESS_GAME_TREE_NONE` if the move is illegal or the allocation failed.
+ */
+uint32_t chess_game_tree_add_move(ChessGameTree *tree, uint32_t node, ChessMove move);
+
+/**
+ * @brief Gets the position of the given node of the given game tree.
+ * @param[in] tree Pointer to the game tree.
+ * @param[in] node The index of the node.
+ * @return The position of the node.
+ */
+ChessPosition chess_game_tree_position(const ChessGameTree *tree, uint32_t node);
+
+/**
+ * @brief Gets the move leading to the given node of the given game tree.
+ * @param[in] tree Pointer to the game tree.
+ * @param[in] node The index of the node, not the root.
+ * @return The move leading to the node.
+ */
+ChessMove chess_game_tree_move(const ChessGameTree *tree, uint32_t node);
+
+/**
+ * @brief Gets the parent of the given node of the given game tree.
+ * @param[in] tree Pointer to the game tree.
+ * @param[in] node The index of the node.
+ * @return The index of the parent node, or `CHESS_GAME_TREE_NONE` for the root.
+ */
+uint32_t chess_game_tree_parent(const ChessGameTree *tree, uint32_t node);
+
+/**
+ * @brief Gets the first child of the given node of the given game tree, the continuation of its main line.
+ * @param[in] tree Pointer to the game tree.
+ * @param[in] node The index of the node.
+ * @return The index of the first child node, or `CHESS_GAME_TREE_NONE` if there is none.
+ */
+uint32_t chess_game_tree_first_child(const ChessGameTree *tree, uint32_t node);
+
+/**
+ * @brief Gets the next sibling of the given node of the given game tree, the next variation from its parent.
+ * @param[in] tree Pointer to the game tree.
+ * @param[in] node The index of the node.
+ * @return The index of the next sibling node, or `CHESS_GAME_TREE_NONE` if there is none.
+ */
+uint32_t chess_game_tree_next_sibling(const ChessGameTree *tree, uint32_t node);
+
+/**
+ * @brief Promotes the variation starting at the given node of the given game tree to the main line from its parent,
+ * making the node the first child of its parent.
+ * @param[inout] tree Pointer to the game tree.
+ * @param[in] node The index of the node.
+ */
+void chess_game_tree_promote_variation(ChessGameTree *tree, uint32_t node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_GAME_TREE_H_INCLUDED
@@ -32,6 +32,10 @@
 	#define CHESS_HAS_NULLPTR
 #endif
 
+#if !defined(__cplusplus) && defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+	#define CHESS_HAS_ATOMICS
+#endif
+
 /**
  * @def CHESS_CONSTEXPR
  * @brief Expands to `constexpr` if available, otherwise to `const`.
@@ -97,6 +101,20 @@
 	#define CHESS_NULL NULL
 #endif
 
+/**
+ * @def CHESS_ATOMIC(type)
+ * @brief Expands to `_Atomic(type)` if available, otherwise to `volatile type`.
+ * @param[in] type The type of the object.
+ */
+
+#ifdef CHESS_HAS_ATOMICS
+	#include <stdatomic.h>
+
+	#define CHESS_ATOMIC(type) _Atomic(type)
+#else
+	#define CHESS_ATOMIC(type) volatile type
+#endif
+
 /**
  * @def CHESS_ARRAY_LENGTH(array)
  * @brief Computes the length of the given array.
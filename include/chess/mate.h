@@ -0,0 +1,82 @@
+/**
+ * @file chess/mate.h
+ * @brief Defines the chess mate result type and related functions for proving forced mates by proof-number search.
+ * @author Tarek Saeed
+ * @date 2026-10-19
+ */
+
+#ifndef CHESS_MATE_H_INCLUDED
+#define CHESS_MATE_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <chess/macros.h>
+#include <chess/move.h>
+
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 202311L
+	#include <stdbool.h>
+#endif
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Forward declaration of ChessPosition.
+ */
+typedef struct ChessPosition ChessPosition;
+
+/**
+ * @brief The maximum number of plies of a mating line, beyond which lines are not searched.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_MATE_MAXIMUM_LENGTH, 128);
+
+/**
+ * @brief The number of transposition table entries used when no table size is given.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_MATE_DEFAULT_TABLE_SIZE, 1U << 20U);
+
+/**
+ * @struct ChessMateLimits
+ * @brief Represents the limits that bound a mate search, and the size of its transposition table.
+ */
+typedef struct ChessMateLimits {
+	uint64_t nodes;    /**< The maximum number of nodes to expand, or 0 for no limit. */
+	size_t table_size; /**< The number of entries of the transposition table, rounded down to a power of two, or 0 for `CHESS_MATE_DEFAULT_TABLE_SIZE`. */
+} ChessMateLimits;
+
+/**
+ * @struct ChessMateResult
+ * @brief Represents the result of a mate search.
+ */
+typedef struct ChessMateResult {
+	bool is_proven;                             /**< Whether the side to move was proven to force mate. */
+	ChessMove moves[CHESS_MATE_MAXIMUM_LENGTH]; /**< The mating line, the defending side resisting the longest, if proven. */
+	size_t move_count;                          /**< The number of plies of the mating line, 0 if unproven. */
+	uint64_t nodes;                             /**< The number of nodes expanded. */
+} ChessMateResult;
+
+/**
+ * @brief Searches for a forced mate by the side to move in the given position, using depth-first proof-number search.
+ *
+ * Each node holds a proof number, the least number of leaves to prove in order to prove a mate, and a disproof number,
+ * the least number of leaves to disprove in order to disprove it, both kept in a transposition table. The search
+ * always expands the most-proving node, within thresholds that keep it in a subtree until a sibling becomes more
+ * promising. Leaves start with the number of moves of the side to move as their proof or disproof number, so that
+ * positions in which the defending side has few replies are tried first.
+ *
+ * Repetitions and lines longer than `CHESS_MATE_MAXIMUM_LENGTH` count as escapes, as does insufficient material, so
+ * that mates may be missed but false ones are never proven. Disproofs reached through an escape depend on the path to
+ * the node and are not kept in the table, which makes long drawn lines costly, so a node limit is advisable.
+ *
+ * @param[in] position Pointer to the position to search.
+ * @param[in] limits The limits of the search.
+ * @return The result of the search.
+ */
+ChessMateResult chess_mate_solve(const ChessPosition *position, ChessMateLimits limits);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_MATE_H_INCLUDED
@@ -22,6 +22,7 @@ extern "C" {
 	#include <stdbool.h>
 #endif
 #include <stddef.h>
+#include <stdint.h>
 
 /**
  * @struct ChessMove
@@ -34,9 +35,22 @@ typedef struct ChessMove {
 	ChessPiece captured_piece;                    /**< The piece captured by this move, or CHESS_PIECE_NONE if not a capture. */
 	ChessCastlingRights previous_castling_rights; /**< The castling rights before the move was made. */
 	ChessSquare previous_en_passant_square;       /**< The en passant square before the move was made. */
-	unsigned int previous_half_move_clock;        /**< The half-move clock value before the move was made. */
+	uint16_t previous_half_move_clock;            /**< The half-move clock value before the move was made. */
 } ChessMove;
 
+/**
+ * @struct ChessMoveCheckInfo
+ * @brief Holds what tells, for a given position, whether a move of the side to move gives check in constant time.
+ *
+ * It is computed once per position by following the lines out of the king of the opponent, after which every move is
+ * answered by looking up its source and destination squares.
+ */
+typedef struct ChessMoveCheckInfo {
+	ChessSquare king_square;          /**< The square of the king of the opponent of the side to move. */
+	uint8_t check_types[128];         /**< Array storing, for each square (0x88 board), the set of piece types of the side to move that would attack the king from it, as bits indexed by piece type. */
+	int8_t discovery_directions[128]; /**< Array storing, for each square (0x88 board) holding a piece of the side to move that alone stands between the king and a sliding piece of the side to move, the direction from the king to it, or 0 otherwise. */
+} ChessMoveCheckInfo;
+
 /**
  * @brief Prints a debug representation of the given move.
  * @param[in] move The move to print.
@@ -79,6 +93,24 @@ size_t chess_move_from_algebraic(const ChessPosition *position, ChessMove *move,
  */
 size_t chess_move_to_algebraic(const ChessPosition *position, ChessMove move, char *string, size_t string_size);
 
+/**
+ * @brief Parses a legal move from the long algebraic notation of the UCI protocol (e.g., "e2e4", "e1g1", "e7e8q").
+ * @param[in] position Pointer to the position, the move is for.
+ * @param[out] move Pointer to store the parsed move.
+ * @param[in] string The string containing the notation.
+ * @return The number of characters read if successful, 0 otherwise.
+ */
+size_t chess_move_from_uci(const ChessPosition *position, ChessMove *move, const char *string);
+
+/**
+ * @brief Converts a move to the long algebraic notation of the UCI protocol.
+ * @param[in] move The move to convert.
+ * @param[out] string The buffer to store the notation.
+ * @param[in] string_size The size of the output buffer.
+ * @return The number of characters written.
+ */
+size_t chess_move_to_uci(ChessMove move, char *string, size_t string_size);
+
 /**
  * @brief Checks if the given move is legal in the given position.
  * @param[in] position Pointer to the position, the move is for.
@@ -127,6 +159,31 @@ bool chess_move_is_kingside_castling(const ChessPosition *position, ChessMove mo
  */
 bool chess_move_is_queenside_castling(const ChessPosition *position, ChessMove move);
 
+/**
+ * @brief Computes what tells whether a move of the side to move in the given position gives check.
+ * @param[in] position Pointer to the position.
+ * @return The check information of the position.
+ */
+ChessMoveCheckInfo chess_move_check_info_new(const ChessPosition *position);
+
+/**
+ * @brief Checks if the given move gives check, directly or by uncovering a sliding piece.
+ * @param[in] position Pointer to the position, the move is for.
+ * @param[in] move The move to check, which must be legal.
+ * @return true if the move gives check, false otherwise.
+ */
+bool chess_move_gives_check(const ChessPosition *position, ChessMove move);
+
+/**
+ * @brief Checks if the given move gives check, directly or by uncovering a sliding piece, in constant time using the
+ * given check information.
+ * @param[in] position Pointer to the position, the move is for.
+ * @param[in] info Pointer to the check information of the position.
+ * @param[in] move The move to check, which must be legal.
+ * @return true if the move gives check, false otherwise.
+ */
+bool chess_move_gives_check_with_info(const ChessPosition *position, const ChessMoveCheckInfo *info, ChessMove move);
+
 /**
  * @brief Does the given move on the given position if legal.
  * @param[inout] position Pointer to the position to update.
@@ -0,0 +1,155 @@
+/**
+ * @file chess/network.h
+ * @brief Defines the chess network type and related functions for evaluating positions with an efficiently updatable neural network.
+ * @author Tarek Saeed
+ * @date 2026-10-19
+ */
+
+#ifndef CHESS_NETWORK_H_INCLUDED
+#define CHESS_NETWORK_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <chess/color.h>
+#include <chess/macros.h>
+#include <chess/move.h>
+#include <chess/score.h>
+
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 202311L
+	#include <stdbool.h>
+#endif
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Forward declaration of ChessPosition.
+ */
+typedef struct ChessPosition ChessPosition;
+
+/**
+ * @brief The number of input features of a network, one for each piece on each square from each perspective.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_NETWORK_FEATURE_COUNT, 768);
+
+/**
+ * @brief The maximum size of the hidden layer of a network.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_NETWORK_MAXIMUM_HIDDEN_SIZE, 4096);
+
+/**
+ * @brief The quantisation factor of the hidden layer, which is also the upper bound of its activation.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(int32_t, CHESS_NETWORK_HIDDEN_QUANTISATION, 255);
+
+/**
+ * @brief The quantisation factor of the output layer weights.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(int32_t, CHESS_NETWORK_OUTPUT_QUANTISATION, 64);
+
+/**
+ * @brief The factor converting the output of a network to centipawns.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(int32_t, CHESS_NETWORK_OUTPUT_SCALE, 400);
+
+/**
+ * @enum ChessNetworkInstructionSet
+ * @brief Represents the instruction set used to run a network.
+ */
+CHESS_ENUM(uint8_t, ChessNetworkInstructionSet){
+	CHESS_NETWORK_INSTRUCTION_SET_SCALAR, /**< Portable C, available everywhere. */
+	CHESS_NETWORK_INSTRUCTION_SET_SSE2,   /**< 128-bit integer vectors, available on every x86-64 processor. */
+	CHESS_NETWORK_INSTRUCTION_SET_AVX2,   /**< 256-bit integer vectors, detected at runtime. */
+};
+
+/**
+ * @struct ChessNetwork
+ * @brief Represents a quantised neural network evaluating positions from the perspective of the side to move.
+ *
+ * The network has a hidden layer computed separately from the perspective of each side, whose values are kept in an
+ * accumulator that is updated incrementally as moves are made. The hidden layer of the side to move followed by that of
+ * the other side, clipped to `[0, CHESS_NETWORK_HIDDEN_QUANTISATION]`, feeds a single output neuron.
+ *
+ * A network file is little-endian and consists of the magic bytes "CHNN", a 32-bit version (1), a 32-bit hidden size,
+ * followed by the 16-bit feature weights, the 16-bit feature biases, the 16-bit output weights and the 32-bit output
+ * bias, in the order and layout of the fields below.
+ */
+typedef struct ChessNetwork {
+	size_t hidden_size;                         /**< The size of the hidden layer, a positive multiple of 16. */
+	int16_t *feature_weights;                   /**< The weights of the hidden layer, one row of `hidden_size` weights per feature. */
+	int16_t *feature_biases;                    /**< The biases of the hidden layer, `hidden_size` of them. */
+	int16_t *output_weights;                    /**< The weights of the output layer, `hidden_size` for the side to move followed by `hidden_size` for the other side. */
+	int32_t output_bias;                        /**< The bias of the output layer. */
+	ChessNetworkInstructionSet instruction_set; /**< The instruction set the network is run with, the best one supported by the processor. */
+} ChessNetwork;
+
+/**
+ * @brief Checks if the given network is valid.
+ * @param[in] network Pointer to the network to check.
+ * @return true if the network is valid, false otherwise.
+ */
+bool chess_network_is_valid(const ChessNetwork *network);
+
+/**
+ * @brief Loads a network from the file at the given path.
+ * @param[out] network Pointer to store the loaded network.
+ * @param[in] path The path of the network file.
+ * @return true if successful, false otherwise.
+ */
+bool chess_network_load(ChessNetwork *network, const char *path);
+
+/**
+ * @brief Releases resources held by the given network.
+ * @param[inout] network Pointer to the network to drop.
+ */
+void chess_network_drop(ChessNetwork *network);
+
+/**
+ * @brief Gets the number of values in an accumulator of the given network.
+ * @param[in] network Pointer to the network.
+ * @return The number of values, `2 * hidden_size`.
+ */
+size_t chess_network_accumulator_size(const ChessNetwork *network);
+
+/**
+ * @brief Computes the accumulator of the given position from scratch.
+ * @param[in] network Pointer to the network.
+ * @param[in] position Pointer to the position.
+ * @param[out] accumulator The accumulator to fill, White's perspective followed by Black's.
+ */
+void chess_network_accumulator_refresh(const ChessNetwork *network, const ChessPosition *position, int16_t *accumulator);
+
+/**
+ * @brief Computes the accumulator of the position after the given move from the accumulator of the position before it.
+ *
+ * Only the features changed by the move are added and removed, which is much cheaper than a refresh.
+ *
+ * @param[in] network Pointer to the network.
+ * @param[in] position Pointer to the position before the move.
+ * @param[in] move The move, which must be legal in the position.
+ * @param[in] accumulator The accumulator of the position before the move.
+ * @param[out] accumulator_after_move The accumulator to fill for the position after the move, which must not overlap `accumulator`.
+ */
+void chess_network_accumulator_update(
+    const ChessNetwork *network,
+    const ChessPosition *position,
+    ChessMove move,
+    const int16_t *accumulator,
+    int16_t *accumulator_after_move
+);
+
+/**
+ * @brief Evaluates a position from its accumulator.
+ * @param[in] network Pointer to the network.
+ * @param[in] accumulator The accumulator of the position.
+ * @param[in] side_to_move The side to move in the position.
+ * @return The score of the position in centipawns from the perspective of the side to move.
+ */
+ChessScore chess_network_evaluate(const ChessNetwork *network, const int16_t *accumulator, ChessColor side_to_move);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_NETWORK_H_INCLUDED
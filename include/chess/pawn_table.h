@@ -0,0 +1,92 @@
+/**
+ * @file chess/pawn_table.h
+ * @brief Defines the chess pawn table type and related functions for caching the evaluation of pawn structures.
+ * @author Tarek Saeed
+ * @date 2026-10-19
+ */
+
+#ifndef CHESS_PAWN_TABLE_H_INCLUDED
+#define CHESS_PAWN_TABLE_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <chess/color.h>
+#include <chess/score.h>
+
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 202311L
+	#include <stdbool.h>
+#endif
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Forward declaration of ChessPosition.
+ */
+typedef struct ChessPosition ChessPosition;
+
+/**
+ * @brief Entry in the pawn hash table.
+ *
+ * Stores the evaluation of a pawn structure, keyed by the pawn hash of the position.
+ */
+typedef struct ChessPawnTableEntry {
+	uint64_t key;                         /**< The pawn hash of the position. */
+	ChessScore score;                     /**< The score of the pawn structure from White's perspective. */
+	uint8_t files[CHESS_COLOR_BLACK + 1]; /**< Bit masks of the files holding at least one pawn of each color (bit 0 for the a-file). */
+} ChessPawnTableEntry;
+
+/**
+ * @brief Hash table for caching pawn structure evaluations.
+ *
+ * The pawn structure changes on few moves, so most lookups during a search hit. A table is not safe to share between
+ * threads, each searching thread should own its own.
+ */
+typedef struct ChessPawnTable {
+	ChessPawnTableEntry *entries; /**< Array of entries. */
+	size_t size;                  /**< The number of entries, a power of two or 0. */
+} ChessPawnTable;
+
+/**
+ * @brief Checks if the given pawn table is valid.
+ * @param[in] table Pointer to the pawn table to check.
+ * @return true if the pawn table is valid, false otherwise.
+ */
+bool chess_pawn_table_is_valid(const ChessPawnTable *table);
+
+/**
+ * @brief Creates a new, empty pawn table.
+ *
+ * If the allocation fails, the table has no entries and every probe computes the pawn structure directly.
+ *
+ * @param[in] size The number of entries, rounded down to a power of two.
+ * @return The created pawn table.
+ */
+ChessPawnTable chess_pawn_table_new(size_t size);
+
+/**
+ * @brief Releases resources held by the given pawn table.
+ * @param[inout] table Pointer to the pawn table to drop.
+ */
+void chess_pawn_table_drop(ChessPawnTable *table);
+
+/**
+ * @brief Clears all entries from the given pawn table.
+ * @param[inout] table Pointer to the pawn table to clear.
+ */
+void chess_pawn_table_clear(ChessPawnTable *table);
+
+/**
+ * @brief Gets the pawn structure entry for the given position, computing and storing it on a miss.
+ * @param[inout] table Pointer to the pawn table, or `CHESS_NULL` to compute the entry without caching it.
+ * @param[in] position Pointer to the position.
+ * @return The pawn structure entry of the position.
+ */
+ChessPawnTableEntry chess_pawn_table_probe(ChessPawnTable *table, const ChessPosition *position);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_PAWN_TABLE_H_INCLUDED
@@ -14,30 +14,57 @@ extern "C" {
 
 #include <chess/castling_rights.h>
 #include <chess/color.h>
+#include <chess/macros.h>
+#include <chess/pawn_table.h>
 #include <chess/piece.h>
-#include <chess/position_counter.h>
+#include <chess/score.h>
 #include <chess/square.h>
 
 #if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 202311L
 	#include <stdbool.h>
 #endif
+#include <stddef.h>
 #include <stdint.h>
 
+/**
+ * @brief The game phase of the starting material, from which the evaluation tapers from the midgame to the endgame.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(unsigned int, CHESS_POSITION_MAXIMUM_PHASE, 24);
+
+/**
+ * @brief The maximum number of pieces of a single type and color, the two initial knights, bishops or rooks together
+ * with eight promoted pawns.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_POSITION_MAXIMUM_PIECE_TYPE_COUNT, 10);
+
+/**
+ * @brief Forward declaration of ChessMove.
+ */
+typedef struct ChessMove ChessMove;
+
 /**
  * @struct ChessPosition
  * @brief Represents the position in a chess game.
+ *
+ * A position holds no resources, so it is copied by assignment, the history of the game it is part of being kept by
+ * `ChessGame`. Since the search copies a position for every move it makes, the fields are kept as narrow as they can be,
+ * so that the whole position fits in six cache lines.
  */
 typedef struct ChessPosition {
-	ChessPiece board[128];                                                    /**< Array representing the pieces on each square (0x88 board). */
-	ChessSquare pieces[CHESS_COLOR_BLACK + 1][CHESS_PIECE_TYPE_KING + 1][12]; /**< Array storing the squares of each piece type for both colors. */
-	uint8_t piece_counts[CHESS_COLOR_BLACK + 1][CHESS_PIECE_TYPE_KING + 1];   /**< Array storing the count of each piece type for both colors. */
-	uint8_t piece_indices[128];                                               /**< Array storing the index of the piece on each square in the piece list */
-	ChessColor side_to_move;                                                  /**< The color of the side to move next. */
-	ChessCastlingRights castling_rights;                                      /**< The current castling rights for both sides. */
-	ChessSquare en_passant_square;                                            /**< The square over which a pawn has just passed while moving two squares, or `CHESS_SQUARE_NONE` if not available. */
-	unsigned int half_move_clock;                                             /**< The number of halfmoves since the last capture or pawn advance, used for the fifty-move rule. */
-	unsigned int full_move_number;                                            /**< The number of the full moves. It starts at 1 and is incremented after Black's move. */
-	ChessPositionCounter position_counter;                                    /**< Counter for position repetitions (for threefold repetition rule). */
+	ChessPiece board[128];                                                                                         /**< Array representing the pieces on each square (0x88 board). */
+	ChessSquare pieces[CHESS_COLOR_BLACK + 1][CHESS_PIECE_TYPE_KING + 1][CHESS_POSITION_MAXIMUM_PIECE_TYPE_COUNT]; /**< Array storing the squares of each piece type for both colors. */
+	uint8_t piece_counts[CHESS_COLOR_BLACK + 1][CHESS_PIECE_TYPE_KING + 1];                                        /**< Array storing the count of each piece type for both colors. */
+	uint8_t piece_indices[64];                                                                                     /**< Array storing the index of the piece on each square in the piece list, indexed by `rank * 8 + file`. */
+	ChessColor side_to_move;                                                                                       /**< The color of the side to move next. */
+	ChessCastlingRights castling_rights;                                                                           /**< The current castling rights for both sides. */
+	ChessSquare en_passant_square;                                                                                 /**< The square over which a pawn has just passed while moving two squares, or `CHESS_SQUARE_NONE` if not available. */
+	uint16_t half_move_clock;                                                                                      /**< The number of halfmoves since the last capture or pawn advance, used for the fifty-move rule. */
+	uint16_t full_move_number;                                                                                     /**< The number of the full moves. It starts at 1 and is incremented after Black's move. */
+	ChessScore midgame_score;                                                                                      /**< The material and piece-square score of the pieces in the midgame, from White's perspective. */
+	ChessScore endgame_score;                                                                                      /**< The material and piece-square score of the pieces in the endgame, from White's perspective. */
+	uint8_t phase;                                                                                                 /**< The game phase of the pieces, 24 for the starting material (more after promotions) down to 0 for kings and pawns. */
+	uint64_t pawn_hash;                                                                                            /**< The Zobrist hash of the pawns alone, used to index pawn structure caches. */
+	uint64_t piece_hash;                                                                                           /**< The Zobrist hash of all the pieces, kept up to date so that the hash of the position takes constant time. */
 } ChessPosition;
 
 /**
@@ -59,12 +86,6 @@ bool chess_position_is_valid(const ChessPosition *position);
  */
 ChessPosition chess_position_new(void);
 
-/**
- * @brief Releases resources held by the given position.
- * @param[inout] position Pointer to the position to drop.
- */
-void chess_position_drop(ChessPosition *position);
-
 /**
  * @brief Gets the piece at the given square in the given position.
  * @param[in] position Pointer to the position.
@@ -97,6 +118,28 @@ size_t chess_position_from_fen(ChessPosition *position, const char *string);
  */
 size_t chess_position_to_fen(const ChessPosition *position, char *string, size_t string_size);
 
+/**
+ * @brief Plays the given moves in order on the given position, stopping at the first illegal one.
+ *
+ * Each move is checked with a pseudo-legality test and is made in place, being taken back if it leaves the king in check,
+ * so long move lists are replayed without copying the position for every move.
+ * @param[inout] position Pointer to the position.
+ * @param[in] moves Pointer to the array of moves.
+ * @param[in] count The number of moves.
+ * @return The number of moves played, which is the index of the first illegal move if it is less than `count`.
+ */
+size_t chess_position_apply_moves(ChessPosition *position, const ChessMove *moves, size_t count);
+
+/**
+ * @brief Plays the given whitespace separated moves in UCI notation (e.g., "e2e4 e7e5 g1f3") in order on the given
+ * position, stopping at the first one that is malformed or illegal.
+ * @param[inout] position Pointer to the position.
+ * @param[in] string The string containing the moves.
+ * @param[out] move_count Pointer to store the number of moves played.
+ * @return The number of characters read, which stops short of the end of the string at the first move not played.
+ */
+size_t chess_position_apply_uci_moves(ChessPosition *position, const char *string, size_t *move_count);
+
 /**
  * @brief Checks if the current side to move is in check.
  * @param[in] position Pointer to the position.
@@ -125,13 +168,6 @@ bool chess_position_is_stalemate(const ChessPosition *position);
  */
 bool chess_position_is_fifty_move_rule(const ChessPosition *position);
 
-/**
- * @brief Checks if the current position has occurred three or more times (threefold repetition).
- * @param[in] position Pointer to the position.
- * @return true if the position has occurred three or more times, false otherwise.
- */
-bool chess_position_is_threefold_repetition(const ChessPosition *position);
-
 /**
  * @brief Checks if there is insufficient material to checkmate.
  * @param[in] position Pointer to the position.
@@ -140,7 +176,7 @@ bool chess_position_is_threefold_repetition(const ChessPosition *position);
 bool chess_position_is_insufficient_material(const ChessPosition *position);
 
 /**
- * @brief Computes a hash value for the given position.
+ * @brief Computes a hash value for the given position, in constant time.
  * @param[in] position Pointer to the position.
  * @return The hash value of the position.
  */
@@ -149,9 +185,17 @@ uint64_t chess_position_hash(const ChessPosition *position);
 /**
  * @brief Evaluates the given position.
  * @param[in] position Pointer to the position.
- * @return The value of the position (positive for White's advantage, negative for Black's advantage).
+ * @return The score of the position in centipawns (positive for White's advantage, negative for Black's advantage).
+ */
+ChessScore chess_position_evaluate(const ChessPosition *position);
+
+/**
+ * @brief Evaluates the given position, looking up the evaluation of its pawn structure in the given pawn table.
+ * @param[in] position Pointer to the position.
+ * @param[inout] pawn_table Pointer to the pawn table, or `CHESS_NULL` to evaluate the pawn structure directly.
+ * @return The score of the position in centipawns (positive for White's advantage, negative for Black's advantage).
  */
-double chess_position_evaluate(const ChessPosition *position);
+ChessScore chess_position_evaluate_with_pawn_table(const ChessPosition *position, ChessPawnTable *pawn_table);
 
 #ifdef __cplusplus
 }
@@ -8,6 +8,8 @@
 #ifndef CHESS_POSITION_COUNTER_H_INCLUDED
 #define CHESS_POSITION_COUNTER_H_INCLUDED
 
+#include <chess/allocator.h>
+
 #if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 202311L
 	#include <stdbool.h>
 #endif
@@ -34,11 +36,18 @@ typedef struct ChessPositionCounterEntry {
  *
  * Used to track the number of times each position has occurred,
  * typically for threefold repetition detection.
+ *
+ * The table is open addressed over a power of two number of entries, which are probed in groups of 16. Each entry has a
+ * one byte tag holding either 7 bits of its key or a mark of it being empty or deleted, so that a whole group is matched
+ * against a key with a single vector comparison, and the keys themselves are only compared on a tag match.
  */
 typedef struct ChessPositionCounter {
-	ChessPositionCounterEntry *entries; /**< Array of entries. */
-	size_t size;                        /**< The allocated size of the table. */
+	ChessPositionCounterEntry *entries; /**< Array of entries, followed in the same allocation by the array of their tags. */
+	uint8_t *tags;                      /**< Array of the tags of the entries. */
+	size_t size;                        /**< The allocated size of the table, zero or a power of two of at least 16. */
 	size_t count;                       /**< The number of entries in use. */
+	size_t deleted_count;               /**< The number of entries whose position was removed, which still take part in probing. */
+	ChessAllocator allocator;           /**< The allocator the table is allocated from. */
 } ChessPositionCounter;
 
 /**
@@ -54,6 +63,13 @@ bool chess_position_counter_is_valid(const ChessPositionCounter *counter);
  */
 ChessPositionCounter chess_position_counter_new(void);
 
+/**
+ * @brief Creates a new, empty position counter that allocates from the given allocator.
+ * @param[in] allocator The allocator to allocate the table from.
+ * @return The created position counter.
+ */
+ChessPositionCounter chess_position_counter_new_with_allocator(ChessAllocator allocator);
+
 /**
  * @brief Releases resources held by the given position counter.
  * @param[inout] counter Pointer to the position counter to drop.
@@ -66,6 +82,15 @@ void chess_position_counter_drop(ChessPositionCounter *counter);
  */
 void chess_position_counter_clear(ChessPositionCounter *counter);
 
+/**
+ * @brief Makes room in the given position counter for the given number of distinct positions, so that counting them
+ * does not grow the table.
+ * @param[inout] counter Pointer to the position counter.
+ * @param[in] count The number of distinct positions.
+ * @return true on success, false if the allocation failed.
+ */
+bool chess_position_counter_reserve(ChessPositionCounter *counter, size_t count);
+
 /**
  * @brief Gets the count for a given position.
  * @param[in] counter Pointer to the position counter.
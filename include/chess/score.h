@@ -0,0 +1,110 @@
+/**
+ * @file chess/score.h
+ * @brief Defines the chess score type and related utility functions for representing evaluations and search results in centipawns.
+ * @author Tarek Saeed
+ * @date 2026-10-19
+ */
+
+#ifndef CHESS_SCORE_H_INCLUDED
+#define CHESS_SCORE_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <chess/macros.h>
+
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 202311L
+	#include <stdbool.h>
+#endif
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Represents a score in centipawns.
+ *
+ * Scores always fit in 16 bits, so they can be stored as `int16_t` where space matters. Forced mates are encoded as
+ * `CHESS_SCORE_MATE` minus the number of plies to the mate, negated for the side being mated.
+ */
+typedef int32_t ChessScore;
+
+/**
+ * @brief The score of a drawn position.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(ChessScore, CHESS_SCORE_DRAW, 0);
+
+/**
+ * @brief The score of delivering mate on the current ply.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(ChessScore, CHESS_SCORE_MATE, 32000);
+
+/**
+ * @brief A score bound greater than any other score.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(ChessScore, CHESS_SCORE_INFINITE, 32001);
+
+/**
+ * @brief The maximum number of plies to a mate that can be encoded.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(ChessScore, CHESS_SCORE_MAXIMUM_MATE_PLIES, 1000);
+
+/**
+ * @brief The smallest absolute value of a mate score.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(ChessScore, CHESS_SCORE_MATE_BOUND, CHESS_SCORE_MATE - CHESS_SCORE_MAXIMUM_MATE_PLIES);
+
+/**
+ * @brief Prints a debug representation of the given score.
+ * @param[in] score The score to print.
+ */
+void chess_score_debug(ChessScore score);
+
+/**
+ * @brief Checks if the given score is valid.
+ * @param[in] score The score to check.
+ * @return true if the score is valid, false otherwise.
+ */
+bool chess_score_is_valid(ChessScore score);
+
+/**
+ * @brief Creates the score of delivering mate in the given number of plies.
+ * @param[in] plies The number of plies to the mate.
+ * @return The created score.
+ */
+ChessScore chess_score_mate_in(unsigned int plies);
+
+/**
+ * @brief Creates the score of being mated in the given number of plies.
+ * @param[in] plies The number of plies to the mate.
+ * @return The created score.
+ */
+ChessScore chess_score_mated_in(unsigned int plies);
+
+/**
+ * @brief Checks if the given score is a mate score, for either side.
+ * @param[in] score The score to check.
+ * @return true if the score is a mate score, false otherwise.
+ */
+bool chess_score_is_mate(ChessScore score);
+
+/**
+ * @brief Gets the number of plies to the mate of the given mate score.
+ * @param[in] score The mate score.
+ * @return The number of plies to the mate.
+ */
+unsigned int chess_score_mate_plies(ChessScore score);
+
+/**
+ * @brief Converts a score to a string (e.g., "+0.35", "-1.00", "#3" or "#-2"), mates being counted in moves.
+ * @param[in] score The score to convert.
+ * @param[out] string The buffer to store the string.
+ * @param[in] string_size The size of the output buffer.
+ * @return The number of characters written.
+ */
+size_t chess_score_to_string(ChessScore score, char *string, size_t string_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_SCORE_H_INCLUDED
@@ -0,0 +1,165 @@
+/**
+ * @file chess/search.h
+ * @brief Defines the search limits and results, and the functions for searching chess positions for the best move.
+ * @author Tarek Saeed
+ * @date 2026-10-19
+ */
+
+#ifndef CHESS_SEARCH_H_INCLUDED
+#define CHESS_SEARCH_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <chess/macros.h>
+#include <chess/move.h>
+#include <chess/network.h>
+#include <chess/position.h>
+#include <chess/score.h>
+#include <chess/tablebase.h>
+#include <chess/transposition_table.h>
+
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 202311L
+	#include <stdbool.h>
+#endif
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief The maximum depth the search iterates to, when no depth limit is given.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(unsigned int, CHESS_SEARCH_MAXIMUM_DEPTH, 64);
+
+/**
+ * @brief The number of nodes searched between two polls of the stop flag and the clock.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint64_t, CHESS_SEARCH_POLL_INTERVAL, 1024);
+
+/**
+ * @brief The maximum number of lines a search reports.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_SEARCH_MAXIMUM_LINE_COUNT, 16);
+
+/**
+ * @brief The maximum number of positions of the game before the root that a search checks for repetitions.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_SEARCH_MAXIMUM_KEY_COUNT, 256);
+
+/**
+ * @brief The number of transposition table entries of a search that is not given a table.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_SEARCH_TRANSPOSITION_TABLE_SIZE, 1U << 18U);
+
+/**
+ * @struct ChessSearchStatistics
+ * @brief Represents the statistics of a completed iteration of a search, for tuning the search and reporting its
+ * progress.
+ *
+ * The counters cover the iteration alone, apart from the totals, and the rate of cutoffs on the first move, which
+ * measures how well the moves are ordered, is the ratio of `first_move_cutoff_count` to `cutoff_count`.
+ */
+typedef struct ChessSearchStatistics {
+	unsigned int depth;                /**< The depth of the iteration. */
+	unsigned int selective_depth;      /**< The greatest ply the iteration reached. */
+	ChessMove best_move;               /**< The best move found by the iteration. */
+	ChessScore score;                  /**< The score of the best move from the perspective of the side to move. */
+	uint64_t nodes;                    /**< The number of nodes the iteration searched. */
+	uint64_t leaf_nodes;               /**< The number of those nodes that were evaluated at the horizon, there being no quiescence search. */
+	uint64_t table_probes;             /**< The number of transposition table probes. */
+	uint64_t table_hits;               /**< The number of those probes that found their position. */
+	uint64_t cutoff_count;             /**< The number of nodes that failed high. */
+	uint64_t first_move_cutoff_count;  /**< The number of those nodes that failed high on their first move. */
+	double effective_branching_factor; /**< The ratio of the nodes of the iteration to those of the previous one, or 0 for the first iteration. */
+	uint64_t time;                     /**< The wall-clock time the iteration took in milliseconds. */
+	uint64_t total_nodes;              /**< The number of nodes searched since the start of the search. */
+	uint64_t total_time;               /**< The wall-clock time since the start of the search in milliseconds. */
+	uint64_t nodes_per_second;         /**< The number of nodes searched per second since the start of the search. */
+} ChessSearchStatistics;
+
+/**
+ * @brief Function called with the statistics of every completed iteration of a search, on the thread of the search.
+ * @param[in] statistics Pointer to the statistics of the iteration.
+ * @param[in] data The data given with the callback in the limits.
+ */
+typedef void ChessSearchCallback(const ChessSearchStatistics *statistics, void *data);
+
+/**
+ * @struct ChessSearchLimits
+ * @brief Represents the limits that bound a search, and the optional resources it uses.
+ *
+ * A limit of 0 means that the search is not bounded by it.
+ */
+typedef struct ChessSearchLimits {
+	unsigned int depth;              /**< The maximum depth to search to, or 0 for no limit. */
+	uint64_t nodes;                  /**< The maximum number of nodes to search, or 0 for no limit. */
+	uint64_t time;                   /**< The maximum wall-clock time to search for in milliseconds, or 0 for no limit. */
+	unsigned int line_count;         /**< The number of best moves to report lines for, at most `CHESS_SEARCH_MAXIMUM_LINE_COUNT`, or 0 for 1. */
+	const CHESS_ATOMIC(bool) *stop;  /**< Pointer to a flag which stops the search once set, or `CHESS_NULL`. */
+	const ChessNetwork *network;     /**< Pointer to the network to evaluate positions with, or `CHESS_NULL` for `chess_position_evaluate()`. */
+	const ChessTablebase *tablebase; /**< Pointer to the tablebase whose positions are scored exactly instead of searched, or `CHESS_NULL`. */
+	ChessTranspositionTable *table;  /**< Pointer to a transposition table kept across searches, or `CHESS_NULL` for one of the search's own. */
+	const uint64_t *keys;            /**< Pointer to the hashes of the positions of the game before the root, oldest first, or `CHESS_NULL`. */
+	size_t key_count;                /**< The number of hashes, of which only the last `CHESS_SEARCH_MAXIMUM_KEY_COUNT` are used. */
+	ChessSearchCallback *callback;   /**< Pointer to the function to report the statistics of every completed iteration to, or `CHESS_NULL`. */
+	void *callback_data;             /**< The data passed to the callback. */
+} ChessSearchLimits;
+
+/**
+ * @struct ChessSearchLine
+ * @brief Represents a principal variation, the line of play expected from a root move.
+ */
+typedef struct ChessSearchLine {
+	ChessScore score;                            /**< The score of the line from the perspective of the side to move. */
+	ChessMove moves[CHESS_SEARCH_MAXIMUM_DEPTH]; /**< The moves of the line, starting with the root move. */
+	size_t move_count;                           /**< The number of moves of the line. */
+} ChessSearchLine;
+
+/**
+ * @struct ChessSearchResult
+ * @brief Represents the result of a search.
+ */
+typedef struct ChessSearchResult {
+	ChessMove best_move;                                    /**< The best move found by the last completed iteration, its squares are `CHESS_SQUARE_NONE` if there are no legal moves. */
+	ChessScore score;                                       /**< The score of the best move from the perspective of the side to move. */
+	unsigned int depth;                                     /**< The depth of the last completed iteration. */
+	uint64_t nodes;                                         /**< The number of nodes searched. */
+	uint64_t time;                                          /**< The wall-clock time the search took in milliseconds. */
+	ChessSearchLine lines[CHESS_SEARCH_MAXIMUM_LINE_COUNT]; /**< The lines of the best moves, best first, found by the last completed iteration. */
+	size_t line_count;                                      /**< The number of lines, 0 if not even the first iteration completed. */
+	ChessSearchStatistics statistics;                       /**< The statistics of the last completed iteration, zeroed if not even the first iteration completed. */
+} ChessSearchResult;
+
+/**
+ * @brief Searches the given position for the best move, deepening iteratively until one of the given limits is reached.
+ *
+ * The stop flag and the clock are polled every `CHESS_SEARCH_POLL_INTERVAL` nodes. When the search is stopped, the
+ * unfinished iteration is discarded and the result of the last completed one is returned. If not even the first
+ * iteration completed, the first legal move is returned.
+ *
+ * A position that repeats one of the game or of the current line within the reach of the half-move clock is scored
+ * as a draw, without waiting for the third occurrence, as the side that could avoid it would already have done so.
+ *
+ * When several lines are asked for, the root moves are searched against the score of the worst line kept so far, so
+ * that a move only costs a full search if it enters the best lines, and all of them share the transposition table and
+ * the history of quiet moves causing cutoffs, which orders the moves of every later search.
+ *
+ * @param[in] position Pointer to the position to search.
+ * @param[in] limits The limits of the search.
+ * @return The result of the search.
+ */
+ChessSearchResult chess_search(const ChessPosition *position, ChessSearchLimits limits);
+
+/**
+ * @brief Searches the given position to the given depth for the best move.
+ * @param[in] position Pointer to the position to search.
+ * @param[in] depth The depth to search to.
+ * @return The best move, its squares are `CHESS_SQUARE_NONE` if there are no legal moves.
+ */
+ChessMove chess_position_best_move(const ChessPosition *position, unsigned int depth);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_SEARCH_H_INCLUDED
@@ -0,0 +1,147 @@
+/**
+ * @file chess/tablebase.h
+ * @brief Defines the chess tablebase type and related functions for generating and probing endgame tablebases.
+ * @author Tarek Saeed
+ * @date 2026-10-19
+ */
+
+#ifndef CHESS_TABLEBASE_H_INCLUDED
+#define CHESS_TABLEBASE_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <chess/macros.h>
+#include <chess/piece.h>
+
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 202311L
+	#include <stdbool.h>
+#endif
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Forward declaration of ChessPosition.
+ */
+typedef struct ChessPosition ChessPosition;
+
+/**
+ * @brief The maximum number of pieces, kings included, of the positions in a table.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_TABLEBASE_MAXIMUM_PIECE_COUNT, 5);
+
+/**
+ * @brief The maximum number of tables in a tablebase.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_TABLEBASE_MAXIMUM_TABLE_COUNT, 256);
+
+/**
+ * @brief The maximum length of a material signature (e.g., "KQvK"), excluding the null terminator.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_TABLEBASE_MAXIMUM_MATERIAL_LENGTH, 6);
+
+/**
+ * @enum ChessTablebaseOutcome
+ * @brief Represents the outcome of a position with perfect play, from the perspective of the side to move.
+ */
+CHESS_ENUM(uint8_t, ChessTablebaseOutcome){
+	CHESS_TABLEBASE_OUTCOME_WIN,  /**< The side to move mates. */
+	CHESS_TABLEBASE_OUTCOME_DRAW, /**< Neither side can force mate. */
+	CHESS_TABLEBASE_OUTCOME_LOSS, /**< The side to move gets mated. */
+};
+
+/**
+ * @struct ChessTablebaseResult
+ * @brief Represents the result of probing a tablebase.
+ */
+typedef struct ChessTablebaseResult {
+	ChessTablebaseOutcome outcome; /**< The outcome of the position. */
+	unsigned int moves;            /**< The number of moves of the side to move until mate, 0 for a draw or when already mated. */
+} ChessTablebaseResult;
+
+/**
+ * @struct ChessTablebaseTable
+ * @brief Represents the table of a single material signature, holding the outcome of every position with that material.
+ *
+ * A table file consists of the magic bytes "CHTB", an 8-bit version (1), an 8-bit piece count and the pieces, padded
+ * with zeros to 16 bytes, followed by one byte per position.
+ */
+typedef struct ChessTablebaseTable {
+	ChessPiece pieces[CHESS_TABLEBASE_MAXIMUM_PIECE_COUNT]; /**< The pieces of the material, the White king first, then the Black king, then the other White pieces followed by the other Black ones, each from the queen down to the pawn. */
+	size_t piece_count;                                     /**< The number of pieces of the material. */
+	const uint8_t *values;                                  /**< The value of each position, indexed by the squares of the pieces and the side to move. */
+	size_t value_count;                                     /**< The number of values. */
+	void *mapping;                                          /**< The memory mapping of the file holding the values, or `CHESS_NULL` if they are allocated. */
+	size_t mapping_size;                                    /**< The size of the memory mapping in bytes. */
+} ChessTablebaseTable;
+
+/**
+ * @struct ChessTablebase
+ * @brief Represents a set of tables which together answer probes of positions with few pieces.
+ *
+ * Tables are stored with the stronger side as White, positions of the weaker side are probed with their colors
+ * reversed. The outcomes ignore the fifty-move rule and positions with castling rights cannot be probed.
+ */
+typedef struct ChessTablebase {
+	ChessTablebaseTable tables[CHESS_TABLEBASE_MAXIMUM_TABLE_COUNT]; /**< Array of tables. */
+	size_t table_count;                                              /**< The number of tables. */
+	size_t maximum_piece_count;                                      /**< The largest piece count of the tables, 0 if there are none. */
+} ChessTablebase;
+
+/**
+ * @brief Checks if the given tablebase is valid.
+ * @param[in] tablebase Pointer to the tablebase to check.
+ * @return true if the tablebase is valid, false otherwise.
+ */
+bool chess_tablebase_is_valid(const ChessTablebase *tablebase);
+
+/**
+ * @brief Creates a new, empty tablebase.
+ * @return The created tablebase.
+ */
+ChessTablebase chess_tablebase_new(void);
+
+/**
+ * @brief Releases resources held by the given tablebase, unmapping its tables.
+ * @param[inout] tablebase Pointer to the tablebase to drop.
+ */
+void chess_tablebase_drop(ChessTablebase *tablebase);
+
+/**
+ * @brief Memory-maps the table file at the given path into the given tablebase.
+ * @param[inout] tablebase Pointer to the tablebase.
+ * @param[in] path The path of the table file.
+ * @return true if successful, false otherwise.
+ */
+bool chess_tablebase_load(ChessTablebase *tablebase, const char *path);
+
+/**
+ * @brief Generates the table of the given material by retrograde analysis, writes it to the given directory and loads it.
+ *
+ * Tables the material can be converted into by captures and promotions are loaded from the directory when present and
+ * generated otherwise. Tables are named after their material (e.g., "KQvK.ctb"). The positions of a table with `n`
+ * pieces take `10 * 64^(n - 1) * 2` bytes without pawns and `32 * 64^(n - 1) * 2` bytes with them, and generating a
+ * table takes three times as much memory, as wins are propagated backwards to the positions leading to them.
+ *
+ * @param[inout] tablebase Pointer to the tablebase.
+ * @param[in] directory The directory to load and write the tables in.
+ * @param[in] material The material signature, the pieces of one side followed by 'v' and those of the other (e.g., "KRPvKR").
+ * @return true if successful, false otherwise.
+ */
+bool chess_tablebase_generate(ChessTablebase *tablebase, const char *directory, const char *material);
+
+/**
+ * @brief Looks up the outcome of the given position in the given tablebase.
+ * @param[in] tablebase Pointer to the tablebase.
+ * @param[in] position Pointer to the position.
+ * @param[out] result Pointer to store the result.
+ * @return true if the position is in the tablebase, false otherwise.
+ */
+bool chess_tablebase_probe(const ChessTablebase *tablebase, const ChessPosition *position, ChessTablebaseResult *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_TABLEBASE_H_INCLUDED
@@ -0,0 +1,128 @@
+/**
+ * @file chess/transposition_table.h
+ * @brief Defines the chess transposition table type and related functions for caching the results of searched positions.
+ * @author Tarek Saeed
+ * @date 2026-10-19
+ */
+
+#ifndef CHESS_TRANSPOSITION_TABLE_H_INCLUDED
+#define CHESS_TRANSPOSITION_TABLE_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <chess/macros.h>
+#include <chess/piece_type.h>
+#include <chess/score.h>
+#include <chess/square.h>
+
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 202311L
+	#include <stdbool.h>
+#endif
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @enum ChessTranspositionTableBound
+ * @brief Represents how the score of an entry bounds the value of its position.
+ */
+CHESS_ENUM(uint8_t, ChessTranspositionTableBound){
+	CHESS_TRANSPOSITION_TABLE_BOUND_NONE,  /**< The entry is empty. */
+	CHESS_TRANSPOSITION_TABLE_BOUND_LOWER, /**< The value is at least the score, the search having failed high. */
+	CHESS_TRANSPOSITION_TABLE_BOUND_UPPER, /**< The value is at most the score, the search having failed low. */
+	CHESS_TRANSPOSITION_TABLE_BOUND_EXACT, /**< The value is the score. */
+};
+
+/**
+ * @brief Entry in the transposition table.
+ *
+ * Stores the result of searching a position, keyed by the hash of the position.
+ */
+typedef struct ChessTranspositionTableEntry {
+	uint64_t key;                       /**< The hash of the position. */
+	ChessScore score;                   /**< The score of the position from the perspective of the side to move, mate scores counting plies from the position. */
+	uint8_t depth;                      /**< The depth the position was searched to. */
+	ChessTranspositionTableBound bound; /**< How the score bounds the value of the position. */
+	ChessSquare from;                   /**< The source square of the best move, or `CHESS_SQUARE_NONE` if unknown. */
+	ChessSquare to;                     /**< The destination square of the best move, or `CHESS_SQUARE_NONE` if unknown. */
+	ChessPieceType promotion_type;      /**< The promotion type of the best move, or `CHESS_PIECE_TYPE_NONE`. */
+} ChessTranspositionTableEntry;
+
+/**
+ * @brief Slot of the transposition table, holding an entry packed into a single word.
+ *
+ * The key is stored xored with the packed entry, so that a slot torn by stores from different threads no longer
+ * matches the key of either entry.
+ */
+typedef struct ChessTranspositionTableSlot {
+	CHESS_ATOMIC(uint64_t) key;  /**< The hash of the position xored with the packed entry. */
+	CHESS_ATOMIC(uint64_t) data; /**< The packed entry. */
+} ChessTranspositionTableSlot;
+
+/**
+ * @brief Hash table for caching the results of searched positions.
+ *
+ * Positions reached through different move orders share their entry, and the best move of an entry is searched first
+ * when the position is searched again to a greater depth. A table may be kept across searches, and shared between
+ * threads searching at the same time without locking, an entry torn by a concurrent store being missed.
+ */
+typedef struct ChessTranspositionTable {
+	ChessTranspositionTableSlot *slots; /**< Array of slots. */
+	size_t size;                        /**< The number of slots, a power of two or 0. */
+} ChessTranspositionTable;
+
+/**
+ * @brief Checks if the given transposition table is valid.
+ * @param[in] table Pointer to the transposition table to check.
+ * @return true if the transposition table is valid, false otherwise.
+ */
+bool chess_transposition_table_is_valid(const ChessTranspositionTable *table);
+
+/**
+ * @brief Creates a new, empty transposition table.
+ *
+ * If the allocation fails, the table has no slots and every probe misses.
+ *
+ * @param[in] size The number of slots, rounded down to a power of two.
+ * @return The created transposition table.
+ */
+ChessTranspositionTable chess_transposition_table_new(size_t size);
+
+/**
+ * @brief Releases resources held by the given transposition table.
+ * @param[inout] table Pointer to the transposition table to drop.
+ */
+void chess_transposition_table_drop(ChessTranspositionTable *table);
+
+/**
+ * @brief Clears all entries from the given transposition table.
+ * @param[inout] table Pointer to the transposition table to clear.
+ */
+void chess_transposition_table_clear(ChessTranspositionTable *table);
+
+/**
+ * @brief Looks up the entry of the position with the given hash.
+ * @param[in] table Pointer to the transposition table.
+ * @param[in] key The hash of the position.
+ * @param[out] entry Pointer to store the entry.
+ * @return true if the table holds an entry for the position, false otherwise.
+ */
+bool chess_transposition_table_probe(const ChessTranspositionTable *table, uint64_t key, ChessTranspositionTableEntry *entry);
+
+/**
+ * @brief Stores the given entry, replacing the entry in its slot unless that one holds the same position searched
+ * deeper.
+ *
+ * An entry without a best move keeps the best move already stored for its position.
+ *
+ * @param[inout] table Pointer to the transposition table.
+ * @param[in] entry The entry to store.
+ */
+void chess_transposition_table_store(ChessTranspositionTable *table, ChessTranspositionTableEntry entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_TRANSPOSITION_TABLE_H_INCLUDED
@@ -0,0 +1,61 @@
+/**
+ * @file chess/unmoves.h
+ * @brief Defines the chess unmoves type and related functions for generating the moves that lead into a position.
+ * @author Tarek Saeed
+ * @date 2026-10-19
+ */
+
+#ifndef CHESS_UNMOVES_H_INCLUDED
+#define CHESS_UNMOVES_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <chess/macros.h>
+#include <chess/move.h>
+
+#include <stddef.h>
+
+/**
+ * @brief The maximum number of unmoves of a position.
+ */
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_UNMOVES_MAXIMUM_COUNT, 1024);
+
+/**
+ * @struct ChessUnmoves
+ * @brief Represents the moves that lead into a position, the side which just moved having played them.
+ *
+ * Undoing an unmove with `chess_move_undo` gives a legal position in which the unmove is legal and leads back to the
+ * original position. An unmove is repeated for each en passant square the position before it can have, and pieces
+ * whose castling rights are still present are never moved, as castlings and the rights they lose are never undone.
+ * Pawn moves and captures reset the half-move clock, so they are only unmoved when it is 0, and the clock before any
+ * other unmove is taken to be one less than the current one. A clock of 0 is taken to stay 0 before those other
+ * unmoves, as positions set up without their history have it unknown, so redoing them gives a clock of 1 instead.
+ */
+typedef struct ChessUnmoves {
+	ChessMove unmoves[CHESS_UNMOVES_MAXIMUM_COUNT]; /**< Array of unmoves. */
+	size_t count;                                   /**< The number of unmoves. */
+} ChessUnmoves;
+
+/**
+ * @brief Generates every unmove of the given position, including those which uncapture a piece of the side to move and
+ * those which unpromote a pawn.
+ * @param[in] position Pointer to the position.
+ * @return The generated unmoves.
+ */
+ChessUnmoves chess_unmoves_generate(const ChessPosition *position);
+
+/**
+ * @brief Generates the unmoves of the given position which neither uncapture nor unpromote, so the material stays the
+ * same.
+ * @param[in] position Pointer to the position.
+ * @return The generated unmoves.
+ */
+ChessUnmoves chess_unmoves_generate_quiet(const ChessPosition *position);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_UNMOVES_H_INCLUDED
@@ -0,0 +1,72 @@
+from enum import Enum
+
+
+class ChessColor(Enum):
+    WHITE = 0
+    BLACK = 1
+
+
+class ChessPieceType(Enum):
+    PAWN = 0
+    KNIGHT = 1
+    BISHOP = 2
+    ROOK = 3
+    QUEEN = 4
+    KING = 5
+
+
+FILES = "ABCDEFGH"
+RANKS = "12345678"
+
+MASK = (1 << 64) - 1
+
+state = 0x9E3779B97F4A7C15
+
+
+def random():
+    global state
+
+    state ^= state >> 12
+    state ^= (state << 25) & MASK
+    state ^= state >> 27
+
+    return (state * 0x2545F4914F6CDD1D) & MASK
+
+
+piece_at_square = {
+    (color, piece_type): [[random() for _ in FILES] for _ in RANKS]
+    for color in ChessColor
+    for piece_type in ChessPieceType
+}
+side_to_move = random()
+castling_rights = [random() for _ in range(16)]
+en_passant_file = [random() for _ in FILES]
+
+
+def value_to_string(value):
+    return f"0x{value:016X}ULL"
+
+
+print(
+    "const uint64_t chess_zobrist_piece_at_square[CHESS_PIECE_BLACK_KING + 1][CHESS_SQUARE_H8 + 1] = {"
+)
+for (color, piece_type), ranks in piece_at_square.items():
+    print(f"\t[CHESS_PIECE_{color.name}_{piece_type.name}] = {{")
+    for rank, values in zip(RANKS, ranks):
+        print(
+            f"\t    [CHESS_SQUARE_A{rank}] = {', '.join(value_to_string(value) for value in values)},"
+        )
+    print("\t},")
+print("};")
+
+print(f"const uint64_t chess_zobrist_side_to_move = {value_to_string(side_to_move)};")
+
+print("const uint64_t chess_zobrist_castling_rights[CHESS_CASTLING_RIGHTS_ALL + 1] = {")
+for value in castling_rights:
+    print(f"\t{value_to_string(value)},")
+print("};")
+
+print("const uint64_t chess_zobrist_en_passant_file[CHESS_FILE_H + 1] = {")
+for file, value in zip(FILES, en_passant_file):
+    print(f"\t[CHESS_FILE_{file}] = {value_to_string(value)},")
+print("};")
@@ -0,0 +1,528 @@
+#if !defined(_POSIX_C_SOURCE)
+	#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <chess.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// A connected client, shared by the listening thread and the workers with requests of it pending, and closed once the
+// last of them releases it. A client that has finished sending is kept until its requests are answered, while one that
+// hung up or can no longer be written to has its searches stopped and its pending requests dropped.
+typedef struct ChessAnalysisServerClient {
+	pthread_mutex_t mutex;
+	pthread_mutex_t write_mutex;
+	int descriptor;
+	size_t reference_count;
+	bool is_closed;
+	bool is_reading;
+	CHESS_ATOMIC(bool) stop;
+	char *buffer;
+	size_t size;
+	size_t length;
+} ChessAnalysisServerClient;
+
+typedef struct ChessAnalysisServerRequest {
+	struct ChessAnalysisServerRequest *next;
+	ChessAnalysisServerClient *client;
+	char id[32];
+	ChessPosition position;
+	unsigned int depth;
+	uint64_t nodes;
+} ChessAnalysisServerRequest;
+
+// The requests waiting for a worker, taken by whichever is idle first, and the transposition table all the workers share,
+// which is kept warm across the requests so that positions of the same game help each other.
+typedef struct ChessAnalysisServerQueue {
+	pthread_mutex_t mutex;
+	pthread_cond_t condition;
+	ChessAnalysisServerRequest *first;
+	ChessAnalysisServerRequest *last;
+	bool is_quitting;
+	ChessTranspositionTable table;
+} ChessAnalysisServerQueue;
+
+static volatile sig_atomic_t chess_analysis_server_is_quitting = 0;
+
+static void chess_analysis_server_handle_signal(int signal) {
+	(void)signal;
+
+	chess_analysis_server_is_quitting = 1;
+}
+static void chess_analysis_server_client_release(ChessAnalysisServerClient *client) {
+	pthread_mutex_lock(&client->mutex);
+	bool is_released = --client->reference_count == 0;
+	pthread_mutex_unlock(&client->mutex);
+
+	// The descriptor is only closed now, so that it is not reused while a worker may still write to it.
+	if (is_released) {
+		close(client->descriptor);
+		pthread_mutex_destroy(&client->write_mutex);
+		pthread_mutex_destroy(&client->mutex);
+		free(client->buffer);
+		free(client);
+	}
+}
+static void chess_analysis_server_client_close(ChessAnalysisServerClient *client) {
+	pthread_mutex_lock(&client->mutex);
+	client->is_closed = true;
+	client->stop      = true;
+	pthread_mutex_unlock(&client->mutex);
+}
+// Writes are serialised apart from the rest of the state, so that they never hold up the listening thread. A worker
+// answering a client slow to read still waits for it, leaving the other clients one worker fewer meanwhile.
+static void chess_analysis_server_client_write(ChessAnalysisServerClient *client, const char *string, size_t length) {
+	pthread_mutex_lock(&client->write_mutex);
+	while (length != 0) {
+		ssize_t count = write(client->descriptor, string, length);
+		if (count < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			chess_analysis_server_client_close(client);
+			break;
+		}
+		string += count;
+		length -= (size_t)count;
+	}
+	pthread_mutex_unlock(&client->write_mutex);
+}
+static void chess_analysis_server_append(char *string, size_t string_size, size_t *length, const char *format, ...) {
+	va_list arguments;
+	va_start(arguments, format);
+	int written = vsnprintf(string + *length, string_size - *length, format, arguments);
+	va_end(arguments);
+
+	if (written > 0) {
+		*length = *length + (size_t)written < string_size ? *length + (size_t)written : string_size - 1;
+	}
+}
+static void chess_analysis_server_respond(const ChessAnalysisServerRequest *request, const ChessSearchResult *result) {
+	char response[2048];
+	size_t length = 0;
+
+	chess_analysis_server_append(response, sizeof(response), &length, "%s", request->id);
+	if (result->best_move.from == CHESS_SQUARE_NONE) {
+		chess_analysis_server_append(response, sizeof(response), &length, " bestmove 0000");
+	} else {
+		char move[8];
+		chess_move_to_uci(result->best_move, move, sizeof(move));
+		chess_analysis_server_append(response, sizeof(response), &length, " bestmove %s", move);
+	}
+
+	if (chess_score_is_mate(result->score)) {
+		unsigned int plies = chess_score_mate_plies(result->score);
+		if (result->score > 0) {
+			chess_analysis_server_append(response, sizeof(response), &length, " score mate %u", (plies + 1) / 2);
+		} else {
+			chess_analysis_server_append(response, sizeof(response), &length, " score mate -%u", plies / 2);
+		}
+	} else {
+		chess_analysis_server_append(response, sizeof(response), &length, " score cp %" PRId32, result->score);
+	}
+	chess_analysis_server_append(response, sizeof(response), &length, " depth %u seldepth %u nodes %" PRIu64 " time %" PRIu64, result->depth, result->statistics.selective_depth, result->nodes, result->time);
+
+	if (result->line_count != 0) {
+		chess_analysis_server_append(response, sizeof(response), &length, " pv");
+		for (size_t i = 0; i < result->lines[0].move_count; i++) {
+			char move[8];
+			chess_move_to_uci(result->lines[0].moves[i], move, sizeof(move));
+			chess_analysis_server_append(response, sizeof(response), &length, " %s", move);
+		}
+	}
+	chess_analysis_server_append(response, sizeof(response), &length, "\n");
+
+	chess_analysis_server_client_write(request->client, response, length);
+}
+static void *chess_analysis_server_run(void *argument) {
+	ChessAnalysisServerQueue *queue = argument;
+
+	while (true) {
+		pthread_mutex_lock(&queue->mutex);
+		while (queue->first == NULL && !queue->is_quitting) {
+			pthread_cond_wait(&queue->condition, &queue->mutex);
+		}
+		ChessAnalysisServerRequest *request = queue->first;
+		if (request != NULL) {
+			queue->first = request->next;
+			if (queue->first == NULL) {
+				queue->last = NULL;
+			}
+		}
+		pthread_mutex_unlock(&queue->mutex);
+
+		if (request == NULL) {
+			break;
+		}
+
+		// The requests of a client that went away are dropped without being searched.
+		pthread_mutex_lock(&request->client->mutex);
+		bool is_closed = request->client->is_closed;
+		pthread_mutex_unlock(&request->client->mutex);
+
+		if (!is_closed) {
+			ChessSearchResult result = chess_search(&request->position, (ChessSearchLimits){
+			                                                                .depth         = request->depth,
+			                                                                .nodes         = request->nodes,
+			                                                                .time          = 0,
+			                                                                .line_count    = 1,
+			                                                                .stop          = &request->client->stop,
+			                                                                .network       = CHESS_NULL,
+			                                                                .tablebase     = CHESS_NULL,
+			                                                                .table         = &queue->table,
+			                                                                .callback      = CHESS_NULL,
+			                                                                .callback_data = CHESS_NULL,
+			                                                            });
+
+			// A search stopped because its client went away is not answered.
+			pthread_mutex_lock(&request->client->mutex);
+			is_closed = request->client->is_closed;
+			pthread_mutex_unlock(&request->client->mutex);
+			if (!is_closed) {
+				chess_analysis_server_respond(request, &result);
+			}
+		}
+
+		chess_analysis_server_client_release(request->client);
+		free(request);
+	}
+
+	return NULL;
+}
+// Parses a request of the form "<id> <fen> [depth <plies>] [nodes <nodes>]", answering malformed ones at once.
+static void chess_analysis_server_submit(ChessAnalysisServerQueue *queue, ChessAnalysisServerClient *client, const char *line, unsigned int default_depth) {
+	while (*line == ' ' || *line == '\t') {
+		line++;
+	}
+	if (*line == '\0') {
+		return;
+	}
+
+	ChessAnalysisServerRequest *request = malloc(sizeof(*request));
+	if (request == NULL) {
+		chess_analysis_server_client_write(client, "error out of memory\n", strlen("error out of memory\n"));
+		return;
+	}
+
+	size_t id_length = strcspn(line, " \t");
+	if (id_length >= sizeof(request->id)) {
+		id_length = sizeof(request->id) - 1;
+	}
+	memcpy(request->id, line, id_length);
+	request->id[id_length] = '\0';
+	line += strcspn(line, " \t");
+
+	request->position = chess_position_new();
+	size_t read       = chess_position_from_fen(&request->position, line);
+	request->depth    = 0;
+	request->nodes    = 0;
+
+	bool is_valid     = read != 0;
+	for (line += read; is_valid;) {
+		char name[16];
+		unsigned long long value;
+		int consumed = 0;
+		if (sscanf(line, " %15s %llu%n", name, &value, &consumed) != 2) {
+			is_valid = sscanf(line, " %15s", name) != 1;
+			break;
+		}
+		if (strcmp(name, "depth") == 0 && value <= CHESS_SEARCH_MAXIMUM_DEPTH) {
+			request->depth = (unsigned int)value;
+		} else if (strcmp(name, "nodes") == 0) {
+			request->nodes = (uint64_t)value;
+		} else {
+			is_valid = false;
+		}
+		line += consumed;
+	}
+
+	if (!is_valid) {
+		char response[64];
+		int length = snprintf(response, sizeof(response), "%s error invalid request\n", request->id);
+		chess_analysis_server_client_write(client, response, (size_t)length < sizeof(response) ? (size_t)length : sizeof(response) - 1);
+
+		free(request);
+		return;
+	}
+	if (request->depth == 0 && request->nodes == 0) {
+		request->depth = default_depth;
+	}
+
+	pthread_mutex_lock(&client->mutex);
+	client->reference_count++;
+	pthread_mutex_unlock(&client->mutex);
+	request->client = client;
+	request->next   = NULL;
+
+	pthread_mutex_lock(&queue->mutex);
+	if (queue->last != NULL) {
+		queue->last->next = request;
+	} else {
+		queue->first = request;
+	}
+	queue->last = request;
+	pthread_cond_signal(&queue->condition);
+	pthread_mutex_unlock(&queue->mutex);
+}
+// Reads what the client sent, submitting every complete line, and returns false on an error. Once the client has
+// finished sending, it stops being read but stays open for its requests to be answered.
+static bool chess_analysis_server_client_read(ChessAnalysisServerQueue *queue, ChessAnalysisServerClient *client, unsigned int default_depth) {
+	if (client->length == client->size) {
+		size_t size  = client->size == 0 ? 4096 : 2 * client->size;
+		char *buffer = size <= (1U << 20U) ? realloc(client->buffer, size) : NULL;
+		if (buffer == NULL) {
+			return false;
+		}
+		client->buffer = buffer;
+		client->size   = size;
+	}
+
+	ssize_t count = read(client->descriptor, client->buffer + client->length, client->size - client->length);
+	if (count < 0) {
+		return errno == EINTR || errno == EAGAIN;
+	}
+	if (count == 0) {
+		client->is_reading = false;
+		return true;
+	}
+	client->length += (size_t)count;
+
+	size_t start    = 0;
+	for (size_t i = client->length - (size_t)count; i < client->length; i++) {
+		if (client->buffer[i] == '\n') {
+			client->buffer[i] = '\0';
+			if (i != start && client->buffer[i - 1] == '\r') {
+				client->buffer[i - 1] = '\0';
+			}
+			chess_analysis_server_submit(queue, client, &client->buffer[start], default_depth);
+			start = i + 1;
+		}
+	}
+	memmove(client->buffer, client->buffer + start, client->length - start);
+	client->length -= start;
+
+	return true;
+}
+// Checks if the client has finished sending and all its requests were answered, the listening thread holding the only
+// reference left.
+static bool chess_analysis_server_client_is_done(ChessAnalysisServerClient *client) {
+	pthread_mutex_lock(&client->mutex);
+	bool is_done = !client->is_reading && client->reference_count == 1;
+	pthread_mutex_unlock(&client->mutex);
+
+	return is_done;
+}
+
+int main(int argc, char **argv) {
+	long worker_count          = sysconf(_SC_NPROCESSORS_ONLN);
+	unsigned long hash         = 64;
+	unsigned int default_depth = 6;
+
+	int argument               = 1;
+	for (; argument + 1 < argc && argv[argument][0] == '-'; argument += 2) {
+		long value = strtol(argv[argument + 1], NULL, 10);
+		if (strcmp(argv[argument], "-j") == 0 && value > 0) {
+			worker_count = value;
+		} else if (strcmp(argv[argument], "-H") == 0 && value > 0) {
+			hash = (unsigned long)value;
+		} else if (strcmp(argv[argument], "-d") == 0 && value > 0 && value <= CHESS_SEARCH_MAXIMUM_DEPTH) {
+			default_depth = (unsigned int)value;
+		} else {
+			break;
+		}
+	}
+
+	if (argc - argument != 1) {
+		(void)fprintf(stderr, "Usage: %s [-j threads] [-H megabytes] [-d depth] <socket>\n", argv[0]);
+		(void)fprintf(stderr, "Analyses the positions sent as lines \"<id> <fen> [depth <plies>] [nodes <nodes>]\" to the Unix domain socket at the given path, using the given number of threads (one per processor) sharing a transposition table of the given size (64), searching to the given depth (6) if no limit is given.\n");
+		return EXIT_FAILURE;
+	}
+	if (worker_count < 1) {
+		worker_count = 1;
+	}
+
+	const char *path           = argv[argument];
+	struct sockaddr_un address = { .sun_family = AF_UNIX };
+	if (strlen(path) >= sizeof(address.sun_path)) {
+		(void)fprintf(stderr, "Error: The socket path %s is too long\n", path);
+		return EXIT_FAILURE;
+	}
+	strcpy(address.sun_path, path);
+
+	int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0 || bind(listener, (const struct sockaddr *)&address, sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0) {
+		(void)fprintf(stderr, "Error: Failed to listen on %s: %s\n", path, strerror(errno));
+		if (listener >= 0) {
+			close(listener);
+		}
+		return EXIT_FAILURE;
+	}
+
+	// Interrupting the server shuts it down cleanly, and writing to a client that hung up is reported as an error.
+	struct sigaction action = { .sa_handler = chess_analysis_server_handle_signal };
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGINT, &action, NULL);
+	sigaction(SIGTERM, &action, NULL);
+	action.sa_handler = SIG_IGN;
+	sigaction(SIGPIPE, &action, NULL);
+
+	pthread_t *workers = calloc((size_t)worker_count, sizeof(*workers));
+	if (workers == NULL) {
+		(void)fprintf(stderr, "Error: Failed to allocate the workers\n");
+		close(listener);
+		unlink(path);
+		return EXIT_FAILURE;
+	}
+
+	ChessAnalysisServerQueue queue = {
+		.first       = NULL,
+		.last        = NULL,
+		.is_quitting = false,
+		.table       = chess_transposition_table_new(hash * 1024 * 1024 / sizeof(ChessTranspositionTableSlot)),
+	};
+	pthread_mutex_init(&queue.mutex, NULL);
+	pthread_cond_init(&queue.condition, NULL);
+
+	// The workers inherit a mask blocking the shutdown signals, so that those are delivered to the listening thread,
+	// interrupting its poll.
+	sigset_t signals;
+	sigset_t previous_signals;
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGINT);
+	sigaddset(&signals, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &signals, &previous_signals);
+
+	size_t started_count = 0;
+	for (size_t i = 0; i < (size_t)worker_count; i++) {
+		if (pthread_create(&workers[i], NULL, chess_analysis_server_run, &queue) != 0) {
+			break;
+		}
+		started_count++;
+	}
+
+	pthread_sigmask(SIG_SETMASK, &previous_signals, NULL);
+
+	bool is_successful                  = started_count != 0;
+	if (!is_successful) {
+		(void)fprintf(stderr, "Error: Failed to start the workers\n");
+	}
+
+	ChessAnalysisServerClient **clients = NULL;
+	struct pollfd *descriptors          = NULL;
+	size_t client_count                 = 0;
+	size_t client_capacity              = 0;
+	while (is_successful && !chess_analysis_server_is_quitting) {
+		if (client_count + 1 > client_capacity) {
+			size_t capacity                         = client_capacity == 0 ? 16 : 2 * client_capacity;
+			ChessAnalysisServerClient **new_clients = realloc(clients, capacity * sizeof(*clients));
+			if (new_clients != NULL) {
+				clients = new_clients;
+			}
+			struct pollfd *new_descriptors = realloc(descriptors, (capacity + 1) * sizeof(*descriptors));
+			if (new_descriptors != NULL) {
+				descriptors = new_descriptors;
+			}
+			if (new_clients == NULL || new_descriptors == NULL) {
+				(void)fprintf(stderr, "Error: Failed to allocate the clients\n");
+				is_successful = false;
+				break;
+			}
+			client_capacity = capacity;
+		}
+
+		// Clients that finished sending are only watched for hanging up, and checked again now and then for being done.
+		int timeout    = -1;
+		descriptors[0] = (struct pollfd){ .fd = listener, .events = POLLIN, .revents = 0 };
+		for (size_t i = 0; i < client_count; i++) {
+			descriptors[i + 1] = (struct pollfd){ .fd = clients[i]->descriptor, .events = clients[i]->is_reading ? POLLIN : 0, .revents = 0 };
+			if (!clients[i]->is_reading) {
+				timeout = 100;
+			}
+		}
+
+		if (poll(descriptors, client_count + 1, timeout) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			(void)fprintf(stderr, "Error: Failed to poll the clients: %s\n", strerror(errno));
+			is_successful = false;
+			break;
+		}
+
+		size_t polled_count = client_count;
+		for (size_t i = polled_count; i-- > 0;) {
+			short events = descriptors[i + 1].revents;
+			if ((events & (POLLHUP | POLLERR | POLLNVAL)) != 0 ||
+			    ((events & POLLIN) != 0 && !chess_analysis_server_client_read(&queue, clients[i], default_depth))) {
+				chess_analysis_server_client_close(clients[i]);
+			} else if (!chess_analysis_server_client_is_done(clients[i])) {
+				continue;
+			}
+
+			chess_analysis_server_client_release(clients[i]);
+			clients[i] = clients[--client_count];
+		}
+
+		if ((descriptors[0].revents & POLLIN) != 0) {
+			int descriptor = accept(listener, NULL, NULL);
+			if (descriptor < 0) {
+				continue;
+			}
+
+			ChessAnalysisServerClient *client = malloc(sizeof(*client));
+			if (client == NULL) {
+				close(descriptor);
+				continue;
+			}
+			*client = (ChessAnalysisServerClient){
+				.descriptor      = descriptor,
+				.reference_count = 1,
+				.is_closed       = false,
+				.is_reading      = true,
+				.stop            = false,
+				.buffer          = NULL,
+				.size            = 0,
+				.length          = 0,
+			};
+			pthread_mutex_init(&client->mutex, NULL);
+			pthread_mutex_init(&client->write_mutex, NULL);
+			clients[client_count++] = client;
+		}
+	}
+
+	// Shutting down stops the searches in progress and drops the requests still queued.
+	for (size_t i = 0; i < client_count; i++) {
+		chess_analysis_server_client_close(clients[i]);
+		chess_analysis_server_client_release(clients[i]);
+	}
+	free(clients);
+	free(descriptors);
+
+	pthread_mutex_lock(&queue.mutex);
+	queue.is_quitting = true;
+	pthread_cond_broadcast(&queue.condition);
+	pthread_mutex_unlock(&queue.mutex);
+	for (size_t i = 0; i < started_count; i++) {
+		pthread_join(workers[i], NULL);
+	}
+	free(workers);
+
+	chess_transposition_table_drop(&queue.table);
+	pthread_cond_destroy(&queue.condition);
+	pthread_mutex_destroy(&queue.mutex);
+
+	close(listener);
+	unlink(path);
+
+	return is_successful ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,449 @@
+#if !defined(_POSIX_C_SOURCE)
+	#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <chess.h>
+#include <ctype.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+// A move played from a position, with the results of the games it was played in from the perspective of its player.
+typedef struct ChessBookBuilderEntry {
+	uint64_t key;
+	uint16_t move;
+	uint32_t game_count;
+	uint32_t win_count;
+	uint32_t draw_count;
+} ChessBookBuilderEntry;
+
+// An open addressing hash map of the entries, keyed by the key and move, an entry without games being empty.
+typedef struct ChessBookBuilderMap {
+	ChessBookBuilderEntry *entries;
+	size_t size;
+	size_t count;
+} ChessBookBuilderMap;
+
+typedef struct ChessBookBuilderWorker {
+	pthread_t thread;
+	size_t index;
+	size_t worker_count;
+	char *const *paths;
+	size_t path_count;
+	unsigned int maximum_ply;
+	ChessBookBuilderMap map;
+	size_t game_count;
+	bool is_successful;
+} ChessBookBuilderWorker;
+
+// The moves of a game within the maximum ply, added to the map once its result is known.
+typedef struct ChessBookBuilderGame {
+	ChessPosition position;
+	uint64_t keys[1024];
+	uint16_t moves[1024];
+	size_t ply;
+	unsigned int maximum_ply;
+	bool is_replaying;
+	bool is_result_known;
+	double white_score;
+} ChessBookBuilderGame;
+
+static size_t chess_book_builder_map_index(const ChessBookBuilderMap *map, uint64_t key, uint16_t move) {
+	uint64_t hash = (key ^ (uint64_t)move * 0x9E3779B97F4A7C15ULL) * 0xBF58476D1CE4E5B9ULL;
+	size_t index  = (size_t)(hash >> 32U) & (map->size - 1);
+	while (map->entries[index].game_count != 0 && (map->entries[index].key != key || map->entries[index].move != move)) {
+		index = (index + 1) & (map->size - 1);
+	}
+
+	return index;
+}
+static bool chess_book_builder_map_add(ChessBookBuilderMap *map, uint64_t key, uint16_t move, double score) {
+	// The map is kept at most half full, so that probes stay short.
+	if (2 * (map->count + 1) > map->size) {
+		ChessBookBuilderMap new_map = {
+			.entries = calloc(map->size == 0 ? 1024 : 2 * map->size, sizeof(ChessBookBuilderEntry)),
+			.size    = map->size == 0 ? 1024 : 2 * map->size,
+			.count   = map->count,
+		};
+		if (new_map.entries == NULL) {
+			return false;
+		}
+
+		for (size_t i = 0; i < map->size; i++) {
+			if (map->entries[i].game_count != 0) {
+				new_map.entries[chess_book_builder_map_index(&new_map, map->entries[i].key, map->entries[i].move)] = map->entries[i];
+			}
+		}
+
+		free(map->entries);
+		*map = new_map;
+	}
+
+	ChessBookBuilderEntry *entry = &map->entries[chess_book_builder_map_index(map, key, move)];
+	if (entry->game_count == 0) {
+		entry->key  = key;
+		entry->move = move;
+		map->count++;
+	}
+
+	entry->game_count++;
+	entry->win_count += score > 0.75;
+	entry->draw_count += score > 0.25 && score < 0.75;
+
+	return true;
+}
+static void chess_book_builder_game_begin(ChessBookBuilderGame *game) {
+	game->position        = chess_position_new();
+	game->ply             = 0;
+	game->is_replaying    = true;
+	game->is_result_known = false;
+	game->white_score     = 0.0;
+}
+static bool chess_book_builder_game_end(ChessBookBuilderGame *game, ChessBookBuilderMap *map) {
+	if (game->is_result_known) {
+		for (size_t i = 0; i < game->ply; i++) {
+			double score = i % 2 == 0 ? game->white_score : 1.0 - game->white_score;
+			if (!chess_book_builder_map_add(map, game->keys[i], game->moves[i], score)) {
+				return false;
+			}
+		}
+	}
+
+	game->ply          = 0;
+	game->is_replaying = false;
+
+	return true;
+}
+static void chess_book_builder_game_read_tag(ChessBookBuilderGame *game, const char *line) {
+	const char *value = strchr(line, '"');
+	if (value == NULL) {
+		return;
+	}
+	value++;
+
+	if (strncmp(line, "[Result ", 8) == 0) {
+		game->is_result_known = true;
+		if (strncmp(value, "1-0", 3) == 0) {
+			game->white_score = 1.0;
+		} else if (strncmp(value, "0-1", 3) == 0) {
+			game->white_score = 0.0;
+		} else if (strncmp(value, "1/2-1/2", 7) == 0) {
+			game->white_score = 0.5;
+		} else {
+			game->is_result_known = false;
+		}
+	} else if (strncmp(line, "[FEN ", 5) == 0) {
+		// Only games from the start position are replayed, as moves from other positions rarely lead to book positions,
+		// and games of variants have a FEN tag.
+		game->is_replaying = strncmp(value, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 56) == 0;
+	}
+}
+static void chess_book_builder_game_read_move(ChessBookBuilderGame *game, const char *string) {
+	if (!game->is_replaying) {
+		return;
+	}
+
+	if (game->ply == game->maximum_ply || game->ply == sizeof(game->keys) / sizeof(game->keys[0])) {
+		game->is_replaying = false;
+		return;
+	}
+
+	// A move which cannot be read ends the replay of the game, but the moves before it are still added.
+	ChessMove move;
+	if (chess_move_from_algebraic(&game->position, &move, string) == 0 || !chess_move_is_legal(&game->position, move)) {
+		game->is_replaying = false;
+		return;
+	}
+
+	game->keys[game->ply]  = chess_book_key(&game->position);
+	game->moves[game->ply] = chess_book_encode_move(&game->position, move);
+	game->ply++;
+
+	chess_move_do(&game->position, move);
+}
+// Reads the movetext of a line, the nesting of comments and variations being carried over from the earlier lines.
+static void chess_book_builder_game_read_movetext(ChessBookBuilderGame *game, const char *line, unsigned int *comment_depth, unsigned int *variation_depth) {
+	for (size_t i = 0; line[i] != '\0';) {
+		if (*comment_depth > 0) {
+			*comment_depth -= line[i] == '}';
+			i++;
+			continue;
+		}
+
+		if (line[i] == '{') {
+			*comment_depth = 1;
+			i++;
+		} else if (line[i] == ';') {
+			return;
+		} else if (line[i] == '(') {
+			(*variation_depth)++;
+			i++;
+		} else if (line[i] == ')') {
+			*variation_depth -= *variation_depth > 0;
+			i++;
+		} else if (isspace((unsigned char)line[i]) || line[i] == '.') {
+			i++;
+		} else {
+			size_t length = strcspn(&line[i], " \t\r\n{}();");
+
+			// Skips move numbers, NAGs and results, the digits of a move number possibly running into its move, which
+			// may be a castling written with zeros.
+			size_t start  = i;
+			if (line[i] != '$' && strncmp(&line[i], "1-0", 3) != 0 && strncmp(&line[i], "0-1", 3) != 0 && strncmp(&line[i], "1/2", 3) != 0) {
+				while (start < i + length && (isdigit((unsigned char)line[start]) || line[start] == '.') && strncmp(&line[start], "0-0", 3) != 0) {
+					start++;
+				}
+
+				if (start < i + length && *variation_depth == 0 && line[start] != '*') {
+					char string[16]      = { 0 };
+					size_t string_length = i + length - start < sizeof(string) - 1 ? i + length - start : sizeof(string) - 1;
+					memcpy(string, &line[start], string_length);
+					if (strncmp(string, "0-0", 3) == 0) {
+						for (size_t j = 0; string[j] == '0' || string[j] == '-'; j++) {
+							string[j] = string[j] == '0' ? 'O' : '-';
+						}
+					}
+					chess_book_builder_game_read_move(game, string);
+				}
+			}
+
+			i += length;
+		}
+	}
+}
+static bool chess_book_builder_read(ChessBookBuilderWorker *worker, const char *path) {
+	FILE *file = fopen(path, "r");
+	if (file == NULL) {
+		(void)fprintf(stderr, "Error: Failed to open %s\n", path);
+		return false;
+	}
+
+	// Every worker reads the games starting in its share of the file, each game starting with an Event tag.
+	bool is_successful         = fseeko(file, 0, SEEK_END) == 0;
+	off_t size                 = ftello(file);
+	off_t begin                = (off_t)((double)size * (double)worker->index / (double)worker->worker_count);
+	off_t end                  = (off_t)((double)size * (double)(worker->index + 1) / (double)worker->worker_count);
+	is_successful              = is_successful && size >= 0 && fseeko(file, begin, SEEK_SET) == 0;
+
+	ChessBookBuilderGame *game = malloc(sizeof(*game));
+	if (game == NULL) {
+		(void)fclose(file);
+		return false;
+	}
+	game->position               = chess_position_new();
+	game->maximum_ply            = worker->maximum_ply;
+	game->ply                    = 0;
+	game->is_replaying           = false;
+	game->is_result_known        = false;
+	game->white_score            = 0.0;
+
+	char *line                   = NULL;
+	size_t line_size             = 0;
+	bool is_started              = false;
+	unsigned int comment_depth   = 0;
+	unsigned int variation_depth = 0;
+	while (is_successful) {
+		off_t offset   = ftello(file);
+		ssize_t length = getline(&line, &line_size, file);
+		if (length < 0) {
+			break;
+		}
+
+		if (strncmp(line, "[Event ", 7) == 0 && comment_depth == 0) {
+			if (offset >= end) {
+				break;
+			}
+
+			is_successful = chess_book_builder_game_end(game, &worker->map);
+			chess_book_builder_game_begin(game);
+			is_started      = true;
+			variation_depth = 0;
+			worker->game_count++;
+		} else if (!is_started) {
+			continue;
+		} else if (line[0] == '[' && comment_depth == 0) {
+			chess_book_builder_game_read_tag(game, line);
+		} else {
+			chess_book_builder_game_read_movetext(game, line, &comment_depth, &variation_depth);
+		}
+	}
+
+	is_successful = is_successful && chess_book_builder_game_end(game, &worker->map);
+
+	free(line);
+	free(game);
+	(void)fclose(file);
+
+	return is_successful;
+}
+static void *chess_book_builder_run(void *argument) {
+	ChessBookBuilderWorker *worker = argument;
+
+	worker->is_successful          = true;
+	for (size_t i = 0; i < worker->path_count && worker->is_successful; i++) {
+		worker->is_successful = chess_book_builder_read(worker, worker->paths[i]);
+	}
+
+	return NULL;
+}
+static int chess_book_builder_compare(const void *a, const void *b) {
+	const ChessBookBuilderEntry *entry_a = a;
+	const ChessBookBuilderEntry *entry_b = b;
+	if (entry_a->key != entry_b->key) {
+		return entry_a->key < entry_b->key ? -1 : 1;
+	}
+	return (entry_a->move > entry_b->move) - (entry_a->move < entry_b->move);
+}
+static bool chess_book_builder_write(const char *path, const ChessBookBuilderEntry *entries, size_t entry_count) {
+	FILE *file = fopen(path, "wb");
+	if (file == NULL) {
+		return false;
+	}
+
+	bool is_successful = true;
+	for (size_t begin = 0, end = 0; begin < entry_count && is_successful; begin = end) {
+		// The weight of a move is twice its wins plus its draws, scaled down when the largest weight of its position
+		// does not fit.
+		uint64_t maximum_weight = 0;
+		for (end = begin; end < entry_count && entries[end].key == entries[begin].key; end++) {
+			uint64_t weight = 2 * (uint64_t)entries[end].win_count + entries[end].draw_count;
+			maximum_weight  = weight > maximum_weight ? weight : maximum_weight;
+		}
+
+		for (size_t i = begin; i < end && is_successful; i++) {
+			uint64_t weight = 2 * (uint64_t)entries[i].win_count + entries[i].draw_count;
+			if (maximum_weight > UINT16_MAX) {
+				weight = weight * UINT16_MAX / maximum_weight;
+			}
+
+			uint8_t bytes[CHESS_BOOK_ENTRY_SIZE] = { 0 };
+			for (size_t j = 0; j < 8; j++) {
+				bytes[j] = (uint8_t)(entries[i].key >> (56U - 8U * j));
+			}
+			bytes[8]      = (uint8_t)(entries[i].move >> 8U);
+			bytes[9]      = (uint8_t)entries[i].move;
+			bytes[10]     = (uint8_t)(weight >> 8U);
+			bytes[11]     = (uint8_t)weight;
+
+			is_successful = fwrite(bytes, 1, sizeof(bytes), file) == sizeof(bytes);
+		}
+	}
+
+	return fclose(file) == 0 && is_successful;
+}
+
+int main(int argc, char **argv) {
+	unsigned int maximum_ply   = 32;
+	unsigned int minimum_games = 3;
+	long worker_count          = sysconf(_SC_NPROCESSORS_ONLN);
+
+	int argument               = 1;
+	for (; argument + 1 < argc && argv[argument][0] == '-'; argument += 2) {
+		long value = strtol(argv[argument + 1], NULL, 10);
+		if (strcmp(argv[argument], "-p") == 0 && value > 0) {
+			maximum_ply = (unsigned int)value;
+		} else if (strcmp(argv[argument], "-m") == 0 && value > 0) {
+			minimum_games = (unsigned int)value;
+		} else if (strcmp(argv[argument], "-j") == 0 && value > 0) {
+			worker_count = value;
+		} else {
+			break;
+		}
+	}
+
+	if (argc - argument < 2) {
+		(void)fprintf(stderr, "Usage: %s [-p plies] [-m games] [-j threads] <book> <pgn>...\n", argv[0]);
+		(void)fprintf(stderr, "Builds a Polyglot opening book from the first plies (32) of the games of the given PGN files, keeping the moves played in at least the given number of games (3), using the given number of threads (one per processor).\n");
+		return EXIT_FAILURE;
+	}
+	if (worker_count < 1) {
+		worker_count = 1;
+	}
+
+	time_t start_time               = time(NULL);
+
+	ChessBookBuilderWorker *workers = calloc((size_t)worker_count, sizeof(*workers));
+	if (workers == NULL) {
+		(void)fprintf(stderr, "Error: Failed to allocate the workers\n");
+		return EXIT_FAILURE;
+	}
+
+	// Each worker builds its own map of a share of every file, the maps being merged once all workers are done.
+	size_t started_count = 0;
+	for (size_t i = 0; i < (size_t)worker_count; i++) {
+		workers[i] = (ChessBookBuilderWorker){
+			.index         = i,
+			.worker_count  = (size_t)worker_count,
+			.paths         = &argv[argument + 1],
+			.path_count    = (size_t)(argc - argument - 1),
+			.maximum_ply   = maximum_ply,
+			.map           = { .entries = NULL, .size = 0, .count = 0 },
+			.game_count    = 0,
+			.is_successful = false,
+		};
+		if (pthread_create(&workers[i].thread, NULL, chess_book_builder_run, &workers[i]) != 0) {
+			break;
+		}
+		started_count++;
+	}
+
+	bool is_successful = started_count == (size_t)worker_count;
+	size_t game_count  = 0;
+	size_t entry_count = 0;
+	for (size_t i = 0; i < started_count; i++) {
+		pthread_join(workers[i].thread, NULL);
+		is_successful = is_successful && workers[i].is_successful;
+		game_count += workers[i].game_count;
+		entry_count += workers[i].map.count;
+	}
+
+	ChessBookBuilderEntry *entries = is_successful ? malloc((entry_count == 0 ? 1 : entry_count) * sizeof(*entries)) : NULL;
+	is_successful                  = entries != NULL;
+
+	size_t count                   = 0;
+	for (size_t i = 0; i < started_count; i++) {
+		for (size_t j = 0; is_successful && j < workers[i].map.size; j++) {
+			if (workers[i].map.entries[j].game_count != 0) {
+				entries[count++] = workers[i].map.entries[j];
+			}
+		}
+		free(workers[i].map.entries);
+	}
+	free(workers);
+
+	size_t book_entry_count = 0;
+	if (is_successful) {
+		qsort(entries, count, sizeof(*entries), chess_book_builder_compare);
+
+		// Merges the entries of the same move from different workers, dropping the moves played too rarely.
+		for (size_t i = 0; i < count;) {
+			ChessBookBuilderEntry entry = entries[i];
+			for (i++; i < count && entries[i].key == entry.key && entries[i].move == entry.move; i++) {
+				entry.game_count += entries[i].game_count;
+				entry.win_count += entries[i].win_count;
+				entry.draw_count += entries[i].draw_count;
+			}
+
+			if (entry.game_count >= minimum_games) {
+				entries[book_entry_count++] = entry;
+			}
+		}
+
+		is_successful = chess_book_builder_write(argv[argument], entries, book_entry_count);
+	}
+	free(entries);
+
+	if (!is_successful) {
+		(void)fprintf(stderr, "Error: Failed to build %s\n", argv[argument]);
+		return EXIT_FAILURE;
+	}
+
+	printf("Built %s from %zu games with %zu entries in %.0f s\n", argv[argument], game_count, book_entry_count, difftime(time(NULL), start_time));
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,39 @@
+#include <chess/allocator.h>
+
+#include <assert.h>
+#include <stdlib.h>
+
+bool chess_allocator_is_valid(const ChessAllocator *allocator) {
+	return allocator != CHESS_NULL && allocator->allocate != CHESS_NULL && allocator->deallocate != CHESS_NULL;
+}
+static void *chess_allocator_default_allocate(size_t size, void *data) {
+	(void)data;
+
+	return malloc(size);
+}
+static void chess_allocator_default_deallocate(void *pointer, size_t size, void *data) {
+	(void)size;
+	(void)data;
+
+	free(pointer);
+}
+ChessAllocator chess_allocator_default(void) {
+	return (ChessAllocator){
+		.allocate   = chess_allocator_default_allocate,
+		.deallocate = chess_allocator_default_deallocate,
+		.data       = CHESS_NULL,
+	};
+}
+void *chess_allocator_allocate(const ChessAllocator *allocator, size_t size) {
+	assert(chess_allocator_is_valid(allocator));
+	assert(size != 0);
+
+	return allocator->allocate(size, allocator->data);
+}
+void chess_allocator_deallocate(const ChessAllocator *allocator, void *pointer, size_t size) {
+	assert(chess_allocator_is_valid(allocator));
+
+	if (pointer != CHESS_NULL) {
+		allocator->deallocate(pointer, size, allocator->data);
+	}
+}
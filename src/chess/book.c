@@ -0,0 +1,257 @@
+#include <chess/book.h>
+
+#include <chess/color.h>
+#include <chess/file.h>
+#include <chess/mapping.h>
+#include <chess/offset.h>
+#include <chess/piece.h>
+#include <chess/piece_type.h>
+#include <chess/polyglot.h>
+#include <chess/position.h>
+#include <chess/rank.h>
+#include <chess/square.h>
+
+#include <assert.h>
+
+// The number of entries checked for being sorted when loading a book.
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_BOOK_SAMPLE_COUNT, 64);
+
+static uint64_t chess_book_read(const uint8_t *bytes, size_t size) {
+	assert(bytes != CHESS_NULL);
+	assert(size <= sizeof(uint64_t));
+
+	uint64_t value = 0;
+	for (size_t i = 0; i < size; i++) {
+		value = value << 8U | bytes[i];
+	}
+
+	return value;
+}
+static uint64_t chess_book_entry_key(const ChessBook *book, size_t index) {
+	assert(book != CHESS_NULL);
+	assert(index < book->entry_count);
+
+	return chess_book_read(book->entries + index * CHESS_BOOK_ENTRY_SIZE, 8);
+}
+static uint64_t chess_book_entry_weight(const ChessBook *book, size_t index) {
+	assert(book != CHESS_NULL);
+	assert(index < book->entry_count);
+
+	return chess_book_read(book->entries + index * CHESS_BOOK_ENTRY_SIZE + 10, 2);
+}
+static bool chess_book_entry_move(const ChessBook *book, size_t index, const ChessPosition *position, ChessMove *move) {
+	assert(book != CHESS_NULL);
+	assert(index < book->entry_count);
+	assert(chess_position_is_valid(position));
+	assert(move != CHESS_NULL);
+
+	uint64_t value     = chess_book_read(book->entries + index * CHESS_BOOK_ENTRY_SIZE + 8, 2);
+
+	ChessSquare from   = chess_square_new((ChessFile)(value >> 6U & 0x7U), (ChessRank)(value >> 9U & 0x7U));
+	ChessSquare to     = chess_square_new((ChessFile)(value & 0x7U), (ChessRank)(value >> 3U & 0x7U));
+	uint64_t promotion = value >> 12U & 0x7U;
+	if (promotion > CHESS_PIECE_TYPE_QUEEN) {
+		return false;
+	}
+
+	ChessPiece piece  = position->board[from];
+	ChessPiece target = position->board[to];
+	if (piece == CHESS_PIECE_NONE || chess_piece_type(target) == CHESS_PIECE_TYPE_KING) {
+		return false;
+	}
+
+	// Castlings are encoded as the king capturing its own rook.
+	if (chess_piece_type(piece) == CHESS_PIECE_TYPE_KING && target == chess_piece_new(chess_piece_color(piece), CHESS_PIECE_TYPE_ROOK)) {
+		to = from + (to > from ? 2 * CHESS_OFFSET_EAST : 2 * CHESS_OFFSET_WEST);
+	}
+
+	*move = chess_move_new(position, from, to, promotion == 0 ? CHESS_PIECE_TYPE_NONE : (ChessPieceType)promotion);
+	return chess_move_is_legal(position, *move);
+}
+bool chess_book_is_valid(const ChessBook *book) {
+	if (book == CHESS_NULL) {
+		return false;
+	}
+
+	if (book->mapping == CHESS_NULL) {
+		return book->entries == CHESS_NULL && book->entry_count == 0;
+	}
+
+	return book->entries == book->mapping && book->entry_count * CHESS_BOOK_ENTRY_SIZE == book->mapping_size;
+}
+ChessBook chess_book_new(void) {
+	return (ChessBook){
+		.entries      = CHESS_NULL,
+		.entry_count  = 0,
+		.mapping      = CHESS_NULL,
+		.mapping_size = 0,
+	};
+}
+void chess_book_drop(ChessBook *book) {
+	assert(chess_book_is_valid(book));
+
+	if (book->mapping != CHESS_NULL) {
+		chess_mapping_unmap(book->mapping, book->mapping_size);
+	}
+
+	*book = chess_book_new();
+}
+bool chess_book_load(ChessBook *book, const char *path) {
+	assert(chess_book_is_valid(book));
+	assert(path != CHESS_NULL);
+
+	size_t mapping_size = 0;
+	void *mapping       = chess_mapping_map(path, &mapping_size);
+	if (mapping == CHESS_NULL) {
+		return false;
+	}
+
+	ChessBook new_book = {
+		.entries      = mapping,
+		.entry_count  = mapping_size / CHESS_BOOK_ENTRY_SIZE,
+		.mapping      = mapping,
+		.mapping_size = mapping_size,
+	};
+
+	// The entries must be sorted by key, as they are looked up by binary search. Only a sample spread over the book is
+	// checked, so that loading a large book reads a few of its pages rather than all of them.
+	bool is_successful  = mapping_size % CHESS_BOOK_ENTRY_SIZE == 0;
+	size_t sample_count = new_book.entry_count < CHESS_BOOK_SAMPLE_COUNT ? new_book.entry_count : CHESS_BOOK_SAMPLE_COUNT;
+	for (size_t i = 1; is_successful && i < sample_count; i++) {
+		size_t previous_index = (i - 1) * new_book.entry_count / sample_count;
+		size_t index          = i * new_book.entry_count / sample_count;
+		is_successful         = chess_book_entry_key(&new_book, previous_index) <= chess_book_entry_key(&new_book, index);
+	}
+
+	if (!is_successful) {
+		chess_mapping_unmap(mapping, mapping_size);
+		return false;
+	}
+
+	chess_book_drop(book);
+	*book = new_book;
+
+	return true;
+}
+uint64_t chess_book_key(const ChessPosition *position) {
+	assert(chess_position_is_valid(position));
+
+	uint64_t key = 0;
+
+	for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
+		for (ChessPieceType type = CHESS_PIECE_TYPE_PAWN; type <= CHESS_PIECE_TYPE_KING; type++) {
+			for (size_t i = 0; i < position->piece_counts[color][type]; i++) {
+				ChessSquare square = position->pieces[color][type][i];
+				key ^= chess_polyglot_piece_at_square[position->board[square]][square];
+			}
+		}
+	}
+
+	if (position->side_to_move == CHESS_COLOR_WHITE) {
+		key ^= chess_polyglot_side_to_move;
+	}
+
+	key ^= chess_polyglot_castling_rights[position->castling_rights];
+
+	// The en passant file only counts when a pawn of the side to move stands next to the pawn which just moved.
+	if (position->en_passant_square != CHESS_SQUARE_NONE) {
+		ChessOffset direction = position->side_to_move == CHESS_COLOR_WHITE ? CHESS_OFFSET_NORTH : CHESS_OFFSET_SOUTH;
+		ChessPiece pawn       = chess_piece_new(position->side_to_move, CHESS_PIECE_TYPE_PAWN);
+
+		ChessSquare west      = position->en_passant_square - direction + CHESS_OFFSET_WEST;
+		ChessSquare east      = position->en_passant_square - direction + CHESS_OFFSET_EAST;
+		if ((chess_square_is_valid(west) && position->board[west] == pawn) ||
+		    (chess_square_is_valid(east) && position->board[east] == pawn)) {
+			key ^= chess_polyglot_en_passant_file[chess_square_file(position->en_passant_square)];
+		}
+	}
+
+	return key;
+}
+uint16_t chess_book_encode_move(const ChessPosition *position, ChessMove move) {
+	assert(chess_position_is_valid(position));
+	assert(chess_move_is_legal(position, move));
+
+	// Castlings are encoded as the king capturing its own rook.
+	ChessSquare to = move.to;
+	if (chess_move_is_kingside_castling(position, move)) {
+		to = chess_square_new(CHESS_FILE_H, chess_square_rank(move.from));
+	} else if (chess_move_is_queenside_castling(position, move)) {
+		to = chess_square_new(CHESS_FILE_A, chess_square_rank(move.from));
+	}
+
+	unsigned int promotion = move.promotion_type == CHESS_PIECE_TYPE_NONE ? 0U : (unsigned int)move.promotion_type;
+
+	return (uint16_t)((unsigned int)chess_square_file(to) | (unsigned int)chess_square_rank(to) << 3U |
+	                  (unsigned int)chess_square_file(move.from) << 6U | (unsigned int)chess_square_rank(move.from) << 9U |
+	                  promotion << 12U);
+}
+bool chess_book_probe(const ChessBook *book, const ChessPosition *position, ChessBookSelection selection, uint32_t random, ChessMove *move) {
+	assert(chess_book_is_valid(book));
+	assert(chess_position_is_valid(position));
+	assert(selection == CHESS_BOOK_SELECTION_BEST || selection == CHESS_BOOK_SELECTION_WEIGHTED);
+	assert(move != CHESS_NULL);
+
+	uint64_t key = chess_book_key(position);
+
+	// Finds the first entry of the position.
+	size_t low  = 0;
+	size_t high = book->entry_count;
+	while (low < high) {
+		size_t middle = low + (high - low) / 2;
+		if (chess_book_entry_key(book, middle) < key) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	size_t end = low;
+	while (end < book->entry_count && chess_book_entry_key(book, end) == key) {
+		end++;
+	}
+
+	if (selection == CHESS_BOOK_SELECTION_BEST) {
+		bool is_found = false;
+		uint64_t best = 0;
+		for (size_t i = low; i < end; i++) {
+			ChessMove entry_move;
+			uint64_t weight = chess_book_entry_weight(book, i);
+			if ((!is_found || weight > best) && chess_book_entry_move(book, i, position, &entry_move)) {
+				*move    = entry_move;
+				best     = weight;
+				is_found = true;
+			}
+		}
+
+		return is_found;
+	}
+
+	// Only the legal moves share the total weight, so the random number is reduced modulo the sum of their weights.
+	uint64_t total_weight = 0;
+	for (size_t i = low; i < end; i++) {
+		ChessMove entry_move;
+		if (chess_book_entry_move(book, i, position, &entry_move)) {
+			total_weight += chess_book_entry_weight(book, i);
+		}
+	}
+
+	if (total_weight == 0) {
+		return false;
+	}
+
+	uint64_t target    = random % total_weight;
+	uint64_t cumulated = 0;
+	for (size_t i = low; i < end; i++) {
+		ChessMove entry_move;
+		if (chess_book_entry_move(book, i, position, &entry_move)) {
+			cumulated += chess_book_entry_weight(book, i);
+			if (target < cumulated) {
+				*move = entry_move;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
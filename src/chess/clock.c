@@ -0,0 +1,41 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+	#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <chess/clock.h>
+
+#include <assert.h>
+
+#if defined(_WIN32)
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
+
+uint64_t chess_clock_milliseconds(void) {
+#if defined(_WIN32)
+	static LARGE_INTEGER frequency = { 0 };
+	if (frequency.QuadPart == 0) {
+		QueryPerformanceFrequency(&frequency);
+	}
+
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+
+	return (uint64_t)counter.QuadPart / ((uint64_t)frequency.QuadPart / 1000U);
+#elif defined(CLOCK_MONOTONIC)
+	struct timespec time = { 0 };
+	int result           = clock_gettime(CLOCK_MONOTONIC, &time);
+	assert(result == 0);
+	(void)result;
+
+	return (uint64_t)time.tv_sec * 1000U + (uint64_t)time.tv_nsec / 1000000U;
+#else
+	struct timespec time = { 0 };
+	int result           = timespec_get(&time, TIME_UTC);
+	assert(result == TIME_UTC);
+	(void)result;
+
+	return (uint64_t)time.tv_sec * 1000U + (uint64_t)time.tv_nsec / 1000000U;
+#endif
+}
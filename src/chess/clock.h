@@ -0,0 +1,16 @@
+#ifndef CHESS_CLOCK_H_INCLUDED
+#define CHESS_CLOCK_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+uint64_t chess_clock_milliseconds(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_CLOCK_H_INCLUDED
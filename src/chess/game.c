@@ -0,0 +1,249 @@
+#include <chess/game.h>
+
+#include <chess/allocator.h>
+#include <chess/move.h>
+#include <chess/move_private.h>
+#include <chess/position.h>
+#include <chess/position_counter.h>
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <string.h>
+
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_GAME_INITIAL_CAPACITY, 64);
+
+bool chess_game_is_valid(const ChessGame *game) {
+	assert(game != CHESS_NULL);
+
+	if (!chess_position_is_valid(&game->position) || !chess_position_counter_is_valid(&game->position_counter) ||
+	    !chess_allocator_is_valid(&game->allocator)) {
+		return false;
+	}
+
+	if (game->keys == CHESS_NULL) {
+		return game->moves == CHESS_NULL && game->move_count == 0 && game->redo_count == 0 && game->move_capacity == 0;
+	}
+
+	return game->moves == (ChessMove *)(game->keys + game->move_capacity) &&
+	       game->move_count <= game->move_capacity && game->redo_count <= game->move_capacity - game->move_count;
+}
+ChessGame chess_game_new(void) {
+	return chess_game_new_with_allocator(chess_allocator_default());
+}
+ChessGame chess_game_new_with_allocator(ChessAllocator allocator) {
+	assert(chess_allocator_is_valid(&allocator));
+
+	ChessGame game = {
+		.position         = chess_position_new(),
+		.keys             = CHESS_NULL,
+		.moves            = CHESS_NULL,
+		.move_count       = 0,
+		.redo_count       = 0,
+		.move_capacity    = 0,
+		.position_counter = chess_position_counter_new_with_allocator(allocator),
+		.allocator        = allocator,
+	};
+	chess_position_counter_increment(&game.position_counter, &game.position);
+
+	return game;
+}
+void chess_game_drop(ChessGame *game) {
+	assert(chess_game_is_valid(game));
+
+	chess_allocator_deallocate(&game->allocator, game->keys, game->move_capacity * (sizeof(*game->keys) + sizeof(*game->moves)));
+	chess_position_counter_drop(&game->position_counter);
+
+	game->keys          = CHESS_NULL;
+	game->moves         = CHESS_NULL;
+	game->move_count    = 0;
+	game->redo_count    = 0;
+	game->move_capacity = 0;
+}
+bool chess_game_reset(ChessGame *game, const ChessPosition *position) {
+	assert(chess_game_is_valid(game));
+	assert(chess_position_is_valid(position));
+
+	game->position   = *position;
+	game->move_count = 0;
+	game->redo_count = 0;
+	chess_position_counter_clear(&game->position_counter);
+
+	return chess_position_counter_increment(&game->position_counter, &game->position);
+}
+const ChessPosition *chess_game_position(const ChessGame *game) {
+	assert(chess_game_is_valid(game));
+
+	return &game->position;
+}
+static bool chess_game_reserve_moves(ChessGame *game, size_t capacity) {
+	assert(chess_game_is_valid(game));
+
+	if (capacity <= game->move_capacity) {
+		return true;
+	}
+
+	size_t new_capacity = game->move_capacity == 0 ? CHESS_GAME_INITIAL_CAPACITY : game->move_capacity;
+	while (new_capacity < capacity) {
+		if (new_capacity > SIZE_MAX / 2 / (sizeof(*game->keys) + sizeof(*game->moves))) {
+			return false;
+		}
+		new_capacity *= 2;
+	}
+
+	uint64_t *keys = chess_allocator_allocate(&game->allocator, new_capacity * (sizeof(*game->keys) + sizeof(*game->moves)));
+	if (keys == CHESS_NULL) {
+		return false;
+	}
+
+	ChessMove *moves = (ChessMove *)(keys + new_capacity);
+	if (game->move_count + game->redo_count != 0) {
+		memcpy(keys, game->keys, (game->move_count + game->redo_count) * sizeof(*keys));
+		memcpy(moves, game->moves, (game->move_count + game->redo_count) * sizeof(*moves));
+	}
+	chess_allocator_deallocate(&game->allocator, game->keys, game->move_capacity * (sizeof(*game->keys) + sizeof(*game->moves)));
+
+	game->keys          = keys;
+	game->moves         = moves;
+	game->move_capacity = new_capacity;
+
+	return true;
+}
+bool chess_game_reserve(ChessGame *game, size_t move_count) {
+	assert(chess_game_is_valid(game));
+
+	return move_count <= SIZE_MAX - game->move_count && chess_game_reserve_moves(game, game->move_count + move_count) &&
+	       chess_position_counter_reserve(&game->position_counter, game->position_counter.count + move_count);
+}
+static bool chess_game_is_same_move(ChessMove move_1, ChessMove move_2) {
+	return move_1.from == move_2.from && move_1.to == move_2.to && move_1.promotion_type == move_2.promotion_type;
+}
+// Makes the given move in the game if it is legal, room for it having been made in the history.
+static bool chess_game_do_move_if_legal(ChessGame *game, ChessMove move) {
+	assert(game->move_count < game->move_capacity);
+
+	uint64_t key = chess_position_hash(&game->position);
+	if (!chess_move_do_if_legal(&game->position, move)) {
+		return false;
+	}
+	if (!chess_position_counter_increment(&game->position_counter, &game->position)) {
+		chess_move_undo_unchecked(&game->position, move);
+		return false;
+	}
+
+	// Playing the move that was taken back keeps the moves after it, while any other move starts a new line.
+	if (game->redo_count != 0 && chess_game_is_same_move(game->moves[game->move_count], move)) {
+		game->redo_count--;
+	} else {
+		game->redo_count = 0;
+	}
+
+	game->moves[game->move_count] = move;
+	game->keys[game->move_count]  = key;
+	game->move_count++;
+
+	return true;
+}
+bool chess_game_do_move(ChessGame *game, ChessMove move) {
+	assert(chess_game_is_valid(game));
+	assert(chess_move_is_valid(move));
+
+	if (!chess_game_reserve_moves(game, game->move_count + 1) || !chess_game_do_move_if_legal(game, move)) {
+		return false;
+	}
+
+	assert(chess_game_is_valid(game));
+
+	return true;
+}
+size_t chess_game_do_moves(ChessGame *game, const ChessMove *moves, size_t count) {
+	assert(chess_game_is_valid(game));
+	assert(moves != CHESS_NULL || count == 0);
+
+	if (count > SIZE_MAX - game->move_count || !chess_game_reserve_moves(game, game->move_count + count)) {
+		return 0;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (!chess_move_is_valid(moves[i]) || !chess_game_do_move_if_legal(game, moves[i])) {
+			return i;
+		}
+	}
+
+	assert(chess_game_is_valid(game));
+
+	return count;
+}
+size_t chess_game_do_uci_moves(ChessGame *game, const char *string, size_t *move_count) {
+	assert(chess_game_is_valid(game));
+	assert(string != CHESS_NULL);
+	assert(move_count != CHESS_NULL);
+
+	size_t total_read = 0;
+	*move_count       = 0;
+	while (true) {
+		size_t read = total_read;
+		while (isspace(string[read])) {
+			read++;
+		}
+		if (string[read] == '\0') {
+			return read;
+		}
+
+		ChessMove move;
+		size_t move_read = chess_move_from_uci_unchecked(&game->position, &move, string + read);
+		if (move_read == 0 || (string[read + move_read] != '\0' && !isspace(string[read + move_read])) ||
+		    !chess_game_reserve_moves(game, game->move_count + 1) || !chess_game_do_move_if_legal(game, move)) {
+			return total_read;
+		}
+
+		total_read = read + move_read;
+		(*move_count)++;
+	}
+}
+bool chess_game_undo_move(ChessGame *game) {
+	assert(chess_game_is_valid(game));
+
+	if (game->move_count == 0) {
+		return false;
+	}
+
+	chess_position_counter_decrement(&game->position_counter, &game->position);
+	chess_move_undo_unchecked(&game->position, game->moves[--game->move_count]);
+	game->redo_count++;
+
+	assert(chess_game_is_valid(game));
+
+	return true;
+}
+bool chess_game_redo_move(ChessGame *game) {
+	assert(chess_game_is_valid(game));
+
+	if (game->redo_count == 0) {
+		return false;
+	}
+
+	// The move and the key of the position it is played from were recorded when the move was first played.
+	ChessMove move = game->moves[game->move_count];
+	chess_move_do_unchecked(&game->position, move);
+	if (!chess_position_counter_increment(&game->position_counter, &game->position)) {
+		chess_move_undo_unchecked(&game->position, move);
+		return false;
+	}
+	game->move_count++;
+	game->redo_count--;
+
+	assert(chess_game_is_valid(game));
+
+	return true;
+}
+unsigned int chess_game_repetition_count(const ChessGame *game) {
+	assert(chess_game_is_valid(game));
+
+	return chess_position_counter_count(&game->position_counter, &game->position);
+}
+bool chess_game_is_threefold_repetition(const ChessGame *game) {
+	assert(chess_game_is_valid(game));
+
+	return chess_game_repetition_count(game) >= 3;
+}
@@ -0,0 +1,231 @@
+#include <chess/game_tree.h>
+
+#include <chess/allocator.h>
+#include <chess/move.h>
+#include <chess/move_private.h>
+#include <chess/position.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_GAME_TREE_INITIAL_CAPACITY, 64);
+
+bool chess_game_tree_is_valid(const ChessGameTree *tree) {
+	assert(tree != CHESS_NULL);
+
+	if (!chess_position_is_valid(&tree->position) || !chess_allocator_is_valid(&tree->allocator)) {
+		return false;
+	}
+
+	if ((tree->nodes == CHESS_NULL) != (tree->node_capacity == 0) ||
+	    (tree->checkpoints == CHESS_NULL) != (tree->checkpoint_capacity == 0)) {
+		return false;
+	}
+
+	return tree->node_count <= tree->node_capacity && tree->node_count < CHESS_GAME_TREE_NONE &&
+	       tree->checkpoint_count <= tree->checkpoint_capacity && tree->checkpoint_count <= tree->node_count;
+}
+ChessGameTree chess_game_tree_new(const ChessPosition *position) {
+	return chess_game_tree_new_with_allocator(position, chess_allocator_default());
+}
+ChessGameTree chess_game_tree_new_with_allocator(const ChessPosition *position, ChessAllocator allocator) {
+	assert(chess_position_is_valid(position));
+	assert(chess_allocator_is_valid(&allocator));
+
+	return (ChessGameTree){
+		.nodes               = CHESS_NULL,
+		.node_count          = 0,
+		.node_capacity       = 0,
+		.checkpoints         = CHESS_NULL,
+		.checkpoint_count    = 0,
+		.checkpoint_capacity = 0,
+		.position            = *position,
+		.allocator           = allocator,
+	};
+}
+void chess_game_tree_drop(ChessGameTree *tree) {
+	assert(chess_game_tree_is_valid(tree));
+
+	chess_allocator_deallocate(&tree->allocator, tree->nodes, tree->node_capacity * sizeof(*tree->nodes));
+	chess_allocator_deallocate(&tree->allocator, tree->checkpoints, tree->checkpoint_capacity * sizeof(*tree->checkpoints));
+
+	tree->nodes               = CHESS_NULL;
+	tree->node_count          = 0;
+	tree->node_capacity       = 0;
+	tree->checkpoints         = CHESS_NULL;
+	tree->checkpoint_count    = 0;
+	tree->checkpoint_capacity = 0;
+}
+// Doubles the capacity of the given array, returning the new array, or `CHESS_NULL` if the allocation failed.
+static void *chess_game_tree_grow(const ChessAllocator *allocator, void *array, size_t *capacity, size_t element_size) {
+	size_t new_capacity = *capacity == 0 ? CHESS_GAME_TREE_INITIAL_CAPACITY : *capacity;
+	if (*capacity != 0) {
+		if (new_capacity > SIZE_MAX / 2 / element_size || new_capacity >= CHESS_GAME_TREE_NONE / 2) {
+			return CHESS_NULL;
+		}
+		new_capacity *= 2;
+	}
+
+	void *new_array = chess_allocator_allocate(allocator, new_capacity * element_size);
+	if (new_array == CHESS_NULL) {
+		return CHESS_NULL;
+	}
+
+	if (*capacity != 0) {
+		memcpy(new_array, array, *capacity * element_size);
+	}
+	chess_allocator_deallocate(allocator, array, *capacity * element_size);
+	*capacity = new_capacity;
+
+	return new_array;
+}
+// Rebuilds the position of the given node from the nearest node above it whose position is cached, returning the number
+// of moves replayed.
+static size_t chess_game_tree_replay(const ChessGameTree *tree, uint32_t node, ChessPosition *position) {
+	ChessMove moves[CHESS_GAME_TREE_CHECKPOINT_INTERVAL];
+	size_t move_count = 0;
+	while (node != CHESS_GAME_TREE_ROOT && tree->nodes[node].checkpoint == CHESS_GAME_TREE_NONE) {
+		assert(move_count < CHESS_GAME_TREE_CHECKPOINT_INTERVAL);
+
+		moves[move_count++] = tree->nodes[node].move;
+		node                = tree->nodes[node].parent;
+	}
+
+	*position = node == CHESS_GAME_TREE_ROOT ? tree->position : tree->checkpoints[tree->nodes[node].checkpoint];
+	for (size_t i = move_count; i > 0; i--) {
+		chess_move_do_unchecked(position, moves[i - 1]);
+	}
+
+	return move_count;
+}
+static bool chess_game_tree_is_same_move(ChessMove move_1, ChessMove move_2) {
+	return move_1.from == move_2.from && move_1.to == move_2.to && move_1.promotion_type == move_2.promotion_type;
+}
+uint32_t chess_game_tree_add_move(ChessGameTree *tree, uint32_t node, ChessMove move) {
+	assert(chess_game_tree_is_valid(tree));
+	assert(node == CHESS_GAME_TREE_ROOT || node < tree->node_count);
+	assert(chess_move_is_valid(move));
+
+	uint32_t last_child = CHESS_GAME_TREE_NONE;
+	for (uint32_t child = chess_game_tree_first_child(tree, node); child != CHESS_GAME_TREE_NONE; child = tree->nodes[child].next_sibling) {
+		if (chess_game_tree_is_same_move(tree->nodes[child].move, move)) {
+			return child;
+		}
+		last_child = child;
+	}
+
+	ChessPosition position;
+	size_t distance = chess_game_tree_replay(tree, node, &position);
+	if (!chess_move_do_if_legal(&position, move)) {
+		return CHESS_GAME_TREE_NONE;
+	}
+
+	// The root is only stored once it has a child, and room for it is made together with its first child.
+	size_t node_count = tree->node_count == 0 ? 2 : tree->node_count + 1;
+	while (tree->node_capacity < node_count) {
+		ChessGameTreeNode *nodes = chess_game_tree_grow(&tree->allocator, tree->nodes, &tree->node_capacity, sizeof(*nodes));
+		if (nodes == CHESS_NULL) {
+			return CHESS_GAME_TREE_NONE;
+		}
+		tree->nodes = nodes;
+	}
+
+	// The position of every node a whole interval of moves away from the nearest cached one is cached in turn.
+	bool is_checkpoint = distance + 1 == CHESS_GAME_TREE_CHECKPOINT_INTERVAL;
+	if (is_checkpoint && tree->checkpoint_count == tree->checkpoint_capacity) {
+		ChessPosition *checkpoints = chess_game_tree_grow(&tree->allocator, tree->checkpoints, &tree->checkpoint_capacity, sizeof(*checkpoints));
+		if (checkpoints == CHESS_NULL) {
+			return CHESS_GAME_TREE_NONE;
+		}
+		tree->checkpoints = checkpoints;
+	}
+
+	if (tree->node_count == 0) {
+		tree->nodes[CHESS_GAME_TREE_ROOT] = (ChessGameTreeNode){
+			.move         = { 0 },
+			.parent       = CHESS_GAME_TREE_NONE,
+			.first_child  = CHESS_GAME_TREE_NONE,
+			.next_sibling = CHESS_GAME_TREE_NONE,
+			.checkpoint   = CHESS_GAME_TREE_NONE,
+		};
+		tree->node_count = 1;
+	}
+
+	uint32_t child     = (uint32_t)tree->node_count++;
+	tree->nodes[child] = (ChessGameTreeNode){
+		.move         = move,
+		.parent       = node,
+		.first_child  = CHESS_GAME_TREE_NONE,
+		.next_sibling = CHESS_GAME_TREE_NONE,
+		.checkpoint   = CHESS_GAME_TREE_NONE,
+	};
+	if (is_checkpoint) {
+		tree->checkpoints[tree->checkpoint_count] = position;
+		tree->nodes[child].checkpoint             = (uint32_t)tree->checkpoint_count++;
+	}
+
+	if (last_child == CHESS_GAME_TREE_NONE) {
+		tree->nodes[node].first_child = child;
+	} else {
+		tree->nodes[last_child].next_sibling = child;
+	}
+
+	assert(chess_game_tree_is_valid(tree));
+
+	return child;
+}
+ChessPosition chess_game_tree_position(const ChessGameTree *tree, uint32_t node) {
+	assert(chess_game_tree_is_valid(tree));
+	assert(node == CHESS_GAME_TREE_ROOT || node < tree->node_count);
+
+	ChessPosition position;
+	chess_game_tree_replay(tree, node, &position);
+
+	return position;
+}
+ChessMove chess_game_tree_move(const ChessGameTree *tree, uint32_t node) {
+	assert(chess_game_tree_is_valid(tree));
+	assert(node != CHESS_GAME_TREE_ROOT && node < tree->node_count);
+
+	return tree->nodes[node].move;
+}
+uint32_t chess_game_tree_parent(const ChessGameTree *tree, uint32_t node) {
+	assert(chess_game_tree_is_valid(tree));
+	assert(node == CHESS_GAME_TREE_ROOT || node < tree->node_count);
+
+	return node == CHESS_GAME_TREE_ROOT ? CHESS_GAME_TREE_NONE : tree->nodes[node].parent;
+}
+uint32_t chess_game_tree_first_child(const ChessGameTree *tree, uint32_t node) {
+	assert(chess_game_tree_is_valid(tree));
+	assert(node == CHESS_GAME_TREE_ROOT || node < tree->node_count);
+
+	return tree->node_count == 0 ? CHESS_GAME_TREE_NONE : tree->nodes[node].first_child;
+}
+uint32_t chess_game_tree_next_sibling(const ChessGameTree *tree, uint32_t node) {
+	assert(chess_game_tree_is_valid(tree));
+	assert(node == CHESS_GAME_TREE_ROOT || node < tree->node_count);
+
+	return node == CHESS_GAME_TREE_ROOT ? CHESS_GAME_TREE_NONE : tree->nodes[node].next_sibling;
+}
+void chess_game_tree_promote_variation(ChessGameTree *tree, uint32_t node) {
+	assert(chess_game_tree_is_valid(tree));
+	assert(node == CHESS_GAME_TREE_ROOT || node < tree->node_count);
+
+	if (node == CHESS_GAME_TREE_ROOT) {
+		return;
+	}
+
+	uint32_t parent = tree->nodes[node].parent;
+	if (tree->nodes[parent].first_child == node) {
+		return;
+	}
+
+	uint32_t previous = tree->nodes[parent].first_child;
+	while (tree->nodes[previous].next_sibling != node) {
+		previous = tree->nodes[previous].next_sibling;
+	}
+	tree->nodes[previous].next_sibling = tree->nodes[node].next_sibling;
+	tree->nodes[node].next_sibling     = tree->nodes[parent].first_child;
+	tree->nodes[parent].first_child    = node;
+}
@@ -0,0 +1,72 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+	#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <chess/mapping.h>
+
+#include <chess/macros.h>
+
+#include <assert.h>
+
+#if defined(_WIN32)
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+void *chess_mapping_map(const char *path, size_t *size) {
+	assert(path != CHESS_NULL);
+	assert(size != CHESS_NULL);
+
+	void *mapping = CHESS_NULL;
+
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, CHESS_NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, CHESS_NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		return CHESS_NULL;
+	}
+
+	LARGE_INTEGER file_size;
+	if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0) {
+		HANDLE file_mapping = CreateFileMappingA(file, CHESS_NULL, PAGE_READONLY, 0, 0, CHESS_NULL);
+		if (file_mapping != CHESS_NULL) {
+			mapping = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(file_mapping);
+		}
+		*size = (size_t)file_size.QuadPart;
+	}
+
+	CloseHandle(file);
+#else
+	int file = open(path, O_RDONLY);
+	if (file == -1) {
+		return CHESS_NULL;
+	}
+
+	struct stat status;
+	if (fstat(file, &status) == 0 && status.st_size > 0) {
+		mapping = mmap(CHESS_NULL, (size_t)status.st_size, PROT_READ, MAP_SHARED, file, 0);
+		if (mapping == MAP_FAILED) {
+			mapping = CHESS_NULL;
+		}
+		*size = (size_t)status.st_size;
+	}
+
+	close(file);
+#endif
+
+	return mapping;
+}
+void chess_mapping_unmap(void *mapping, size_t size) {
+	assert(mapping != CHESS_NULL);
+
+#if defined(_WIN32)
+	(void)size;
+	UnmapViewOfFile(mapping);
+#else
+	munmap(mapping, size);
+#endif
+}
@@ -0,0 +1,17 @@
+#ifndef CHESS_MAPPING_H_INCLUDED
+#define CHESS_MAPPING_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+void *chess_mapping_map(const char *path, size_t *size);
+void chess_mapping_unmap(void *mapping, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_MAPPING_H_INCLUDED
@@ -0,0 +1,370 @@
+#include <chess/mate.h>
+
+#include <chess/color.h>
+#include <chess/move.h>
+#include <chess/move_private.h>
+#include <chess/moves.h>
+#include <chess/piece_type.h>
+#include <chess/position.h>
+#include <chess/square.h>
+
+#include <assert.h>
+#include <stdlib.h>
+
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint32_t, CHESS_MATE_INFINITY, 1U << 30U);
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_MATE_BUCKET_SIZE, 4);
+
+typedef struct ChessMateNumbers {
+	uint32_t proof;
+	uint32_t disproof;
+} ChessMateNumbers;
+
+// An entry with both numbers 0 is empty, as no node is both proven and disproven.
+typedef struct ChessMateEntry {
+	uint64_t key;
+	ChessMateNumbers numbers;
+	uint32_t work;
+	uint16_t distance;
+	ChessSquare from;
+	ChessSquare to;
+	ChessPieceType promotion_type;
+} ChessMateEntry;
+
+// The children of a node being searched, kept across the iterations over the node. The numbers of a child disproven
+// through a repetition or a line too long hold only on the current path, so they are kept here rather than stored.
+typedef struct ChessMateFrame {
+	ChessMoves moves;
+	uint64_t keys[CHESS_MOVES_MAXIMUM_COUNT];
+	ChessMateNumbers numbers[CHESS_MOVES_MAXIMUM_COUNT];
+	bool is_path_dependents[CHESS_MOVES_MAXIMUM_COUNT];
+} ChessMateFrame;
+
+typedef struct ChessMateSearch {
+	ChessMateEntry *entries;
+	size_t size;
+	ChessMateFrame *frames;
+	ChessColor attacker;
+	uint64_t nodes;
+	uint64_t maximum_nodes;
+	uint64_t path[CHESS_MATE_MAXIMUM_LENGTH];
+	size_t ply;
+	bool is_stopped;
+} ChessMateSearch;
+
+// Sums of numbers saturate below infinity, which only proven and disproven nodes reach, as transpositions are counted
+// once for each path to them and make the sums grow exponentially with depth.
+static uint32_t chess_mate_add(uint32_t a, uint32_t b) {
+	assert(a <= CHESS_MATE_INFINITY && b <= CHESS_MATE_INFINITY);
+
+	if (a == CHESS_MATE_INFINITY || b == CHESS_MATE_INFINITY) {
+		return CHESS_MATE_INFINITY;
+	}
+	return a + b >= CHESS_MATE_INFINITY - 1 ? CHESS_MATE_INFINITY - 1 : a + b;
+}
+// The numbers from the perspective of the side to move: the proof number of the attacking side is the disproof number
+// of the defending side.
+static uint32_t chess_mate_phi(ChessMateNumbers numbers, bool is_attacker) {
+	return is_attacker ? numbers.proof : numbers.disproof;
+}
+static uint32_t chess_mate_delta(ChessMateNumbers numbers, bool is_attacker) {
+	return is_attacker ? numbers.disproof : numbers.proof;
+}
+static ChessMateEntry *chess_mate_find(const ChessMateSearch *search, uint64_t key) {
+	assert(search != CHESS_NULL);
+
+	ChessMateEntry *bucket = &search->entries[(size_t)key & (search->size - CHESS_MATE_BUCKET_SIZE)];
+	for (size_t i = 0; i < CHESS_MATE_BUCKET_SIZE; i++) {
+		if (bucket[i].key == key && (bucket[i].numbers.proof != 0 || bucket[i].numbers.disproof != 0)) {
+			return &bucket[i];
+		}
+	}
+
+	return CHESS_NULL;
+}
+static void chess_mate_store(ChessMateSearch *search, uint64_t key, ChessMateNumbers numbers, uint32_t work, uint16_t distance, const ChessMove *best_move) {
+	assert(search != CHESS_NULL);
+
+	// Replaces the entry of the same node, or else the entry which took the least work to compute.
+	ChessMateEntry *bucket = &search->entries[(size_t)key & (search->size - CHESS_MATE_BUCKET_SIZE)];
+	ChessMateEntry *entry  = &bucket[0];
+	for (size_t i = 0; i < CHESS_MATE_BUCKET_SIZE; i++) {
+		if (bucket[i].key == key || (bucket[i].numbers.proof == 0 && bucket[i].numbers.disproof == 0)) {
+			entry = &bucket[i];
+			break;
+		}
+		if (bucket[i].work < entry->work) {
+			entry = &bucket[i];
+		}
+	}
+
+	*entry = (ChessMateEntry){
+		.key            = key,
+		.numbers        = numbers,
+		.work           = work,
+		.distance       = distance,
+		.from           = best_move != CHESS_NULL ? best_move->from : CHESS_SQUARE_NONE,
+		.to             = best_move != CHESS_NULL ? best_move->to : CHESS_SQUARE_NONE,
+		.promotion_type = best_move != CHESS_NULL ? best_move->promotion_type : CHESS_PIECE_TYPE_NONE,
+	};
+}
+static ChessMateNumbers chess_mate_evaluate(const ChessMateSearch *search, const ChessPosition *position, const ChessMoves *moves) {
+	assert(search != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+	assert(moves != CHESS_NULL);
+
+	// Checkmate of the defending side proves a node, any other end of the game disproves it.
+	if (chess_position_is_insufficient_material(position)) {
+		return (ChessMateNumbers){ .proof = CHESS_MATE_INFINITY, .disproof = 0 };
+	}
+	if (moves->count == 0) {
+		if (position->side_to_move != search->attacker && chess_position_is_check(position)) {
+			return (ChessMateNumbers){ .proof = 0, .disproof = CHESS_MATE_INFINITY };
+		}
+		return (ChessMateNumbers){ .proof = CHESS_MATE_INFINITY, .disproof = 0 };
+	}
+
+	if (position->side_to_move == search->attacker) {
+		return (ChessMateNumbers){ .proof = 1, .disproof = (uint32_t)moves->count };
+	}
+	return (ChessMateNumbers){ .proof = (uint32_t)moves->count, .disproof = 1 };
+}
+static uint16_t chess_mate_distance(const ChessMateSearch *search, const ChessMateFrame *frame, bool is_attacker, ChessMove *best_move) {
+	assert(search != CHESS_NULL);
+	assert(frame != CHESS_NULL);
+	assert(best_move != CHESS_NULL);
+
+	// The attacking side mates as soon as it can, the defending side resists as long as it can.
+	bool is_found     = false;
+	uint16_t distance = 0;
+	for (size_t i = 0; i < frame->moves.count; i++) {
+		if (frame->numbers[i].proof != 0) {
+			continue;
+		}
+
+		const ChessMateEntry *entry = chess_mate_find(search, frame->keys[i]);
+		uint16_t child_distance     = entry != CHESS_NULL && entry->numbers.proof == 0 ? entry->distance : 0;
+		if (!is_found || (is_attacker ? child_distance < distance : child_distance > distance)) {
+			*best_move = frame->moves.moves[i];
+			distance = child_distance;
+			is_found = true;
+		}
+	}
+
+	return (uint16_t)(distance + 1);
+}
+static ChessMateNumbers chess_mate_search_node(ChessMateSearch *search, const ChessPosition *position, uint64_t key, uint32_t phi_threshold, uint32_t delta_threshold, bool *is_path_dependent) {
+	assert(search != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+	assert(is_path_dependent != CHESS_NULL);
+
+	*is_path_dependent = false;
+
+	search->nodes++;
+	if (search->maximum_nodes != 0 && search->nodes >= search->maximum_nodes) {
+		search->is_stopped = true;
+	}
+
+	bool is_attacker      = position->side_to_move == search->attacker;
+
+	ChessMateFrame *frame = &search->frames[search->ply];
+	frame->moves          = chess_moves_generate(position);
+	if (frame->moves.count == 0) {
+		ChessMateNumbers numbers = chess_mate_evaluate(search, position, &frame->moves);
+		chess_mate_store(search, key, numbers, 1, 0, CHESS_NULL);
+		return numbers;
+	}
+
+	// Lines too long to search are escapes.
+	if (search->ply == CHESS_MATE_MAXIMUM_LENGTH - 1) {
+		*is_path_dependent = true;
+		return (ChessMateNumbers){ .proof = CHESS_MATE_INFINITY, .disproof = 0 };
+	}
+
+	search->path[search->ply] = key;
+	for (size_t i = 0; i < frame->moves.count; i++) {
+		ChessPosition child = *position;
+		chess_move_do_unchecked(&child, frame->moves.moves[i]);
+		frame->keys[i]           = chess_position_hash(&child);
+
+		// A repetition is a draw, which the defending side is glad to escape into.
+		frame->is_path_dependents[i] = false;
+		for (size_t j = 0; j <= search->ply && !frame->is_path_dependents[i]; j++) {
+			frame->is_path_dependents[i] = search->path[j] == frame->keys[i];
+		}
+
+		const ChessMateEntry *entry = chess_mate_find(search, frame->keys[i]);
+		if (frame->is_path_dependents[i]) {
+			frame->numbers[i] = (ChessMateNumbers){ .proof = CHESS_MATE_INFINITY, .disproof = 0 };
+		} else if (entry != CHESS_NULL) {
+			frame->numbers[i] = entry->numbers;
+		} else {
+			ChessMoves child_moves = chess_moves_generate(&child);
+			frame->numbers[i]      = chess_mate_evaluate(search, &child, &child_moves);
+			chess_mate_store(search, frame->keys[i], frame->numbers[i], 0, 0, CHESS_NULL);
+		}
+	}
+	search->ply++;
+
+	uint64_t start_nodes = search->nodes;
+	uint32_t phi         = 0;
+	uint32_t delta       = 0;
+	while (true) {
+		// The node is as easy for the side to move as its easiest child is for the other side, and as hard for the
+		// other side as all of its children together.
+		size_t best_index     = 0;
+		uint32_t second_delta = CHESS_MATE_INFINITY;
+		phi                   = CHESS_MATE_INFINITY;
+		delta                 = 0;
+		for (size_t i = 0; i < frame->moves.count; i++) {
+			const ChessMateEntry *entry = frame->is_path_dependents[i] ? CHESS_NULL : chess_mate_find(search, frame->keys[i]);
+			if (entry != CHESS_NULL) {
+				frame->numbers[i] = entry->numbers;
+			}
+
+			uint32_t child_phi   = chess_mate_phi(frame->numbers[i], !is_attacker);
+			uint32_t child_delta = chess_mate_delta(frame->numbers[i], !is_attacker);
+			if (child_delta < phi) {
+				second_delta = phi;
+				phi          = child_delta;
+				best_index   = i;
+			} else if (child_delta < second_delta) {
+				second_delta = child_delta;
+			}
+			delta = chess_mate_add(delta, child_phi);
+		}
+
+		if (phi >= phi_threshold || delta >= delta_threshold || search->is_stopped) {
+			break;
+		}
+
+		uint32_t best_phi              = chess_mate_phi(frame->numbers[best_index], !is_attacker);
+		uint32_t child_phi_threshold   = delta_threshold - delta + best_phi;
+		uint32_t child_delta_threshold = phi_threshold <= second_delta ? phi_threshold : second_delta + 1;
+
+		ChessPosition child            = *position;
+		chess_move_do_unchecked(&child, frame->moves.moves[best_index]);
+		frame->numbers[best_index] = chess_mate_search_node(search, &child, frame->keys[best_index], child_phi_threshold, child_delta_threshold, &frame->is_path_dependents[best_index]);
+	}
+	search->ply--;
+
+	ChessMateNumbers numbers = {
+		.proof    = is_attacker ? phi : delta,
+		.disproof = is_attacker ? delta : phi,
+	};
+
+	// A proof never goes through an escape, but a disproof may.
+	if (numbers.disproof == 0) {
+		for (size_t i = 0; i < frame->moves.count && !*is_path_dependent; i++) {
+			*is_path_dependent = frame->is_path_dependents[i];
+		}
+		if (*is_path_dependent) {
+			return numbers;
+		}
+	}
+
+	ChessMove best_move;
+	uint16_t distance = numbers.proof == 0 ? chess_mate_distance(search, frame, is_attacker, &best_move) : 0;
+	uint64_t work     = search->nodes - start_nodes + 1;
+	chess_mate_store(search, key, numbers, work > UINT32_MAX ? UINT32_MAX : (uint32_t)work, distance, numbers.proof == 0 ? &best_move : CHESS_NULL);
+
+	return numbers;
+}
+static bool chess_mate_prove(ChessMateSearch *search, const ChessPosition *position, uint64_t key) {
+	assert(search != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+
+	bool is_path_dependent;
+	ChessMateNumbers numbers = chess_mate_search_node(search, position, key, CHESS_MATE_INFINITY, CHESS_MATE_INFINITY, &is_path_dependent);
+	return numbers.proof == 0;
+}
+static void chess_mate_line(ChessMateSearch *search, const ChessPosition *root, ChessMateResult *result) {
+	assert(search != CHESS_NULL);
+	assert(chess_position_is_valid(root));
+	assert(result != CHESS_NULL);
+
+	// Follows the proof through the table, proving again the nodes whose entries were replaced since.
+	ChessPosition position = *root;
+	while (result->move_count < CHESS_MATE_MAXIMUM_LENGTH - 1) {
+		ChessMoves moves = chess_moves_generate(&position);
+		if (moves.count == 0) {
+			break;
+		}
+
+		uint64_t key                = chess_position_hash(&position);
+		search->ply                 = result->move_count;
+
+		const ChessMateEntry *entry = chess_mate_find(search, key);
+		if ((entry == CHESS_NULL || entry->numbers.proof != 0) && !chess_mate_prove(search, &position, key)) {
+			break;
+		}
+		entry = chess_mate_find(search, key);
+		if (entry == CHESS_NULL) {
+			break;
+		}
+
+		ChessMove move = moves.moves[0];
+		if (position.side_to_move == search->attacker) {
+			move = chess_move_new(&position, entry->from, entry->to, entry->promotion_type);
+		} else {
+			bool is_found     = false;
+			uint16_t distance = 0;
+			for (size_t i = 0; i < moves.count; i++) {
+				ChessPosition child = position;
+				chess_move_do_unchecked(&child, moves.moves[i]);
+
+				const ChessMateEntry *child_entry = chess_mate_find(search, chess_position_hash(&child));
+				if (child_entry != CHESS_NULL && child_entry->numbers.proof == 0 && (!is_found || child_entry->distance > distance)) {
+					move     = moves.moves[i];
+					distance = child_entry->distance;
+					is_found = true;
+				}
+			}
+		}
+
+		search->path[result->move_count]    = key;
+		result->moves[result->move_count++] = move;
+		chess_move_do_unchecked(&position, move);
+	}
+}
+ChessMateResult chess_mate_solve(const ChessPosition *position, ChessMateLimits limits) {
+	assert(chess_position_is_valid(position));
+
+	ChessMateResult result = {
+		.is_proven  = false,
+		.moves      = { { 0 } },
+		.move_count = 0,
+		.nodes      = 0,
+	};
+
+	size_t size         = CHESS_MATE_BUCKET_SIZE;
+	size_t maximum_size = limits.table_size != 0 ? limits.table_size : CHESS_MATE_DEFAULT_TABLE_SIZE;
+	while (size * 2 <= maximum_size) {
+		size *= 2;
+	}
+
+	ChessMateSearch search = {
+		.entries       = calloc(size, sizeof(ChessMateEntry)),
+		.size          = size,
+		.frames        = malloc(CHESS_MATE_MAXIMUM_LENGTH * sizeof(ChessMateFrame)),
+		.attacker      = position->side_to_move,
+		.nodes         = 0,
+		.maximum_nodes = limits.nodes,
+		.path          = { 0 },
+		.ply           = 0,
+		.is_stopped    = false,
+	};
+
+	if (search.entries != CHESS_NULL && search.frames != CHESS_NULL) {
+		result.is_proven = chess_mate_prove(&search, position, chess_position_hash(position));
+		if (result.is_proven) {
+			chess_mate_line(&search, position, &result);
+		}
+	}
+
+	result.nodes = search.nodes;
+
+	free(search.entries);
+	free(search.frames);
+
+	return result;
+}
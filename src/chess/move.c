@@ -10,13 +10,14 @@
 #include <chess/piece.h>
 #include <chess/piece_type.h>
 #include <chess/position.h>
-#include <chess/position_counter.h>
 #include <chess/position_private.h>
 #include <chess/rank.h>
 #include <chess/square.h>
+#include <chess/square_private.h>
 
 #include <assert.h>
 #include <ctype.h>
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -47,7 +48,7 @@ void chess_move_debug(ChessMove move) {
 	chess_square_debug(move.previous_en_passant_square);
 	printf(",\n");
 
-	printf("\t.previous_half_move_clock = %u,\n", move.previous_half_move_clock);
+	printf("\t.previous_half_move_clock = %" PRIu16 ",\n", move.previous_half_move_clock);
 
 	printf("}");
 }
@@ -230,19 +231,16 @@ size_t chess_move_from_algebraic(const ChessPosition *position, ChessMove *move,
 		}
 
 		if (is_check || is_checkmate) {
-			if (!chess_move_is_legal(position, *move)) {
+			if (!chess_move_is_legal(position, *move) || !chess_move_gives_check(position, *move)) {
 				return 0;
 			}
 
-			ChessPosition position_after_move = *position;
-			chess_move_do_unchecked(&position_after_move, *move);
-
-			if (is_check && !chess_position_is_check(&position_after_move)) {
-				return 0;
-			}
-
-			if (is_checkmate && !chess_position_is_checkmate(&position_after_move)) {
-				return 0;
+			if (is_checkmate) {
+				ChessPosition position_after_move = *position;
+				chess_move_do_unchecked(&position_after_move, *move);
+				if (chess_moves_generate(&position_after_move).count != 0) {
+					return 0;
+				}
 			}
 		}
 
@@ -251,6 +249,12 @@ size_t chess_move_from_algebraic(const ChessPosition *position, ChessMove *move,
 		return total_read;
 	}
 
+	// The check information is computed once for all the candidate moves, only if the suffix has to be verified.
+	ChessMoveCheckInfo info;
+	if (is_check || is_checkmate) {
+		info = chess_move_check_info_new(position);
+	}
+
 	ChessMoves moves = chess_moves_generate(position);
 	size_t matches   = 0;
 	for (size_t i = 0; i < moves.count; i++) {
@@ -278,15 +282,16 @@ size_t chess_move_from_algebraic(const ChessPosition *position, ChessMove *move,
 		}
 
 		if (is_check || is_checkmate) {
-			ChessPosition position_after_move = *position;
-			chess_move_do_unchecked(&position_after_move, moves.moves[i]);
-
-			if (is_check && !chess_position_is_check(&position_after_move)) {
+			if (!chess_move_gives_check_with_info(position, &info, moves.moves[i])) {
 				continue;
 			}
 
-			if (is_checkmate && !chess_position_is_checkmate(&position_after_move)) {
-				continue;
+			if (is_checkmate) {
+				ChessPosition position_after_move = *position;
+				chess_move_do_unchecked(&position_after_move, moves.moves[i]);
+				if (chess_moves_generate(&position_after_move).count != 0) {
+					continue;
+				}
 			}
 		}
 
@@ -370,20 +375,86 @@ size_t chess_move_to_algebraic(const ChessPosition *position, ChessMove move, ch
 		CHESS_WRITE(chess_piece_type_to_algebraic, move.promotion_type);
 	}
 
-	if (chess_move_is_legal(position, move)) {
+	// The move is only played out, to tell checkmate apart, once it is known to give check.
+	if (chess_move_is_legal(position, move) && chess_move_gives_check(position, move)) {
 		ChessPosition position_after_move = *position;
 		chess_move_do_unchecked(&position_after_move, move);
-		if (chess_position_is_check(&position_after_move)) {
-			if (chess_position_is_checkmate(&position_after_move)) {
-				CHESS_WRITE_FORMATTED("#");
-			} else {
-				CHESS_WRITE_FORMATTED("+");
-			}
+		if (chess_moves_generate(&position_after_move).count == 0) {
+			CHESS_WRITE_FORMATTED("#");
+		} else {
+			CHESS_WRITE_FORMATTED("+");
 		}
 	}
 
 	return total_written;
 }
+size_t chess_move_from_uci_unchecked(const ChessPosition *position, ChessMove *move, const char *string) {
+	assert(chess_position_is_valid(position));
+	assert(move != CHESS_NULL);
+	assert(string != CHESS_NULL);
+
+	size_t total_read = 0;
+
+	while (isspace(string[total_read])) {
+		total_read++;
+	}
+
+	ChessSquare from;
+	CHESS_READ(chess_square_from_algebraic, &from);
+	ChessSquare to;
+	CHESS_READ(chess_square_from_algebraic, &to);
+
+	ChessPieceType promotion_type = CHESS_PIECE_TYPE_NONE;
+	switch (string[total_read]) {
+		case 'n': promotion_type = CHESS_PIECE_TYPE_KNIGHT; break;
+		case 'b': promotion_type = CHESS_PIECE_TYPE_BISHOP; break;
+		case 'r': promotion_type = CHESS_PIECE_TYPE_ROOK; break;
+		case 'q': promotion_type = CHESS_PIECE_TYPE_QUEEN; break;
+		default: break;
+	}
+	if (promotion_type != CHESS_PIECE_TYPE_NONE) {
+		total_read++;
+	}
+
+	ChessPiece piece = position->board[from];
+	if (piece == CHESS_PIECE_NONE || chess_piece_color(piece) != position->side_to_move || chess_piece_type(position->board[to]) == CHESS_PIECE_TYPE_KING) {
+		return 0;
+	}
+
+	*move = chess_move_new(position, from, to, promotion_type);
+	return total_read;
+}
+size_t chess_move_from_uci(const ChessPosition *position, ChessMove *move, const char *string) {
+	assert(chess_position_is_valid(position));
+	assert(move != CHESS_NULL);
+	assert(string != CHESS_NULL);
+
+	ChessMove parsed_move;
+	size_t total_read = chess_move_from_uci_unchecked(position, &parsed_move, string);
+	if (total_read == 0 || !chess_move_is_legal(position, parsed_move)) {
+		return 0;
+	}
+
+	*move = parsed_move;
+	return total_read;
+}
+size_t chess_move_to_uci(ChessMove move, char *string, size_t string_size) {
+	assert(chess_move_is_valid(move));
+	assert((string != CHESS_NULL || string_size == 0));
+
+	size_t total_written = 0;
+
+	CHESS_WRITE(chess_square_to_algebraic, move.from);
+	CHESS_WRITE(chess_square_to_algebraic, move.to);
+
+	if (move.promotion_type != CHESS_PIECE_TYPE_NONE) {
+		char type[2];
+		chess_piece_type_to_algebraic(move.promotion_type, type, sizeof(type));
+		CHESS_WRITE_FORMATTED("%c", tolower((unsigned char)type[0]));
+	}
+
+	return total_written;
+}
 bool chess_move_is_pseudolegal(const ChessPosition *position, ChessMove move) {
 	assert(chess_position_is_valid(position));
 	assert(chess_move_is_valid(move));
@@ -395,247 +466,96 @@ bool chess_move_is_pseudolegal(const ChessPosition *position, ChessMove move) {
 	}
 
 	ChessPiece piece = position->board[move.from];
-
-	ChessColor color = chess_piece_color(piece);
-	if (color != position->side_to_move) {
+	ChessColor color = position->side_to_move;
+	if (piece == CHESS_PIECE_NONE || chess_piece_color(piece) != color) {
 		return false;
 	}
 
-	static CHESS_CONSTEXPR uint8_t moves[256] = {
-		[CHESS_OFFSET_NORTH + 0x77]                         = 1U << CHESS_PIECE_TYPE_PAWN | 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN | 1U << CHESS_PIECE_TYPE_KING,
-		[2 * CHESS_OFFSET_NORTH + 0x77]                     = 1U << CHESS_PIECE_TYPE_PAWN | 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[3 * CHESS_OFFSET_NORTH + 0x77]                     = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[4 * CHESS_OFFSET_NORTH + 0x77]                     = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[5 * CHESS_OFFSET_NORTH + 0x77]                     = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[6 * CHESS_OFFSET_NORTH + 0x77]                     = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[7 * CHESS_OFFSET_NORTH + 0x77]                     = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-
-		[CHESS_OFFSET_EAST + 0x77]                          = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN | 1U << CHESS_PIECE_TYPE_KING,
-		[2 * CHESS_OFFSET_EAST + 0x77]                      = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN | 1U << CHESS_PIECE_TYPE_KING,
-		[3 * CHESS_OFFSET_EAST + 0x77]                      = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[4 * CHESS_OFFSET_EAST + 0x77]                      = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[5 * CHESS_OFFSET_EAST + 0x77]                      = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[6 * CHESS_OFFSET_EAST + 0x77]                      = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[7 * CHESS_OFFSET_EAST + 0x77]                      = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-
-		[CHESS_OFFSET_SOUTH + 0x77]                         = 1U << CHESS_PIECE_TYPE_PAWN | 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN | 1U << CHESS_PIECE_TYPE_KING,
-		[2 * CHESS_OFFSET_SOUTH + 0x77]                     = 1U << CHESS_PIECE_TYPE_PAWN | 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[3 * CHESS_OFFSET_SOUTH + 0x77]                     = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[4 * CHESS_OFFSET_SOUTH + 0x77]                     = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[5 * CHESS_OFFSET_SOUTH + 0x77]                     = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[6 * CHESS_OFFSET_SOUTH + 0x77]                     = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[7 * CHESS_OFFSET_SOUTH + 0x77]                     = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-
-		[CHESS_OFFSET_WEST + 0x77]                          = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN | 1U << CHESS_PIECE_TYPE_KING,
-		[2 * CHESS_OFFSET_WEST + 0x77]                      = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN | 1U << CHESS_PIECE_TYPE_KING,
-		[3 * CHESS_OFFSET_WEST + 0x77]                      = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[4 * CHESS_OFFSET_WEST + 0x77]                      = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[5 * CHESS_OFFSET_WEST + 0x77]                      = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[6 * CHESS_OFFSET_WEST + 0x77]                      = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[7 * CHESS_OFFSET_WEST + 0x77]                      = 1U << CHESS_PIECE_TYPE_ROOK | 1U << CHESS_PIECE_TYPE_QUEEN,
-
-		[CHESS_OFFSET_NORTH_EAST + 0x77]                    = 1U << CHESS_PIECE_TYPE_PAWN | 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN | 1U << CHESS_PIECE_TYPE_KING,
-		[2 * CHESS_OFFSET_NORTH_EAST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[3 * CHESS_OFFSET_NORTH_EAST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[4 * CHESS_OFFSET_NORTH_EAST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[5 * CHESS_OFFSET_NORTH_EAST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[6 * CHESS_OFFSET_NORTH_EAST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[7 * CHESS_OFFSET_NORTH_EAST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-
-		[CHESS_OFFSET_SOUTH_EAST + 0x77]                    = 1U << CHESS_PIECE_TYPE_PAWN | 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN | 1U << CHESS_PIECE_TYPE_KING,
-		[2 * CHESS_OFFSET_SOUTH_EAST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[3 * CHESS_OFFSET_SOUTH_EAST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[4 * CHESS_OFFSET_SOUTH_EAST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[5 * CHESS_OFFSET_SOUTH_EAST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[6 * CHESS_OFFSET_SOUTH_EAST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[7 * CHESS_OFFSET_SOUTH_EAST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-
-		[CHESS_OFFSET_SOUTH_WEST + 0x77]                    = 1U << CHESS_PIECE_TYPE_PAWN | 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN | 1U << CHESS_PIECE_TYPE_KING,
-		[2 * CHESS_OFFSET_SOUTH_WEST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[3 * CHESS_OFFSET_SOUTH_WEST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[4 * CHESS_OFFSET_SOUTH_WEST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[5 * CHESS_OFFSET_SOUTH_WEST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[6 * CHESS_OFFSET_SOUTH_WEST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[7 * CHESS_OFFSET_SOUTH_WEST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-
-		[CHESS_OFFSET_NORTH_WEST + 0x77]                    = 1U << CHESS_PIECE_TYPE_PAWN | 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN | 1U << CHESS_PIECE_TYPE_KING,
-		[2 * CHESS_OFFSET_NORTH_WEST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[3 * CHESS_OFFSET_NORTH_WEST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[4 * CHESS_OFFSET_NORTH_WEST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[5 * CHESS_OFFSET_NORTH_WEST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[6 * CHESS_OFFSET_NORTH_WEST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-		[7 * CHESS_OFFSET_NORTH_WEST + 0x77]                = 1U << CHESS_PIECE_TYPE_BISHOP | 1U << CHESS_PIECE_TYPE_QUEEN,
-
-		[CHESS_OFFSET_WEST + 2 * CHESS_OFFSET_SOUTH + 0x77] = 1U << CHESS_PIECE_TYPE_KNIGHT,
-		[CHESS_OFFSET_EAST + 2 * CHESS_OFFSET_SOUTH + 0x77] = 1U << CHESS_PIECE_TYPE_KNIGHT,
-		[2 * CHESS_OFFSET_WEST + CHESS_OFFSET_SOUTH + 0x77] = 1U << CHESS_PIECE_TYPE_KNIGHT,
-		[2 * CHESS_OFFSET_EAST + CHESS_OFFSET_SOUTH + 0x77] = 1U << CHESS_PIECE_TYPE_KNIGHT,
-		[2 * CHESS_OFFSET_WEST + CHESS_OFFSET_NORTH + 0x77] = 1U << CHESS_PIECE_TYPE_KNIGHT,
-		[2 * CHESS_OFFSET_EAST + CHESS_OFFSET_NORTH + 0x77] = 1U << CHESS_PIECE_TYPE_KNIGHT,
-		[CHESS_OFFSET_WEST + 2 * CHESS_OFFSET_NORTH + 0x77] = 1U << CHESS_PIECE_TYPE_KNIGHT,
-		[CHESS_OFFSET_EAST + 2 * CHESS_OFFSET_NORTH + 0x77] = 1U << CHESS_PIECE_TYPE_KNIGHT,
-	};
-
+	ChessPieceType type    = chess_piece_type(piece);
+	ChessPiece target      = position->board[move.to];
 	ChessOffset difference = move.to - move.from;
 	uint8_t index          = (uint8_t)(difference + 0x77);
 
-	ChessPieceType type    = chess_piece_type(piece);
-	if (!(moves[index] & (1U << type))) {
-		return false;
-	}
+	if (type == CHESS_PIECE_TYPE_PAWN) {
+		ChessOffset direction = color == CHESS_COLOR_WHITE ? CHESS_OFFSET_NORTH : CHESS_OFFSET_SOUTH;
+		bool is_promotion     = chess_square_rank(move.to) == (color == CHESS_COLOR_WHITE ? CHESS_RANK_8 : CHESS_RANK_1);
+		if (is_promotion != (move.promotion_type != CHESS_PIECE_TYPE_NONE)) {
+			return false;
+		}
 
-	switch (type) {
-		case CHESS_PIECE_TYPE_PAWN: {
-			ChessOffset direction    = position->side_to_move == CHESS_COLOR_WHITE ? CHESS_OFFSET_NORTH : CHESS_OFFSET_SOUTH;
-			ChessRank promotion_rank = position->side_to_move == CHESS_COLOR_WHITE ? CHESS_RANK_8 : CHESS_RANK_1;
+		if (difference == direction) {
+			return target == CHESS_PIECE_NONE && move.captured_piece == CHESS_PIECE_NONE;
+		}
 
-			if (difference == direction) {
-				return position->board[move.to] == CHESS_PIECE_NONE &&
-				       !(chess_square_rank(move.to) == promotion_rank && move.promotion_type == CHESS_PIECE_TYPE_NONE);
-			}
+		if (difference == 2 * direction) {
+			ChessRank start_rank = color == CHESS_COLOR_WHITE ? CHESS_RANK_2 : CHESS_RANK_7;
+			return chess_square_rank(move.from) == start_rank && position->board[move.from + direction] == CHESS_PIECE_NONE &&
+			       target == CHESS_PIECE_NONE && move.captured_piece == CHESS_PIECE_NONE;
+		}
 
-			if (difference == 2 * direction) {
-				ChessRank start_rank = position->side_to_move == CHESS_COLOR_WHITE ? CHESS_RANK_2 : CHESS_RANK_7;
-				return chess_square_rank(move.from) == start_rank &&
-				       position->board[move.from + direction] == CHESS_PIECE_NONE &&
-				       position->board[move.to] == CHESS_PIECE_NONE;
+		if (difference == direction + CHESS_OFFSET_EAST || difference == direction + CHESS_OFFSET_WEST) {
+			if (move.to == position->en_passant_square) {
+				return move.captured_piece == position->board[move.to - direction];
 			}
+			return target != CHESS_PIECE_NONE && chess_piece_color(target) != color && move.captured_piece == target;
+		}
 
-			if (difference == direction + CHESS_OFFSET_EAST || difference == direction + CHESS_OFFSET_WEST) {
-				return move.to == position->en_passant_square ||
-				       (chess_piece_color(position->board[move.to]) == chess_color_opposite(position->side_to_move) &&
-				        !(chess_square_rank(move.to) == promotion_rank && move.promotion_type == CHESS_PIECE_TYPE_NONE));
-			}
+		return false;
+	}
 
-			return false;
-		} break;
-		case CHESS_PIECE_TYPE_KNIGHT: {
-			return chess_piece_color(position->board[move.to]) != position->side_to_move;
-		} break;
-		case CHESS_PIECE_TYPE_BISHOP:
-		case CHESS_PIECE_TYPE_ROOK:
-		case CHESS_PIECE_TYPE_QUEEN: {
-			if (chess_piece_color(position->board[move.to]) == position->side_to_move) {
-				return false;
-			}
+	// Apart from pawns, a move captures what stands on its destination, which must not be a piece of the side to move.
+	if (move.promotion_type != CHESS_PIECE_TYPE_NONE || move.captured_piece != target ||
+	    (target != CHESS_PIECE_NONE && chess_piece_color(target) == color)) {
+		return false;
+	}
 
-			static CHESS_CONSTEXPR ChessOffset directions[256] = {
-				[CHESS_OFFSET_NORTH + 0x77]          = CHESS_OFFSET_NORTH,
-				[2 * CHESS_OFFSET_NORTH + 0x77]      = CHESS_OFFSET_NORTH,
-				[3 * CHESS_OFFSET_NORTH + 0x77]      = CHESS_OFFSET_NORTH,
-				[4 * CHESS_OFFSET_NORTH + 0x77]      = CHESS_OFFSET_NORTH,
-				[5 * CHESS_OFFSET_NORTH + 0x77]      = CHESS_OFFSET_NORTH,
-				[6 * CHESS_OFFSET_NORTH + 0x77]      = CHESS_OFFSET_NORTH,
-				[7 * CHESS_OFFSET_NORTH + 0x77]      = CHESS_OFFSET_NORTH,
-
-				[CHESS_OFFSET_EAST + 0x77]           = CHESS_OFFSET_EAST,
-				[2 * CHESS_OFFSET_EAST + 0x77]       = CHESS_OFFSET_EAST,
-				[3 * CHESS_OFFSET_EAST + 0x77]       = CHESS_OFFSET_EAST,
-				[4 * CHESS_OFFSET_EAST + 0x77]       = CHESS_OFFSET_EAST,
-				[5 * CHESS_OFFSET_EAST + 0x77]       = CHESS_OFFSET_EAST,
-				[6 * CHESS_OFFSET_EAST + 0x77]       = CHESS_OFFSET_EAST,
-				[7 * CHESS_OFFSET_EAST + 0x77]       = CHESS_OFFSET_EAST,
-
-				[CHESS_OFFSET_SOUTH + 0x77]          = CHESS_OFFSET_SOUTH,
-				[2 * CHESS_OFFSET_SOUTH + 0x77]      = CHESS_OFFSET_SOUTH,
-				[3 * CHESS_OFFSET_SOUTH + 0x77]      = CHESS_OFFSET_SOUTH,
-				[4 * CHESS_OFFSET_SOUTH + 0x77]      = CHESS_OFFSET_SOUTH,
-				[5 * CHESS_OFFSET_SOUTH + 0x77]      = CHESS_OFFSET_SOUTH,
-				[6 * CHESS_OFFSET_SOUTH + 0x77]      = CHESS_OFFSET_SOUTH,
-				[7 * CHESS_OFFSET_SOUTH + 0x77]      = CHESS_OFFSET_SOUTH,
-
-				[CHESS_OFFSET_WEST + 0x77]           = CHESS_OFFSET_WEST,
-				[2 * CHESS_OFFSET_WEST + 0x77]       = CHESS_OFFSET_WEST,
-				[3 * CHESS_OFFSET_WEST + 0x77]       = CHESS_OFFSET_WEST,
-				[4 * CHESS_OFFSET_WEST + 0x77]       = CHESS_OFFSET_WEST,
-				[5 * CHESS_OFFSET_WEST + 0x77]       = CHESS_OFFSET_WEST,
-				[6 * CHESS_OFFSET_WEST + 0x77]       = CHESS_OFFSET_WEST,
-				[7 * CHESS_OFFSET_WEST + 0x77]       = CHESS_OFFSET_WEST,
-
-				[CHESS_OFFSET_NORTH_EAST + 0x77]     = CHESS_OFFSET_NORTH_EAST,
-				[2 * CHESS_OFFSET_NORTH_EAST + 0x77] = CHESS_OFFSET_NORTH_EAST,
-				[3 * CHESS_OFFSET_NORTH_EAST + 0x77] = CHESS_OFFSET_NORTH_EAST,
-				[4 * CHESS_OFFSET_NORTH_EAST + 0x77] = CHESS_OFFSET_NORTH_EAST,
-				[5 * CHESS_OFFSET_NORTH_EAST + 0x77] = CHESS_OFFSET_NORTH_EAST,
-				[6 * CHESS_OFFSET_NORTH_EAST + 0x77] = CHESS_OFFSET_NORTH_EAST,
-				[7 * CHESS_OFFSET_NORTH_EAST + 0x77] = CHESS_OFFSET_NORTH_EAST,
-
-				[CHESS_OFFSET_SOUTH_EAST + 0x77]     = CHESS_OFFSET_SOUTH_EAST,
-				[2 * CHESS_OFFSET_SOUTH_EAST + 0x77] = CHESS_OFFSET_SOUTH_EAST,
-				[3 * CHESS_OFFSET_SOUTH_EAST + 0x77] = CHESS_OFFSET_SOUTH_EAST,
-				[4 * CHESS_OFFSET_SOUTH_EAST + 0x77] = CHESS_OFFSET_SOUTH_EAST,
-				[5 * CHESS_OFFSET_SOUTH_EAST + 0x77] = CHESS_OFFSET_SOUTH_EAST,
-				[6 * CHESS_OFFSET_SOUTH_EAST + 0x77] = CHESS_OFFSET_SOUTH_EAST,
-				[7 * CHESS_OFFSET_SOUTH_EAST + 0x77] = CHESS_OFFSET_SOUTH_EAST,
-
-				[CHESS_OFFSET_SOUTH_WEST + 0x77]     = CHESS_OFFSET_SOUTH_WEST,
-				[2 * CHESS_OFFSET_SOUTH_WEST + 0x77] = CHESS_OFFSET_SOUTH_WEST,
-				[3 * CHESS_OFFSET_SOUTH_WEST + 0x77] = CHESS_OFFSET_SOUTH_WEST,
-				[4 * CHESS_OFFSET_SOUTH_WEST + 0x77] = CHESS_OFFSET_SOUTH_WEST,
-				[5 * CHESS_OFFSET_SOUTH_WEST + 0x77] = CHESS_OFFSET_SOUTH_WEST,
-				[6 * CHESS_OFFSET_SOUTH_WEST + 0x77] = CHESS_OFFSET_SOUTH_WEST,
-				[7 * CHESS_OFFSET_SOUTH_WEST + 0x77] = CHESS_OFFSET_SOUTH_WEST,
-
-				[CHESS_OFFSET_NORTH_WEST + 0x77]     = CHESS_OFFSET_NORTH_WEST,
-				[2 * CHESS_OFFSET_NORTH_WEST + 0x77] = CHESS_OFFSET_NORTH_WEST,
-				[3 * CHESS_OFFSET_NORTH_WEST + 0x77] = CHESS_OFFSET_NORTH_WEST,
-				[4 * CHESS_OFFSET_NORTH_WEST + 0x77] = CHESS_OFFSET_NORTH_WEST,
-				[5 * CHESS_OFFSET_NORTH_WEST + 0x77] = CHESS_OFFSET_NORTH_WEST,
-				[6 * CHESS_OFFSET_NORTH_WEST + 0x77] = CHESS_OFFSET_NORTH_WEST,
-				[7 * CHESS_OFFSET_NORTH_WEST + 0x77] = CHESS_OFFSET_NORTH_WEST,
-			};
-
-			ChessOffset direction = directions[index];
-			ChessSquare current   = (ChessSquare)(move.from + direction);
-			while (true) {
-				if (current == move.to) {
-					return true;
-				}
-				if (position->board[current] != CHESS_PIECE_NONE) {
-					return false;
-				}
-				current += direction;
-			}
-		} break;
-		case CHESS_PIECE_TYPE_KING: {
-			if (difference == 2 * CHESS_OFFSET_EAST) {
-				ChessCastlingRights castling_right = position->side_to_move == CHESS_COLOR_WHITE
-				                                         ? CHESS_CASTLING_RIGHTS_WHITE_KINGSIDE
-				                                         : CHESS_CASTLING_RIGHTS_BLACK_KINGSIDE;
-
-				ChessColor other_side              = chess_color_opposite(position->side_to_move);
-
-				return (position->castling_rights & castling_right) &&
-				       position->board[move.from + CHESS_OFFSET_EAST] == CHESS_PIECE_NONE &&
-				       position->board[move.from + 2 * CHESS_OFFSET_EAST] == CHESS_PIECE_NONE &&
-				       !chess_square_is_attacked(position, move.from, other_side) &&
-				       !chess_square_is_attacked(position, (ChessSquare)(move.from + CHESS_OFFSET_EAST), other_side) &&
-				       !chess_square_is_attacked(position, (ChessSquare)(move.from + 2 * CHESS_OFFSET_EAST), other_side);
-			}
+	if (type == CHESS_PIECE_TYPE_KING && (difference == 2 * CHESS_OFFSET_EAST || difference == 2 * CHESS_OFFSET_WEST)) {
+		bool is_kingside                   = difference == 2 * CHESS_OFFSET_EAST;
+		ChessOffset direction              = is_kingside ? CHESS_OFFSET_EAST : CHESS_OFFSET_WEST;
+		ChessCastlingRights castling_right = color == CHESS_COLOR_WHITE
+		                                         ? (is_kingside ? CHESS_CASTLING_RIGHTS_WHITE_KINGSIDE : CHESS_CASTLING_RIGHTS_WHITE_QUEENSIDE)
+		                                         : (is_kingside ? CHESS_CASTLING_RIGHTS_BLACK_KINGSIDE : CHESS_CASTLING_RIGHTS_BLACK_QUEENSIDE);
 
-			if (difference == 2 * CHESS_OFFSET_WEST) {
-				ChessCastlingRights castling_right = position->side_to_move == CHESS_COLOR_WHITE
-				                                         ? CHESS_CASTLING_RIGHTS_WHITE_QUEENSIDE
-				                                         : CHESS_CASTLING_RIGHTS_BLACK_QUEENSIDE;
+		ChessColor other_side              = chess_color_opposite(color);
 
-				ChessColor other_side              = chess_color_opposite(position->side_to_move);
+		return (position->castling_rights & castling_right) &&
+		       position->board[move.from + direction] == CHESS_PIECE_NONE && target == CHESS_PIECE_NONE &&
+		       (is_kingside || position->board[move.to + direction] == CHESS_PIECE_NONE) &&
+		       !chess_square_is_attacked(position, move.from, other_side) &&
+		       !chess_square_is_attacked(position, (ChessSquare)(move.from + direction), other_side) &&
+		       !chess_square_is_attacked(position, move.to, other_side);
+	}
 
-				return (position->castling_rights & castling_right) &&
-				       position->board[move.from + CHESS_OFFSET_WEST] == CHESS_PIECE_NONE &&
-				       position->board[move.from + 2 * CHESS_OFFSET_WEST] == CHESS_PIECE_NONE &&
-				       position->board[move.from + 3 * CHESS_OFFSET_WEST] == CHESS_PIECE_NONE &&
-				       !chess_square_is_attacked(position, move.from, other_side) &&
-				       !chess_square_is_attacked(position, (ChessSquare)(move.from + CHESS_OFFSET_WEST), other_side) &&
-				       !chess_square_is_attacked(position, (ChessSquare)(move.from + 2 * CHESS_OFFSET_WEST), other_side);
-			}
+	// The difference alone tells whether the piece moves that way, leaving only the squares in between of a sliding move.
+	if (!(chess_square_attacks[index] & (1U << type))) {
+		return false;
+	}
 
-			return chess_piece_color(position->board[move.to]) != position->side_to_move;
-		} break;
-		default: assert(false);
+	if (type == CHESS_PIECE_TYPE_BISHOP || type == CHESS_PIECE_TYPE_ROOK || type == CHESS_PIECE_TYPE_QUEEN) {
+		ChessOffset direction = chess_square_directions[index];
+		for (ChessSquare current = (ChessSquare)(move.from + direction); current != move.to; current += direction) {
+			if (position->board[current] != CHESS_PIECE_NONE) {
+				return false;
+			}
+		}
 	}
 
 	return true;
 }
+bool chess_move_new_if_pseudolegal(const ChessPosition *position, ChessSquare from, ChessSquare to, ChessPieceType promotion_type, ChessMove *move) {
+	assert(chess_position_is_valid(position));
+	assert(move != CHESS_NULL);
+
+	// The squares may come from a corrupted or colliding entry, so everything is checked before the move is built.
+	if (!chess_square_is_valid(from) || !chess_square_is_valid(to) ||
+	    (promotion_type != CHESS_PIECE_TYPE_NONE && (promotion_type < CHESS_PIECE_TYPE_KNIGHT || promotion_type > CHESS_PIECE_TYPE_QUEEN)) ||
+	    chess_piece_type(position->board[to]) == CHESS_PIECE_TYPE_KING) {
+		return false;
+	}
+
+	*move = chess_move_new(position, from, to, promotion_type);
+	return chess_move_is_pseudolegal(position, *move);
+}
 bool chess_move_is_legal(const ChessPosition *position, ChessMove move) {
 	assert(chess_position_is_valid(position));
 	assert(chess_move_is_valid(move));
@@ -648,6 +568,24 @@ bool chess_move_is_legal(const ChessPosition *position, ChessMove move) {
 	chess_move_do_unchecked(&position_after_move, move);
 	return !chess_position_is_king_attacked(&position_after_move, position->side_to_move);
 }
+bool chess_move_do_if_legal(ChessPosition *position, ChessMove move) {
+	assert(chess_position_is_valid(position));
+	assert(chess_move_is_valid(move));
+
+	if (!chess_move_is_pseudolegal(position, move)) {
+		return false;
+	}
+
+	// The move is made in place and taken back if it leaves the king attacked, which saves copying the position.
+	ChessColor color = position->side_to_move;
+	chess_move_do_unchecked(position, move);
+	if (chess_position_is_king_attacked(position, color)) {
+		chess_move_undo_unchecked(position, move);
+		return false;
+	}
+
+	return true;
+}
 bool chess_move_is_promotion(const ChessPosition *position, ChessMove move) {
 	assert(chess_position_is_valid(position));
 	assert(chess_move_is_valid(move));
@@ -684,6 +622,136 @@ bool chess_move_is_queenside_castling(const ChessPosition *position, ChessMove m
 
 	return chess_piece_type(position->board[move.from]) == CHESS_PIECE_TYPE_KING && move.to - move.from == 2 * CHESS_OFFSET_WEST;
 }
+ChessMoveCheckInfo chess_move_check_info_new(const ChessPosition *position) {
+	assert(chess_position_is_valid(position));
+
+	static CHESS_CONSTEXPR ChessOffset knight_offsets[] = {
+		2 * CHESS_OFFSET_NORTH + CHESS_OFFSET_EAST,
+		2 * CHESS_OFFSET_NORTH + CHESS_OFFSET_WEST,
+		2 * CHESS_OFFSET_EAST + CHESS_OFFSET_NORTH,
+		2 * CHESS_OFFSET_EAST + CHESS_OFFSET_SOUTH,
+		2 * CHESS_OFFSET_SOUTH + CHESS_OFFSET_EAST,
+		2 * CHESS_OFFSET_SOUTH + CHESS_OFFSET_WEST,
+		2 * CHESS_OFFSET_WEST + CHESS_OFFSET_NORTH,
+		2 * CHESS_OFFSET_WEST + CHESS_OFFSET_SOUTH,
+	};
+	// The first four directions are the rook's and the last four the bishop's, the queen using all of them.
+	static CHESS_CONSTEXPR ChessOffset directions[] = {
+		CHESS_OFFSET_NORTH,
+		CHESS_OFFSET_EAST,
+		CHESS_OFFSET_SOUTH,
+		CHESS_OFFSET_WEST,
+		CHESS_OFFSET_NORTH_EAST,
+		CHESS_OFFSET_SOUTH_EAST,
+		CHESS_OFFSET_SOUTH_WEST,
+		CHESS_OFFSET_NORTH_WEST,
+	};
+
+	ChessColor color        = position->side_to_move;
+	ChessMoveCheckInfo info = {
+		.king_square          = position->pieces[chess_color_opposite(color)][CHESS_PIECE_TYPE_KING][0],
+		.check_types          = { 0 },
+		.discovery_directions = { 0 },
+	};
+
+	// A pawn attacks the king from the squares diagonally in front of the king, as seen from the pawn.
+	ChessOffset pawn_direction = color == CHESS_COLOR_WHITE ? CHESS_OFFSET_NORTH : CHESS_OFFSET_SOUTH;
+	ChessSquare square         = (ChessSquare)(info.king_square - pawn_direction + CHESS_OFFSET_EAST);
+	if (chess_square_is_valid(square)) {
+		info.check_types[square] |= 1U << CHESS_PIECE_TYPE_PAWN;
+	}
+	square = (ChessSquare)(info.king_square - pawn_direction + CHESS_OFFSET_WEST);
+	if (chess_square_is_valid(square)) {
+		info.check_types[square] |= 1U << CHESS_PIECE_TYPE_PAWN;
+	}
+
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(knight_offsets); i++) {
+		square = (ChessSquare)(info.king_square + knight_offsets[i]);
+		if (chess_square_is_valid(square)) {
+			info.check_types[square] |= 1U << CHESS_PIECE_TYPE_KNIGHT;
+		}
+	}
+
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(directions); i++) {
+		uint8_t types       = (uint8_t)(1U << CHESS_PIECE_TYPE_QUEEN | 1U << (i < 4 ? CHESS_PIECE_TYPE_ROOK : CHESS_PIECE_TYPE_BISHOP));
+		ChessSquare blocker = CHESS_SQUARE_NONE;
+		square              = info.king_square;
+		while (true) {
+			square += directions[i];
+			if (!chess_square_is_valid(square)) {
+				break;
+			}
+			if (blocker == CHESS_SQUARE_NONE) {
+				info.check_types[square] |= types;
+			}
+
+			ChessPiece piece = position->board[square];
+			if (piece == CHESS_PIECE_NONE) {
+				continue;
+			}
+			if (blocker != CHESS_SQUARE_NONE) {
+				// A piece of the side to move standing alone in front of its own sliding piece uncovers it by moving away.
+				if (chess_piece_color(piece) == color && (types & (1U << chess_piece_type(piece)))) {
+					info.discovery_directions[blocker] = directions[i];
+				}
+				break;
+			}
+			if (chess_piece_color(piece) != color) {
+				break;
+			}
+			blocker = square;
+		}
+	}
+
+	return info;
+}
+bool chess_move_gives_check(const ChessPosition *position, ChessMove move) {
+	assert(chess_position_is_valid(position));
+	assert(chess_move_is_valid(move));
+
+	ChessMoveCheckInfo info = chess_move_check_info_new(position);
+	return chess_move_gives_check_with_info(position, &info, move);
+}
+bool chess_move_gives_check_with_info(const ChessPosition *position, const ChessMoveCheckInfo *info, ChessMove move) {
+	assert(chess_position_is_valid(position));
+	assert(info != CHESS_NULL);
+	assert(chess_move_is_valid(move));
+
+	// Castling and en passant move or remove a second piece, which is rare enough for the move to be played out instead.
+	if (chess_move_is_en_passant(position, move) || chess_move_is_kingside_castling(position, move) ||
+	    chess_move_is_queenside_castling(position, move)) {
+		ChessPosition position_after_move = *position;
+		chess_move_do_unchecked(&position_after_move, move);
+		return chess_position_is_check(&position_after_move);
+	}
+
+	if (move.promotion_type == CHESS_PIECE_TYPE_NONE) {
+		if (info->check_types[move.to] & (1U << chess_piece_type(position->board[move.from]))) {
+			return true;
+		}
+	} else {
+		// The promoted piece may attack the king through the square the pawn has just left, so its line is followed.
+		uint8_t index = (uint8_t)(info->king_square - move.to + 0x77);
+		if (chess_square_attacks[index] & (1U << move.promotion_type)) {
+			if (move.promotion_type == CHESS_PIECE_TYPE_KNIGHT) {
+				return true;
+			}
+
+			ChessOffset direction = chess_square_directions[index];
+			ChessSquare current   = (ChessSquare)(move.to + direction);
+			while (current != info->king_square && (current == move.from || position->board[current] == CHESS_PIECE_NONE)) {
+				current += direction;
+			}
+			if (current == info->king_square) {
+				return true;
+			}
+		}
+	}
+
+	// Moving a piece that stands between the king and a sliding piece uncovers it, unless the piece stays on the line.
+	ChessOffset direction = info->discovery_directions[move.from];
+	return direction != 0 && chess_square_directions[(uint8_t)(move.to - info->king_square + 0x77)] != direction;
+}
 void chess_move_do_unchecked(ChessPosition *position, ChessMove move) {
 	assert(chess_position_is_valid(position));
 	assert(chess_move_is_valid(move));
@@ -761,14 +829,10 @@ bool chess_move_do(ChessPosition *position, ChessMove move) {
 	assert(chess_position_is_valid(position));
 	assert(chess_move_is_valid(move));
 
-	if (!chess_move_is_legal(position, move)) {
+	if (!chess_move_do_if_legal(position, move)) {
 		return false;
 	}
 
-	chess_move_do_unchecked(position, move);
-
-	chess_position_counter_increment(&position->position_counter, position);
-
 	assert(chess_position_is_valid(position));
 
 	return true;
@@ -809,7 +873,7 @@ void chess_move_undo_unchecked(ChessPosition *position, ChessMove move) {
 		if (move.to - move.from == 2 * CHESS_OFFSET_EAST) {
 			chess_position_move_piece(position, move.to + CHESS_OFFSET_WEST, move.to + CHESS_OFFSET_EAST);
 		} else if (move.to - move.from == 2 * CHESS_OFFSET_WEST) {
-			chess_position_move_piece(position, move.to + 2 * CHESS_OFFSET_EAST, move.to + CHESS_OFFSET_WEST);
+			chess_position_move_piece(position, move.to + CHESS_OFFSET_EAST, move.to + 2 * CHESS_OFFSET_WEST);
 		}
 	}
 }
@@ -826,7 +890,5 @@ bool chess_move_undo(ChessPosition *position, ChessMove move) {
 
 	*position = position_before_move;
 
-	chess_position_counter_decrement(&position->position_counter, position);
-
 	return true;
 }
@@ -8,8 +8,17 @@ extern "C" {
 #include <chess/move.h>
 #include <chess/position.h>
 
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 202311L
+	#include <stdbool.h>
+#endif
+#include <stddef.h>
+
 void chess_move_do_unchecked(ChessPosition *position, ChessMove move);
 void chess_move_undo_unchecked(ChessPosition *position, ChessMove move);
+bool chess_move_is_pseudolegal(const ChessPosition *position, ChessMove move);
+bool chess_move_new_if_pseudolegal(const ChessPosition *position, ChessSquare from, ChessSquare to, ChessPieceType promotion_type, ChessMove *move);
+bool chess_move_do_if_legal(ChessPosition *position, ChessMove move);
+size_t chess_move_from_uci_unchecked(const ChessPosition *position, ChessMove *move, const char *string);
 
 #ifdef __cplusplus
 }
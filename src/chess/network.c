@@ -0,0 +1,439 @@
+#include <chess/network.h>
+
+#include <chess/color.h>
+#include <chess/file.h>
+#include <chess/move.h>
+#include <chess/offset.h>
+#include <chess/piece.h>
+#include <chess/piece_type.h>
+#include <chess/position.h>
+#include <chess/rank.h>
+#include <chess/square.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#define CHESS_NETWORK_HAS_X86_64
+
+	#include <immintrin.h>
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+	#define CHESS_NETWORK_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+	#define CHESS_NETWORK_TARGET_AVX2
+#endif
+
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint32_t, CHESS_NETWORK_VERSION, 1);
+// Every block of the vectorised output adds at most 2 * 255 * 32768 to a 32-bit lane, so the lanes are added up into
+// 64 bits after this many blocks, before they could overflow, whatever the weights and the hidden size.
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_NETWORK_OUTPUT_BLOCK_COUNT, 64);
+
+bool chess_network_is_valid(const ChessNetwork *network) {
+	return network != CHESS_NULL &&
+	       network->hidden_size != 0 && network->hidden_size % 16 == 0 &&
+	       network->hidden_size <= CHESS_NETWORK_MAXIMUM_HIDDEN_SIZE &&
+	       network->feature_weights != CHESS_NULL &&
+	       network->feature_biases != CHESS_NULL &&
+	       network->output_weights != CHESS_NULL &&
+	       network->instruction_set <= CHESS_NETWORK_INSTRUCTION_SET_AVX2;
+}
+static ChessNetworkInstructionSet chess_network_detect_instruction_set(void) {
+#ifdef CHESS_NETWORK_HAS_X86_64
+	#ifdef _MSC_VER
+	int registers[4] = { 0 };
+	__cpuid(registers, 0);
+	if (registers[0] >= 7) {
+		__cpuidex(registers, 1, 0);
+		bool has_os_support = (registers[2] & (1 << 27)) != 0 && (registers[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+
+		__cpuidex(registers, 7, 0);
+		if (has_os_support && (registers[1] & (1 << 5)) != 0) {
+			return CHESS_NETWORK_INSTRUCTION_SET_AVX2;
+		}
+	}
+	#else
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return CHESS_NETWORK_INSTRUCTION_SET_AVX2;
+	}
+	#endif
+
+	return CHESS_NETWORK_INSTRUCTION_SET_SSE2;
+#else
+	return CHESS_NETWORK_INSTRUCTION_SET_SCALAR;
+#endif
+}
+static bool chess_network_read_values(FILE *file, void *values, size_t value_size, size_t value_count) {
+	assert(file != CHESS_NULL);
+	assert(value_size == sizeof(int16_t) || value_size == sizeof(int32_t));
+
+	unsigned char buffer[4096];
+	size_t buffer_count = sizeof(buffer) / value_size;
+	for (size_t i = 0; i < value_count; i += buffer_count) {
+		size_t count = value_count - i < buffer_count ? value_count - i : buffer_count;
+		if (fread(buffer, value_size, count, file) != count) {
+			return false;
+		}
+
+		for (size_t j = 0; j < count; j++) {
+			uint32_t value = 0;
+			for (size_t k = 0; k < value_size; k++) {
+				value |= (uint32_t)buffer[j * value_size + k] << (8 * k);
+			}
+
+			if (value_size == sizeof(int16_t)) {
+				((int16_t *)values)[i + j] = (int16_t)(value >= 0x8000U ? (int32_t)value - 0x10000 : (int32_t)value);
+			} else {
+				((int32_t *)values)[i + j] = value >= 0x80000000U ? -(int32_t)(~value) - 1 : (int32_t)value;
+			}
+		}
+	}
+
+	return true;
+}
+bool chess_network_load(ChessNetwork *network, const char *path) {
+	assert(network != CHESS_NULL);
+	assert(path != CHESS_NULL);
+
+	FILE *file = fopen(path, "rb");
+	if (file == CHESS_NULL) {
+		return false;
+	}
+
+	char magic[4]       = { 0 };
+	int32_t header[2]   = { 0 };
+	ChessNetwork loaded = {
+		.hidden_size     = 0,
+		.feature_weights = CHESS_NULL,
+		.feature_biases  = CHESS_NULL,
+		.output_weights  = CHESS_NULL,
+		.output_bias     = 0,
+		.instruction_set = chess_network_detect_instruction_set(),
+	};
+
+	bool is_successful = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+	                     memcmp(magic, "CHNN", sizeof(magic)) == 0 &&
+	                     chess_network_read_values(file, header, sizeof(header[0]), CHESS_ARRAY_LENGTH(header)) &&
+	                     (uint32_t)header[0] == CHESS_NETWORK_VERSION &&
+	                     header[1] > 0 && header[1] % 16 == 0 && (size_t)header[1] <= CHESS_NETWORK_MAXIMUM_HIDDEN_SIZE;
+
+	if (is_successful) {
+		loaded.hidden_size     = (size_t)header[1];
+		loaded.feature_weights = malloc(CHESS_NETWORK_FEATURE_COUNT * loaded.hidden_size * sizeof(loaded.feature_weights[0]));
+		loaded.feature_biases  = malloc(loaded.hidden_size * sizeof(loaded.feature_biases[0]));
+		loaded.output_weights  = malloc(2 * loaded.hidden_size * sizeof(loaded.output_weights[0]));
+	}
+
+	is_successful = is_successful &&
+	                loaded.feature_weights != CHESS_NULL &&
+	                loaded.feature_biases != CHESS_NULL &&
+	                loaded.output_weights != CHESS_NULL &&
+	                chess_network_read_values(file, loaded.feature_weights, sizeof(int16_t), CHESS_NETWORK_FEATURE_COUNT * loaded.hidden_size) &&
+	                chess_network_read_values(file, loaded.feature_biases, sizeof(int16_t), loaded.hidden_size) &&
+	                chess_network_read_values(file, loaded.output_weights, sizeof(int16_t), 2 * loaded.hidden_size) &&
+	                chess_network_read_values(file, &loaded.output_bias, sizeof(int32_t), 1) &&
+	                fgetc(file) == EOF;
+
+	fclose(file);
+
+	if (!is_successful) {
+		free(loaded.feature_weights);
+		free(loaded.feature_biases);
+		free(loaded.output_weights);
+		return false;
+	}
+
+	*network = loaded;
+
+	assert(chess_network_is_valid(network));
+
+	return true;
+}
+void chess_network_drop(ChessNetwork *network) {
+	assert(chess_network_is_valid(network));
+
+	free(network->feature_weights);
+	free(network->feature_biases);
+	free(network->output_weights);
+
+	network->hidden_size     = 0;
+	network->feature_weights = CHESS_NULL;
+	network->feature_biases  = CHESS_NULL;
+	network->output_weights  = CHESS_NULL;
+}
+size_t chess_network_accumulator_size(const ChessNetwork *network) {
+	assert(chess_network_is_valid(network));
+
+	return 2 * network->hidden_size;
+}
+static const int16_t *chess_network_feature_weights(const ChessNetwork *network, ChessColor perspective, ChessPiece piece, ChessSquare square) {
+	assert(chess_network_is_valid(network));
+	assert(chess_color_is_valid(perspective));
+	assert(chess_piece_is_valid(piece));
+	assert(chess_square_is_valid(square));
+
+	ChessFile file = chess_square_file(square);
+	ChessRank rank = chess_square_rank(square);
+	if (perspective == CHESS_COLOR_BLACK) {
+		rank = CHESS_RANK_8 - rank;
+	}
+
+	size_t feature = (chess_piece_color(piece) == perspective ? 0 : CHESS_PIECE_TYPE_KING + 1);
+	feature        = (feature + chess_piece_type(piece)) * 64 + (size_t)rank * 8 + (size_t)file;
+
+	return network->feature_weights + feature * network->hidden_size;
+}
+static void chess_network_accumulate_scalar(
+    int16_t *output,
+    const int16_t *input,
+    const int16_t *const *added,
+    size_t added_count,
+    const int16_t *const *removed,
+    size_t removed_count,
+    size_t size
+) {
+	for (size_t i = 0; i < size; i++) {
+		int32_t value = input[i];
+		for (size_t j = 0; j < added_count; j++) {
+			value += added[j][i];
+		}
+		for (size_t j = 0; j < removed_count; j++) {
+			value -= removed[j][i];
+		}
+		output[i] = (int16_t)value;
+	}
+}
+static int64_t chess_network_output_scalar(const int16_t *us, const int16_t *them, const int16_t *weights, size_t size) {
+	int64_t output = 0;
+	for (size_t i = 0; i < size; i++) {
+		int32_t value = us[i] < 0 ? 0 : us[i] > CHESS_NETWORK_HIDDEN_QUANTISATION ? CHESS_NETWORK_HIDDEN_QUANTISATION : us[i];
+		output += (int64_t)value * weights[i];
+	}
+	for (size_t i = 0; i < size; i++) {
+		int32_t value = them[i] < 0 ? 0 : them[i] > CHESS_NETWORK_HIDDEN_QUANTISATION ? CHESS_NETWORK_HIDDEN_QUANTISATION : them[i];
+		output += (int64_t)value * weights[size + i];
+	}
+
+	return output;
+}
+#ifdef CHESS_NETWORK_HAS_X86_64
+static void chess_network_accumulate_sse2(
+    int16_t *output,
+    const int16_t *input,
+    const int16_t *const *added,
+    size_t added_count,
+    const int16_t *const *removed,
+    size_t removed_count,
+    size_t size
+) {
+	for (size_t i = 0; i < size; i += 8) {
+		__m128i value = _mm_loadu_si128((const __m128i *)(input + i));
+		for (size_t j = 0; j < added_count; j++) {
+			value = _mm_add_epi16(value, _mm_loadu_si128((const __m128i *)(added[j] + i)));
+		}
+		for (size_t j = 0; j < removed_count; j++) {
+			value = _mm_sub_epi16(value, _mm_loadu_si128((const __m128i *)(removed[j] + i)));
+		}
+		_mm_storeu_si128((__m128i *)(output + i), value);
+	}
+}
+static int64_t chess_network_output_half_sse2(const int16_t *values, const int16_t *weights, size_t size) {
+	const __m128i minimum = _mm_setzero_si128();
+	const __m128i maximum = _mm_set1_epi16((int16_t)CHESS_NETWORK_HIDDEN_QUANTISATION);
+
+	int64_t output        = 0;
+	for (size_t i = 0; i < size;) {
+		size_t end  = size - i > 8 * CHESS_NETWORK_OUTPUT_BLOCK_COUNT ? i + 8 * CHESS_NETWORK_OUTPUT_BLOCK_COUNT : size;
+
+		__m128i sum = _mm_setzero_si128();
+		for (; i < end; i += 8) {
+			__m128i value = _mm_min_epi16(_mm_max_epi16(_mm_loadu_si128((const __m128i *)(values + i)), minimum), maximum);
+			sum           = _mm_add_epi32(sum, _mm_madd_epi16(value, _mm_loadu_si128((const __m128i *)(weights + i))));
+		}
+
+		int32_t sums[4];
+		_mm_storeu_si128((__m128i *)sums, sum);
+		output += (int64_t)sums[0] + sums[1] + sums[2] + sums[3];
+	}
+
+	return output;
+}
+static int64_t chess_network_output_sse2(const int16_t *us, const int16_t *them, const int16_t *weights, size_t size) {
+	return chess_network_output_half_sse2(us, weights, size) + chess_network_output_half_sse2(them, weights + size, size);
+}
+CHESS_NETWORK_TARGET_AVX2 static void chess_network_accumulate_avx2(
+    int16_t *output,
+    const int16_t *input,
+    const int16_t *const *added,
+    size_t added_count,
+    const int16_t *const *removed,
+    size_t removed_count,
+    size_t size
+) {
+	for (size_t i = 0; i < size; i += 16) {
+		__m256i value = _mm256_loadu_si256((const __m256i *)(input + i));
+		for (size_t j = 0; j < added_count; j++) {
+			value = _mm256_add_epi16(value, _mm256_loadu_si256((const __m256i *)(added[j] + i)));
+		}
+		for (size_t j = 0; j < removed_count; j++) {
+			value = _mm256_sub_epi16(value, _mm256_loadu_si256((const __m256i *)(removed[j] + i)));
+		}
+		_mm256_storeu_si256((__m256i *)(output + i), value);
+	}
+}
+CHESS_NETWORK_TARGET_AVX2 static int64_t chess_network_output_half_avx2(const int16_t *values, const int16_t *weights, size_t size) {
+	const __m256i minimum = _mm256_setzero_si256();
+	const __m256i maximum = _mm256_set1_epi16((int16_t)CHESS_NETWORK_HIDDEN_QUANTISATION);
+
+	int64_t output        = 0;
+	for (size_t i = 0; i < size;) {
+		size_t end  = size - i > 16 * CHESS_NETWORK_OUTPUT_BLOCK_COUNT ? i + 16 * CHESS_NETWORK_OUTPUT_BLOCK_COUNT : size;
+
+		__m256i sum = _mm256_setzero_si256();
+		for (; i < end; i += 16) {
+			__m256i value = _mm256_min_epi16(_mm256_max_epi16(_mm256_loadu_si256((const __m256i *)(values + i)), minimum), maximum);
+			sum           = _mm256_add_epi32(sum, _mm256_madd_epi16(value, _mm256_loadu_si256((const __m256i *)(weights + i))));
+		}
+
+		int32_t sums[8];
+		_mm256_storeu_si256((__m256i *)sums, sum);
+		output += (int64_t)sums[0] + sums[1] + sums[2] + sums[3] + sums[4] + sums[5] + sums[6] + sums[7];
+	}
+
+	return output;
+}
+CHESS_NETWORK_TARGET_AVX2 static int64_t chess_network_output_avx2(const int16_t *us, const int16_t *them, const int16_t *weights, size_t size) {
+	return chess_network_output_half_avx2(us, weights, size) + chess_network_output_half_avx2(them, weights + size, size);
+}
+#endif
+static void chess_network_accumulate(
+    const ChessNetwork *network,
+    int16_t *output,
+    const int16_t *input,
+    const int16_t *const *added,
+    size_t added_count,
+    const int16_t *const *removed,
+    size_t removed_count
+) {
+	assert(chess_network_is_valid(network));
+	assert(output != CHESS_NULL && input != CHESS_NULL);
+	assert(added != CHESS_NULL || added_count == 0);
+	assert(removed != CHESS_NULL || removed_count == 0);
+
+	switch (network->instruction_set) {
+#ifdef CHESS_NETWORK_HAS_X86_64
+		case CHESS_NETWORK_INSTRUCTION_SET_AVX2: {
+			chess_network_accumulate_avx2(output, input, added, added_count, removed, removed_count, network->hidden_size);
+		} break;
+		case CHESS_NETWORK_INSTRUCTION_SET_SSE2: {
+			chess_network_accumulate_sse2(output, input, added, added_count, removed, removed_count, network->hidden_size);
+		} break;
+#endif
+		default: {
+			chess_network_accumulate_scalar(output, input, added, added_count, removed, removed_count, network->hidden_size);
+		} break;
+	}
+}
+void chess_network_accumulator_refresh(const ChessNetwork *network, const ChessPosition *position, int16_t *accumulator) {
+	assert(chess_network_is_valid(network));
+	assert(chess_position_is_valid(position));
+	assert(accumulator != CHESS_NULL);
+
+	for (ChessColor perspective = CHESS_COLOR_WHITE; perspective <= CHESS_COLOR_BLACK; perspective++) {
+		const int16_t *added[32] = { 0 };
+		size_t added_count       = 0;
+
+		for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
+			for (ChessPieceType type = CHESS_PIECE_TYPE_PAWN; type <= CHESS_PIECE_TYPE_KING; type++) {
+				for (size_t i = 0; i < position->piece_counts[color][type] && added_count < CHESS_ARRAY_LENGTH(added); i++) {
+					added[added_count++] = chess_network_feature_weights(network, perspective, chess_piece_new(color, type), position->pieces[color][type][i]);
+				}
+			}
+		}
+
+		chess_network_accumulate(network, accumulator + perspective * network->hidden_size, network->feature_biases, added, added_count, CHESS_NULL, 0);
+	}
+}
+void chess_network_accumulator_update(
+    const ChessNetwork *network,
+    const ChessPosition *position,
+    ChessMove move,
+    const int16_t *accumulator,
+    int16_t *accumulator_after_move
+) {
+	assert(chess_network_is_valid(network));
+	assert(chess_position_is_valid(position));
+	assert(chess_move_is_valid(move));
+	assert(accumulator != CHESS_NULL && accumulator_after_move != CHESS_NULL);
+
+	ChessPiece piece          = position->board[move.from];
+	ChessPiece promoted_piece = move.promotion_type != CHESS_PIECE_TYPE_NONE ? chess_piece_new(position->side_to_move, move.promotion_type) : piece;
+
+	for (ChessColor perspective = CHESS_COLOR_WHITE; perspective <= CHESS_COLOR_BLACK; perspective++) {
+		const int16_t *added[2]   = { 0 };
+		const int16_t *removed[2] = { 0 };
+		size_t added_count        = 0;
+		size_t removed_count      = 0;
+
+		removed[removed_count++]  = chess_network_feature_weights(network, perspective, piece, move.from);
+		added[added_count++]      = chess_network_feature_weights(network, perspective, promoted_piece, move.to);
+
+		if (move.captured_piece != CHESS_PIECE_NONE) {
+			ChessSquare captured_square = move.to;
+			if (chess_piece_type(piece) == CHESS_PIECE_TYPE_PAWN && move.to == position->en_passant_square) {
+				captured_square = (ChessSquare)(move.to - (position->side_to_move == CHESS_COLOR_WHITE ? CHESS_OFFSET_NORTH : CHESS_OFFSET_SOUTH));
+			}
+			removed[removed_count++] = chess_network_feature_weights(network, perspective, move.captured_piece, captured_square);
+		} else if (chess_piece_type(piece) == CHESS_PIECE_TYPE_KING && move.to - move.from == 2 * CHESS_OFFSET_EAST) {
+			ChessPiece rook          = chess_piece_new(position->side_to_move, CHESS_PIECE_TYPE_ROOK);
+			removed[removed_count++] = chess_network_feature_weights(network, perspective, rook, (ChessSquare)(move.to + CHESS_OFFSET_EAST));
+			added[added_count++]     = chess_network_feature_weights(network, perspective, rook, (ChessSquare)(move.to + CHESS_OFFSET_WEST));
+		} else if (chess_piece_type(piece) == CHESS_PIECE_TYPE_KING && move.to - move.from == 2 * CHESS_OFFSET_WEST) {
+			ChessPiece rook          = chess_piece_new(position->side_to_move, CHESS_PIECE_TYPE_ROOK);
+			removed[removed_count++] = chess_network_feature_weights(network, perspective, rook, (ChessSquare)(move.to + 2 * CHESS_OFFSET_WEST));
+			added[added_count++]     = chess_network_feature_weights(network, perspective, rook, (ChessSquare)(move.to + CHESS_OFFSET_EAST));
+		}
+
+		size_t offset = perspective * network->hidden_size;
+		chess_network_accumulate(network, accumulator_after_move + offset, accumulator + offset, added, added_count, removed, removed_count);
+	}
+}
+ChessScore chess_network_evaluate(const ChessNetwork *network, const int16_t *accumulator, ChessColor side_to_move) {
+	assert(chess_network_is_valid(network));
+	assert(accumulator != CHESS_NULL);
+	assert(chess_color_is_valid(side_to_move));
+
+	const int16_t *us   = accumulator + side_to_move * network->hidden_size;
+	const int16_t *them = accumulator + chess_color_opposite(side_to_move) * network->hidden_size;
+
+	int64_t output      = 0;
+	switch (network->instruction_set) {
+#ifdef CHESS_NETWORK_HAS_X86_64
+		case CHESS_NETWORK_INSTRUCTION_SET_AVX2: {
+			output = chess_network_output_avx2(us, them, network->output_weights, network->hidden_size);
+		} break;
+		case CHESS_NETWORK_INSTRUCTION_SET_SSE2: {
+			output = chess_network_output_sse2(us, them, network->output_weights, network->hidden_size);
+		} break;
+#endif
+		default: {
+			output = chess_network_output_scalar(us, them, network->output_weights, network->hidden_size);
+		} break;
+	}
+
+	output = (output + network->output_bias) * CHESS_NETWORK_OUTPUT_SCALE / (CHESS_NETWORK_HIDDEN_QUANTISATION * CHESS_NETWORK_OUTPUT_QUANTISATION);
+	if (output >= CHESS_SCORE_MATE_BOUND) {
+		output = CHESS_SCORE_MATE_BOUND - 1;
+	} else if (output <= -CHESS_SCORE_MATE_BOUND) {
+		output = -CHESS_SCORE_MATE_BOUND + 1;
+	}
+
+	return (ChessScore)output;
+}
@@ -0,0 +1,117 @@
+#include <chess/pawn_table.h>
+
+#include <chess/color.h>
+#include <chess/file.h>
+#include <chess/offset.h>
+#include <chess/piece_type.h>
+#include <chess/position.h>
+#include <chess/square.h>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool chess_pawn_table_is_valid(const ChessPawnTable *table) {
+	assert(table != CHESS_NULL);
+
+	if (table->entries == CHESS_NULL) {
+		return table->size == 0;
+	}
+
+	return table->size != 0 && (table->size & (table->size - 1)) == 0;
+}
+ChessPawnTable chess_pawn_table_new(size_t size) {
+	while ((size & (size - 1)) != 0) {
+		size &= size - 1;
+	}
+
+	ChessPawnTableEntry *entries = size != 0 ? calloc(size, sizeof(*entries)) : CHESS_NULL;
+
+	return (ChessPawnTable){
+		.entries = entries,
+		.size    = entries != CHESS_NULL ? size : 0,
+	};
+}
+void chess_pawn_table_drop(ChessPawnTable *table) {
+	assert(chess_pawn_table_is_valid(table));
+
+	free(table->entries);
+
+	table->entries = CHESS_NULL;
+	table->size    = 0;
+}
+void chess_pawn_table_clear(ChessPawnTable *table) {
+	assert(chess_pawn_table_is_valid(table));
+
+	if (table->entries != CHESS_NULL) {
+		memset(table->entries, 0, table->size * sizeof(table->entries[0]));
+	}
+}
+static ChessPawnTableEntry chess_pawn_table_entry_compute(const ChessPosition *position) {
+	assert(chess_position_is_valid(position));
+
+	static CHESS_CONSTEXPR ChessScore weak_pawn_penalty                    = 50;
+
+	unsigned int pawn_file_counts[CHESS_COLOR_BLACK + 1][CHESS_FILE_H + 1] = { 0 };
+	unsigned int weak_pawns[CHESS_COLOR_BLACK + 1]                         = { 0 };
+
+	ChessPawnTableEntry entry                                              = {
+		.key   = position->pawn_hash,
+		.score = 0,
+		.files = { 0 },
+	};
+
+	for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
+		for (size_t i = 0; i < position->piece_counts[color][CHESS_PIECE_TYPE_PAWN]; i++) {
+			ChessSquare square = position->pieces[color][CHESS_PIECE_TYPE_PAWN][i];
+
+			ChessFile file     = chess_square_file(square);
+			pawn_file_counts[color][file]++;
+			entry.files[color] |= (uint8_t)(1U << file);
+
+			// Only a pawn counts as blocking, since the entry is keyed by the pawns alone and must not depend on the other
+			// pieces.
+			ChessOffset direction = color == CHESS_COLOR_WHITE ? CHESS_OFFSET_NORTH : CHESS_OFFSET_SOUTH;
+			if (chess_square_is_valid(square + direction) &&
+			    chess_piece_type(position->board[square + direction]) == CHESS_PIECE_TYPE_PAWN) {
+				weak_pawns[color]++;
+			}
+		}
+	}
+
+	for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
+		for (ChessFile file = CHESS_FILE_A; file <= CHESS_FILE_H; file++) {
+			if (pawn_file_counts[color][file] == 0) {
+				continue;
+			}
+
+			weak_pawns[color] += pawn_file_counts[color][file] - 1;
+
+			if (!(file > CHESS_FILE_A && pawn_file_counts[color][file - 1] > 0) && !(file < CHESS_FILE_H && pawn_file_counts[color][file + 1] > 0)) {
+				weak_pawns[color] += pawn_file_counts[color][file];
+			}
+		}
+	}
+
+	entry.score -= weak_pawn_penalty * (ChessScore)weak_pawns[CHESS_COLOR_WHITE];
+	entry.score += weak_pawn_penalty * (ChessScore)weak_pawns[CHESS_COLOR_BLACK];
+
+	return entry;
+}
+ChessPawnTableEntry chess_pawn_table_probe(ChessPawnTable *table, const ChessPosition *position) {
+	assert(table == CHESS_NULL || chess_pawn_table_is_valid(table));
+	assert(chess_position_is_valid(position));
+
+	if (table == CHESS_NULL || table->entries == CHESS_NULL) {
+		return chess_pawn_table_entry_compute(position);
+	}
+
+	// Cleared entries have a key of 0, which is also the pawn hash of a position without pawns, and a score and file
+	// masks of 0, which is exactly the entry of such a position.
+	ChessPawnTableEntry *entry = &table->entries[position->pawn_hash & (table->size - 1)];
+	if (entry->key != position->pawn_hash) {
+		*entry = chess_pawn_table_entry_compute(position);
+	}
+
+	return *entry;
+}
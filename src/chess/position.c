@@ -4,20 +4,232 @@
 #include <chess/castling_rights.h>
 #include <chess/color.h>
 #include <chess/macros_private.h>
+#include <chess/move.h>
+#include <chess/move_private.h>
 #include <chess/moves.h>
 #include <chess/offset.h>
 #include <chess/piece.h>
-#include <chess/position_counter.h>
 #include <chess/square.h>
+#include <chess/zobrist.h>
 
 #include <assert.h>
 #include <ctype.h>
 #include <errno.h>
 #include <inttypes.h>
-#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
+// The index of a square of the 0x88 board on a board of 64 squares, that is `rank * 8 + file`.
+#define CHESS_POSITION_SQUARE_INDEX(square) (((size_t)(square) + ((size_t)(square) & 7U)) >> 1U)
+
+typedef enum ChessGamePhase {
+	CHESS_GAME_PHASE_MIDGAME,
+	CHESS_GAME_PHASE_ENDGAME,
+} ChessGamePhase;
+
+static CHESS_CONSTEXPR ChessScore chess_piece_values[CHESS_GAME_PHASE_ENDGAME + 1][CHESS_PIECE_TYPE_KING + 1] = {
+	[CHESS_GAME_PHASE_MIDGAME] = {
+	    [CHESS_PIECE_TYPE_PAWN]   = 100,
+	    [CHESS_PIECE_TYPE_KNIGHT] = 300,
+	    [CHESS_PIECE_TYPE_BISHOP] = 300,
+	    [CHESS_PIECE_TYPE_ROOK]   = 500,
+	    [CHESS_PIECE_TYPE_QUEEN]  = 900,
+	    [CHESS_PIECE_TYPE_KING]   = 0,
+	},
+	[CHESS_GAME_PHASE_ENDGAME] = {
+	    [CHESS_PIECE_TYPE_PAWN]   = 120,
+	    [CHESS_PIECE_TYPE_KNIGHT] = 290,
+	    [CHESS_PIECE_TYPE_BISHOP] = 310,
+	    [CHESS_PIECE_TYPE_ROOK]   = 520,
+	    [CHESS_PIECE_TYPE_QUEEN]  = 920,
+	    [CHESS_PIECE_TYPE_KING]   = 0,
+	},
+};
+
+// The tables are laid out as seen from White's side of the board, with the eighth rank first.
+static CHESS_CONSTEXPR ChessScore chess_piece_square_values[CHESS_GAME_PHASE_ENDGAME + 1][CHESS_PIECE_TYPE_KING + 1][64] = {
+	[CHESS_GAME_PHASE_MIDGAME] = {
+	    [CHESS_PIECE_TYPE_PAWN] = {
+	        0, 0, 0, 0, 0, 0, 0, 0,
+	        50, 50, 50, 50, 50, 50, 50, 50,
+	        10, 10, 20, 30, 30, 20, 10, 10,
+	        5, 5, 10, 25, 25, 10, 5, 5,
+	        0, 0, 0, 20, 20, 0, 0, 0,
+	        5, -5, -10, 0, 0, -10, -5, 5,
+	        5, 10, 10, -20, -20, 10, 10, 5,
+	        0, 0, 0, 0, 0, 0, 0, 0,
+	    },
+	    [CHESS_PIECE_TYPE_KNIGHT] = {
+	        -50, -40, -30, -30, -30, -30, -40, -50,
+	        -40, -20, 0, 0, 0, 0, -20, -40,
+	        -30, 0, 10, 15, 15, 10, 0, -30,
+	        -30, 5, 15, 20, 20, 15, 5, -30,
+	        -30, 0, 15, 20, 20, 15, 0, -30,
+	        -30, 5, 10, 15, 15, 10, 5, -30,
+	        -40, -20, 0, 5, 5, 0, -20, -40,
+	        -50, -40, -30, -30, -30, -30, -40, -50,
+	    },
+	    [CHESS_PIECE_TYPE_BISHOP] = {
+	        -20, -10, -10, -10, -10, -10, -10, -20,
+	        -10, 0, 0, 0, 0, 0, 0, -10,
+	        -10, 0, 5, 10, 10, 5, 0, -10,
+	        -10, 5, 5, 10, 10, 5, 5, -10,
+	        -10, 0, 10, 10, 10, 10, 0, -10,
+	        -10, 10, 10, 10, 10, 10, 10, -10,
+	        -10, 5, 0, 0, 0, 0, 5, -10,
+	        -20, -10, -10, -10, -10, -10, -10, -20,
+	    },
+	    [CHESS_PIECE_TYPE_ROOK] = {
+	        0, 0, 0, 0, 0, 0, 0, 0,
+	        5, 10, 10, 10, 10, 10, 10, 5,
+	        -5, 0, 0, 0, 0, 0, 0, -5,
+	        -5, 0, 0, 0, 0, 0, 0, -5,
+	        -5, 0, 0, 0, 0, 0, 0, -5,
+	        -5, 0, 0, 0, 0, 0, 0, -5,
+	        -5, 0, 0, 0, 0, 0, 0, -5,
+	        0, 0, 0, 5, 5, 0, 0, 0,
+	    },
+	    [CHESS_PIECE_TYPE_QUEEN] = {
+	        -20, -10, -10, -5, -5, -10, -10, -20,
+	        -10, 0, 0, 0, 0, 0, 0, -10,
+	        -10, 0, 5, 5, 5, 5, 0, -10,
+	        -5, 0, 5, 5, 5, 5, 0, -5,
+	        0, 0, 5, 5, 5, 5, 0, -5,
+	        -10, 5, 5, 5, 5, 5, 0, -10,
+	        -10, 0, 5, 0, 0, 0, 0, -10,
+	        -20, -10, -10, -5, -5, -10, -10, -20,
+	    },
+	    [CHESS_PIECE_TYPE_KING] = {
+	        -30, -40, -40, -50, -50, -40, -40, -30,
+	        -30, -40, -40, -50, -50, -40, -40, -30,
+	        -30, -40, -40, -50, -50, -40, -40, -30,
+	        -30, -40, -40, -50, -50, -40, -40, -30,
+	        -20, -30, -30, -40, -40, -30, -30, -20,
+	        -10, -20, -20, -20, -20, -20, -20, -10,
+	        20, 20, 0, 0, 0, 0, 20, 20,
+	        20, 30, 10, 0, 0, 10, 30, 20,
+	    },
+	},
+	[CHESS_GAME_PHASE_ENDGAME] = {
+	    [CHESS_PIECE_TYPE_PAWN] = {
+	        0, 0, 0, 0, 0, 0, 0, 0,
+	        80, 80, 80, 80, 80, 80, 80, 80,
+	        50, 50, 50, 50, 50, 50, 50, 50,
+	        30, 30, 30, 30, 30, 30, 30, 30,
+	        15, 15, 15, 15, 15, 15, 15, 15,
+	        5, 5, 5, 5, 5, 5, 5, 5,
+	        0, 0, 0, 0, 0, 0, 0, 0,
+	        0, 0, 0, 0, 0, 0, 0, 0,
+	    },
+	    [CHESS_PIECE_TYPE_KNIGHT] = {
+	        -50, -40, -30, -30, -30, -30, -40, -50,
+	        -40, -20, 0, 0, 0, 0, -20, -40,
+	        -30, 0, 10, 15, 15, 10, 0, -30,
+	        -30, 5, 15, 20, 20, 15, 5, -30,
+	        -30, 0, 15, 20, 20, 15, 0, -30,
+	        -30, 5, 10, 15, 15, 10, 5, -30,
+	        -40, -20, 0, 5, 5, 0, -20, -40,
+	        -50, -40, -30, -30, -30, -30, -40, -50,
+	    },
+	    [CHESS_PIECE_TYPE_BISHOP] = {
+	        -20, -10, -10, -10, -10, -10, -10, -20,
+	        -10, 0, 0, 0, 0, 0, 0, -10,
+	        -10, 0, 5, 10, 10, 5, 0, -10,
+	        -10, 5, 5, 10, 10, 5, 5, -10,
+	        -10, 0, 10, 10, 10, 10, 0, -10,
+	        -10, 10, 10, 10, 10, 10, 10, -10,
+	        -10, 5, 0, 0, 0, 0, 5, -10,
+	        -20, -10, -10, -10, -10, -10, -10, -20,
+	    },
+	    [CHESS_PIECE_TYPE_ROOK] = {
+	        0, 0, 0, 0, 0, 0, 0, 0,
+	        5, 10, 10, 10, 10, 10, 10, 5,
+	        0, 0, 0, 0, 0, 0, 0, 0,
+	        0, 0, 0, 0, 0, 0, 0, 0,
+	        0, 0, 0, 0, 0, 0, 0, 0,
+	        0, 0, 0, 0, 0, 0, 0, 0,
+	        0, 0, 0, 0, 0, 0, 0, 0,
+	        0, 0, 0, 0, 0, 0, 0, 0,
+	    },
+	    [CHESS_PIECE_TYPE_QUEEN] = {
+	        -20, -10, -10, -5, -5, -10, -10, -20,
+	        -10, 0, 0, 0, 0, 0, 0, -10,
+	        -10, 0, 5, 5, 5, 5, 0, -10,
+	        -5, 0, 5, 5, 5, 5, 0, -5,
+	        -5, 0, 5, 5, 5, 5, 0, -5,
+	        -10, 0, 5, 5, 5, 5, 0, -10,
+	        -10, 0, 0, 0, 0, 0, 0, -10,
+	        -20, -10, -10, -5, -5, -10, -10, -20,
+	    },
+	    [CHESS_PIECE_TYPE_KING] = {
+	        -50, -40, -30, -20, -20, -30, -40, -50,
+	        -30, -20, -10, 0, 0, -10, -20, -30,
+	        -30, -10, 20, 30, 30, 20, -10, -30,
+	        -30, -10, 30, 40, 40, 30, -10, -30,
+	        -30, -10, 30, 40, 40, 30, -10, -30,
+	        -30, -10, 20, 30, 30, 20, -10, -30,
+	        -30, -30, 0, 0, 0, 0, -30, -30,
+	        -50, -30, -30, -30, -30, -30, -30, -50,
+	    },
+	},
+};
+
+static CHESS_CONSTEXPR unsigned int chess_piece_phases[CHESS_PIECE_TYPE_KING + 1] = {
+	[CHESS_PIECE_TYPE_PAWN]   = 0,
+	[CHESS_PIECE_TYPE_KNIGHT] = 1,
+	[CHESS_PIECE_TYPE_BISHOP] = 1,
+	[CHESS_PIECE_TYPE_ROOK]   = 2,
+	[CHESS_PIECE_TYPE_QUEEN]  = 4,
+	[CHESS_PIECE_TYPE_KING]   = 0,
+};
+
+static ChessScore chess_piece_square_score(ChessGamePhase phase, ChessPiece piece, ChessSquare square) {
+	assert(chess_piece_is_valid(piece));
+	assert(chess_square_is_valid(square));
+
+	ChessColor color    = chess_piece_color(piece);
+	ChessPieceType type = chess_piece_type(piece);
+	ChessFile file      = chess_square_file(square);
+	ChessRank rank      = chess_square_rank(square);
+
+	if (color == CHESS_COLOR_WHITE) {
+		return chess_piece_values[phase][type] + chess_piece_square_values[phase][type][(CHESS_RANK_8 - rank) * 8 + file];
+	} else {
+		return -(chess_piece_values[phase][type] + chess_piece_square_values[phase][type][(rank - CHESS_RANK_1) * 8 + file]);
+	}
+}
+static unsigned int chess_piece_phase(ChessPiece piece) {
+	assert(chess_piece_is_valid(piece));
+
+	return chess_piece_phases[chess_piece_type(piece)];
+}
+static uint64_t chess_position_compute_pawn_hash(const ChessPosition *position) {
+	uint64_t pawn_hash = 0;
+
+	for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
+		ChessPiece piece = chess_piece_new(color, CHESS_PIECE_TYPE_PAWN);
+		for (size_t i = 0; i < position->piece_counts[color][CHESS_PIECE_TYPE_PAWN]; i++) {
+			pawn_hash ^= chess_zobrist_piece_at_square[piece][position->pieces[color][CHESS_PIECE_TYPE_PAWN][i]];
+		}
+	}
+
+	return pawn_hash;
+}
+static uint64_t chess_position_compute_piece_hash(const ChessPosition *position) {
+	uint64_t piece_hash = 0;
+
+	for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
+		for (ChessPieceType type = CHESS_PIECE_TYPE_PAWN; type <= CHESS_PIECE_TYPE_KING; type++) {
+			ChessPiece piece = chess_piece_new(color, type);
+			for (size_t i = 0; i < position->piece_counts[color][type]; i++) {
+				piece_hash ^= chess_zobrist_piece_at_square[piece][position->pieces[color][type][i]];
+			}
+		}
+	}
+
+	return piece_hash;
+}
+
 void chess_position_debug(const ChessPosition *position) {
 	printf("(ChessPosition) {\n");
 
@@ -85,7 +297,7 @@ void chess_position_debug(const ChessPosition *position) {
 		}
 		printf("\t\t[");
 		chess_square_debug(square);
-		printf("] = %" PRIu8 ",\n", position->piece_indices[square]);
+		printf("] = %" PRIu8 ",\n", position->piece_indices[CHESS_POSITION_SQUARE_INDEX(square)]);
 	}
 	printf("\t},\n");
 
@@ -101,9 +313,15 @@ void chess_position_debug(const ChessPosition *position) {
 	chess_square_debug(position->en_passant_square);
 	printf(",\n");
 
-	printf("\t.half_move_clock = %u,\n", position->half_move_clock);
+	printf("\t.half_move_clock = %" PRIu16 ",\n", position->half_move_clock);
+
+	printf("\t.full_move_number = %" PRIu16 ",\n", position->full_move_number);
 
-	printf("\t.full_move_number = %u,\n", position->full_move_number);
+	printf("\t.midgame_score = %" PRId32 ",\n", position->midgame_score);
+
+	printf("\t.endgame_score = %" PRId32 ",\n", position->endgame_score);
+
+	printf("\t.phase = %" PRIu8 ",\n", position->phase);
 
 	printf("}");
 }
@@ -144,6 +362,9 @@ bool chess_position_is_valid(const ChessPosition *position) {
 	}
 
 	uint8_t piece_counts[CHESS_COLOR_BLACK + 1][CHESS_PIECE_TYPE_KING + 1] = { 0 };
+	ChessScore midgame_score                                               = 0;
+	ChessScore endgame_score                                               = 0;
+	unsigned int phase                                                     = 0;
 
 	for (ChessSquare square = CHESS_SQUARE_A1; square <= CHESS_SQUARE_H8; square++) {
 		if (!chess_square_is_valid(square)) {
@@ -165,18 +386,25 @@ bool chess_position_is_valid(const ChessPosition *position) {
 		ChessPieceType type = chess_piece_type(piece);
 
 		piece_counts[color][type]++;
+		midgame_score += chess_piece_square_score(CHESS_GAME_PHASE_MIDGAME, piece, square);
+		endgame_score += chess_piece_square_score(CHESS_GAME_PHASE_ENDGAME, piece, square);
+		phase += chess_piece_phase(piece);
+	}
+
+	if (midgame_score != position->midgame_score || endgame_score != position->endgame_score || phase != position->phase) {
+		return false;
 	}
 
 	for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
 		for (ChessPieceType type = CHESS_PIECE_TYPE_PAWN; type <= CHESS_PIECE_TYPE_KING; type++) {
-			if (piece_counts[color][type] != position->piece_counts[color][type]) {
+			if (piece_counts[color][type] != position->piece_counts[color][type] || piece_counts[color][type] > CHESS_POSITION_MAXIMUM_PIECE_TYPE_COUNT) {
 				return false;
 			}
 
 			for (size_t i = 0; i < position->piece_counts[color][type]; i++) {
 				ChessSquare square = position->pieces[color][type][i];
 
-				if (position->piece_indices[square] != i) {
+				if (position->piece_indices[CHESS_POSITION_SQUARE_INDEX(square)] != i) {
 					return false;
 				}
 
@@ -187,7 +415,11 @@ bool chess_position_is_valid(const ChessPosition *position) {
 		}
 	}
 
-	return chess_position_counter_is_valid(&position->position_counter);
+	if (position->pawn_hash != chess_position_compute_pawn_hash(position)) {
+		return false;
+	}
+
+	return position->piece_hash == chess_position_compute_piece_hash(position);
 }
 ChessPosition chess_position_new(void) {
 	ChessPosition position = {
@@ -345,67 +577,68 @@ ChessPosition chess_position_new(void) {
 		    },
 		},
 		.piece_indices = {
-		    [CHESS_SQUARE_A2] = 0,
-		    [CHESS_SQUARE_B2] = 1,
-		    [CHESS_SQUARE_C2] = 2,
-		    [CHESS_SQUARE_D2] = 3,
-		    [CHESS_SQUARE_E2] = 4,
-		    [CHESS_SQUARE_F2] = 5,
-		    [CHESS_SQUARE_G2] = 6,
-		    [CHESS_SQUARE_H2] = 7,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_A2)] = 0,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_B2)] = 1,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_C2)] = 2,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_D2)] = 3,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_E2)] = 4,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_F2)] = 5,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_G2)] = 6,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_H2)] = 7,
 
-		    [CHESS_SQUARE_B1] = 0,
-		    [CHESS_SQUARE_G1] = 1,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_B1)] = 0,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_G1)] = 1,
 
-		    [CHESS_SQUARE_C1] = 0,
-		    [CHESS_SQUARE_F1] = 1,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_C1)] = 0,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_F1)] = 1,
 
-		    [CHESS_SQUARE_A1] = 0,
-		    [CHESS_SQUARE_H1] = 1,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_A1)] = 0,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_H1)] = 1,
 
-		    [CHESS_SQUARE_D1] = 0,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_D1)] = 0,
 
-		    [CHESS_SQUARE_E1] = 0,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_E1)] = 0,
 
-		    [CHESS_SQUARE_A7] = 0,
-		    [CHESS_SQUARE_B7] = 1,
-		    [CHESS_SQUARE_C7] = 2,
-		    [CHESS_SQUARE_D7] = 3,
-		    [CHESS_SQUARE_E7] = 4,
-		    [CHESS_SQUARE_F7] = 5,
-		    [CHESS_SQUARE_G7] = 6,
-		    [CHESS_SQUARE_H7] = 7,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_A7)] = 0,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_B7)] = 1,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_C7)] = 2,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_D7)] = 3,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_E7)] = 4,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_F7)] = 5,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_G7)] = 6,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_H7)] = 7,
 
-		    [CHESS_SQUARE_B8] = 0,
-		    [CHESS_SQUARE_G8] = 1,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_B8)] = 0,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_G8)] = 1,
 
-		    [CHESS_SQUARE_C8] = 0,
-		    [CHESS_SQUARE_F8] = 1,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_C8)] = 0,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_F8)] = 1,
 
-		    [CHESS_SQUARE_A8] = 0,
-		    [CHESS_SQUARE_H8] = 1,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_A8)] = 0,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_H8)] = 1,
 
-		    [CHESS_SQUARE_D8] = 0,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_D8)] = 0,
 
-		    [CHESS_SQUARE_E8] = 0,
+		    [CHESS_POSITION_SQUARE_INDEX(CHESS_SQUARE_E8)] = 0,
 		},
 		.side_to_move      = CHESS_COLOR_WHITE,
 		.castling_rights   = CHESS_CASTLING_RIGHTS_ALL,
 		.en_passant_square = CHESS_SQUARE_NONE,
 		.half_move_clock   = 0,
 		.full_move_number  = 1,
-		.position_counter  = chess_position_counter_new(),
+		.midgame_score     = 0,
+		.endgame_score     = 0,
+		.phase             = CHESS_POSITION_MAXIMUM_PHASE,
+		.pawn_hash         = 0,
+		.piece_hash        = 0,
 	};
+	position.pawn_hash  = chess_position_compute_pawn_hash(&position);
+	position.piece_hash = chess_position_compute_piece_hash(&position);
 
 	assert(chess_position_is_valid(&position));
 
 	return position;
 }
-void chess_position_drop(ChessPosition *position) {
-	assert(chess_position_is_valid(position));
-
-	chess_position_counter_drop(&position->position_counter);
-}
 ChessPiece chess_position_piece_at_square(const ChessPosition *position, ChessSquare square) {
 	assert(chess_position_is_valid(position));
 	assert(chess_square_is_valid(square));
@@ -417,6 +650,18 @@ ChessColor chess_position_side_to_move(const ChessPosition *position) {
 
 	return position->side_to_move;
 }
+void chess_position_clear_board(ChessPosition *position) {
+	assert(position != CHESS_NULL);
+
+	memset(position->board, CHESS_PIECE_NONE, sizeof(position->board));
+	memset(position->pieces, CHESS_SQUARE_NONE, sizeof(position->pieces));
+	memset(position->piece_counts, 0, sizeof(position->piece_counts));
+	position->midgame_score = 0;
+	position->endgame_score = 0;
+	position->phase         = 0;
+	position->pawn_hash     = 0;
+	position->piece_hash    = 0;
+}
 void chess_position_place_piece(ChessPosition *position, ChessPiece piece, ChessSquare square) {
 	assert(chess_piece_is_valid(piece));
 	assert(chess_square_is_valid(square));
@@ -427,19 +672,39 @@ void chess_position_place_piece(ChessPosition *position, ChessPiece piece, Chess
 
 	position->board[square]                                            = piece;
 	position->pieces[color][type][position->piece_counts[color][type]] = square;
-	position->piece_indices[square]                                    = position->piece_counts[color][type]++;
+	position->piece_indices[CHESS_POSITION_SQUARE_INDEX(square)]       = position->piece_counts[color][type]++;
+
+	position->midgame_score += chess_piece_square_score(CHESS_GAME_PHASE_MIDGAME, piece, square);
+	position->endgame_score += chess_piece_square_score(CHESS_GAME_PHASE_ENDGAME, piece, square);
+	position->phase += chess_piece_phase(piece);
+
+	position->piece_hash ^= chess_zobrist_piece_at_square[piece][square];
+	if (type == CHESS_PIECE_TYPE_PAWN) {
+		position->pawn_hash ^= chess_zobrist_piece_at_square[piece][square];
+	}
 }
 ChessPiece chess_position_remove_piece(ChessPosition *position, ChessSquare square) {
 	assert(chess_square_is_valid(square));
 	assert(position->board[square] != CHESS_PIECE_NONE);
 
-	ChessPiece piece                                                                            = position->board[square];
-	ChessColor color                                                                            = chess_piece_color(piece);
-	ChessPieceType type                                                                         = chess_piece_type(piece);
+	ChessPiece piece                                                  = position->board[square];
+	ChessColor color                                                  = chess_piece_color(piece);
+	ChessPieceType type                                               = chess_piece_type(piece);
+	uint8_t index                                                     = position->piece_indices[CHESS_POSITION_SQUARE_INDEX(square)];
+	ChessSquare last_square                                           = position->pieces[color][type][--position->piece_counts[color][type]];
+
+	position->board[square]                                           = CHESS_PIECE_NONE;
+	position->pieces[color][type][index]                              = last_square;
+	position->piece_indices[CHESS_POSITION_SQUARE_INDEX(last_square)] = index;
 
-	position->board[square]                                                                     = CHESS_PIECE_NONE;
-	position->pieces[color][type][position->piece_indices[square]]                              = position->pieces[color][type][--position->piece_counts[color][type]];
-	position->piece_indices[position->pieces[color][type][position->piece_counts[color][type]]] = position->piece_indices[square];
+	position->midgame_score -= chess_piece_square_score(CHESS_GAME_PHASE_MIDGAME, piece, square);
+	position->endgame_score -= chess_piece_square_score(CHESS_GAME_PHASE_ENDGAME, piece, square);
+	position->phase -= chess_piece_phase(piece);
+
+	position->piece_hash ^= chess_zobrist_piece_at_square[piece][square];
+	if (type == CHESS_PIECE_TYPE_PAWN) {
+		position->pawn_hash ^= chess_zobrist_piece_at_square[piece][square];
+	}
 
 	return piece;
 }
@@ -449,14 +714,22 @@ void chess_position_move_piece(ChessPosition *position, ChessSquare from, ChessS
 	assert(position->board[from] != CHESS_PIECE_NONE);
 	assert(position->board[to] == CHESS_PIECE_NONE);
 
-	ChessPiece piece                                             = position->board[from];
-	ChessColor color                                             = chess_piece_color(piece);
-	ChessPieceType type                                          = chess_piece_type(piece);
+	ChessPiece piece                                                                          = position->board[from];
+	ChessColor color                                                                          = chess_piece_color(piece);
+	ChessPieceType type                                                                       = chess_piece_type(piece);
 
-	position->board[to]                                          = piece;
-	position->board[from]                                        = CHESS_PIECE_NONE;
-	position->pieces[color][type][position->piece_indices[from]] = to;
-	position->piece_indices[to]                                  = position->piece_indices[from];
+	position->board[to]                                                                       = piece;
+	position->board[from]                                                                     = CHESS_PIECE_NONE;
+	position->pieces[color][type][position->piece_indices[CHESS_POSITION_SQUARE_INDEX(from)]] = to;
+	position->piece_indices[CHESS_POSITION_SQUARE_INDEX(to)]                                  = position->piece_indices[CHESS_POSITION_SQUARE_INDEX(from)];
+
+	position->midgame_score += chess_piece_square_score(CHESS_GAME_PHASE_MIDGAME, piece, to) - chess_piece_square_score(CHESS_GAME_PHASE_MIDGAME, piece, from);
+	position->endgame_score += chess_piece_square_score(CHESS_GAME_PHASE_ENDGAME, piece, to) - chess_piece_square_score(CHESS_GAME_PHASE_ENDGAME, piece, from);
+
+	position->piece_hash ^= chess_zobrist_piece_at_square[piece][from] ^ chess_zobrist_piece_at_square[piece][to];
+	if (type == CHESS_PIECE_TYPE_PAWN) {
+		position->pawn_hash ^= chess_zobrist_piece_at_square[piece][from] ^ chess_zobrist_piece_at_square[piece][to];
+	}
 }
 size_t chess_position_from_fen(ChessPosition *position, const char *string) {
 	assert(position != CHESS_NULL);
@@ -468,9 +741,7 @@ size_t chess_position_from_fen(ChessPosition *position, const char *string) {
 		total_read++;
 	}
 
-	memset(position->board, CHESS_PIECE_NONE, sizeof(position->board));
-	memset(position->pieces, CHESS_SQUARE_NONE, sizeof(position->pieces));
-	memset(position->piece_counts, 0, sizeof(position->piece_counts));
+	chess_position_clear_board(position);
 	for (ChessRank rank = CHESS_RANK_8; rank >= CHESS_RANK_1; rank--) {
 		for (ChessFile file = CHESS_FILE_A; file <= CHESS_FILE_H; file++) {
 			ChessSquare square = chess_square_new(file, rank);
@@ -484,6 +755,9 @@ size_t chess_position_from_fen(ChessPosition *position, const char *string) {
 				ChessPiece piece = CHESS_PIECE_NONE;
 				CHESS_READ(chess_piece_from_algebraic, &piece);
 
+				if (position->piece_counts[chess_piece_color(piece)][chess_piece_type(piece)] == CHESS_POSITION_MAXIMUM_PIECE_TYPE_COUNT) {
+					return 0;
+				}
 				chess_position_place_piece(position, piece, square);
 			}
 		}
@@ -555,10 +829,10 @@ size_t chess_position_from_fen(ChessPosition *position, const char *string) {
 	errno                = 0;
 	char *end            = CHESS_NULL;
 	unsigned long number = strtoul(string + total_read, &end, 10);
-	if (end == string + total_read || errno != 0 || number > UINT_MAX) {
+	if (end == string + total_read || errno != 0 || number > UINT16_MAX) {
 		return 0;
 	}
-	position->half_move_clock = (unsigned int)number;
+	position->half_move_clock = (uint16_t)number;
 	total_read                = (size_t)(end - string);
 
 	if (!isspace(string[total_read])) {
@@ -571,10 +845,10 @@ size_t chess_position_from_fen(ChessPosition *position, const char *string) {
 	errno  = 0;
 	end    = CHESS_NULL;
 	number = strtoul(string + total_read, &end, 10);
-	if (end == string + total_read || errno != 0 || number > UINT_MAX) {
+	if (end == string + total_read || errno != 0 || number > UINT16_MAX) {
 		return 0;
 	}
-	position->full_move_number = (unsigned int)number;
+	position->full_move_number = (uint16_t)number;
 	total_read                 = (size_t)(end - string);
 
 	return total_read;
@@ -640,10 +914,49 @@ size_t chess_position_to_fen(const ChessPosition *position, char *string, size_t
 
 	CHESS_WRITE_FORMATTED(" ");
 
-	CHESS_WRITE_FORMATTED("%u %u", position->half_move_clock, position->full_move_number);
+	CHESS_WRITE_FORMATTED("%" PRIu16 " %" PRIu16, position->half_move_clock, position->full_move_number);
 
 	return total_written;
 }
+size_t chess_position_apply_moves(ChessPosition *position, const ChessMove *moves, size_t count) {
+	assert(chess_position_is_valid(position));
+	assert(moves != CHESS_NULL || count == 0);
+
+	for (size_t i = 0; i < count; i++) {
+		if (!chess_move_is_valid(moves[i]) || !chess_move_do_if_legal(position, moves[i])) {
+			return i;
+		}
+	}
+
+	return count;
+}
+size_t chess_position_apply_uci_moves(ChessPosition *position, const char *string, size_t *move_count) {
+	assert(chess_position_is_valid(position));
+	assert(string != CHESS_NULL);
+	assert(move_count != CHESS_NULL);
+
+	size_t total_read = 0;
+	*move_count       = 0;
+	while (true) {
+		size_t read = total_read;
+		while (isspace(string[read])) {
+			read++;
+		}
+		if (string[read] == '\0') {
+			return read;
+		}
+
+		ChessMove move;
+		size_t move_read = chess_move_from_uci_unchecked(position, &move, string + read);
+		if (move_read == 0 || (string[read + move_read] != '\0' && !isspace(string[read + move_read])) ||
+		    !chess_move_do_if_legal(position, move)) {
+			return total_read;
+		}
+
+		total_read = read + move_read;
+		(*move_count)++;
+	}
+}
 bool chess_position_is_king_attacked(const ChessPosition *position, ChessColor color) {
 	assert(chess_position_is_valid(position));
 
@@ -669,11 +982,6 @@ bool chess_position_is_fifty_move_rule(const ChessPosition *position) {
 
 	return position->half_move_clock >= 100 && !chess_position_is_checkmate(position);
 }
-bool chess_position_is_threefold_repetition(const ChessPosition *position) {
-	assert(chess_position_is_valid(position));
-
-	return chess_position_counter_count(&position->position_counter, position) >= 3;
-}
 bool chess_position_is_insufficient_material(const ChessPosition *position) {
 	assert(chess_position_is_valid(position));
 
@@ -720,159 +1028,129 @@ bool chess_position_is_insufficient_material(const ChessPosition *position) {
 
 	return false;
 }
-uint64_t chess_random(uint64_t *state) {
-	assert(state != CHESS_NULL && *state != 0);
-
-	uint64_t value = *state;
-	value ^= value >> 12;
-	value ^= value << 25;
-	value ^= value >> 27;
-
-	*state = value;
-
-	return value * 0x2545F4914F6CDD1DULL;
-}
 uint64_t chess_position_hash(const ChessPosition *position) {
 	assert(chess_position_is_valid(position));
 
-	static bool initialized                                                               = false;
-	static uint64_t piece_at_square_hash[CHESS_PIECE_BLACK_KING + 1][CHESS_SQUARE_H8 + 1] = { 0 };
-	static uint64_t side_to_move_hash                                                     = 0;
-	static uint64_t castling_rights_hash[CHESS_CASTLING_RIGHTS_ALL + 1]                   = { 0 };
-	static uint64_t en_passant_file_hash[CHESS_FILE_H + 1]                                = { 0 };
-	if (!initialized) {
-		uint64_t random_state = 0x9E3779B97F4A7C15ULL;
-
-		for (ChessPiece piece = CHESS_PIECE_WHITE_PAWN; piece <= CHESS_PIECE_BLACK_KING; piece++) {
-			if (!chess_piece_is_valid(piece)) {
-				piece = CHESS_PIECE_BLACK_PAWN - 1;
-				continue;
-			}
-
-			for (ChessSquare square = CHESS_SQUARE_A1; square <= CHESS_SQUARE_H8; square++) {
-				if (!chess_square_is_valid(square)) {
-					square += CHESS_SQUARE_A2 - (CHESS_SQUARE_H1 + 1) - 1;
-					continue;
-				}
-
-				piece_at_square_hash[piece][square] = chess_random(&random_state);
-			}
-		}
-
-		side_to_move_hash = chess_random(&random_state);
-
-		for (ChessCastlingRights castling_rights = CHESS_CASTLING_RIGHTS_NONE; castling_rights <= CHESS_CASTLING_RIGHTS_ALL; castling_rights++) {
-			castling_rights_hash[castling_rights] = chess_random(&random_state);
-		}
-
-		for (ChessFile file = CHESS_FILE_A; file <= CHESS_FILE_H; file++) {
-			en_passant_file_hash[file] = chess_random(&random_state);
-		}
-
-		initialized = true;
-	}
-
-	uint64_t hash = 0;
-
-	for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
-		for (ChessPieceType type = CHESS_PIECE_TYPE_PAWN; type <= CHESS_PIECE_TYPE_KING; type++) {
-			for (size_t i = 0; i < position->piece_counts[color][type]; i++) {
-				ChessSquare square = position->pieces[color][type][i];
-				hash ^= piece_at_square_hash[position->board[square]][square];
-			}
-		}
-	}
+	uint64_t hash = position->piece_hash;
 
 	if (position->side_to_move == CHESS_COLOR_BLACK) {
-		hash ^= side_to_move_hash;
+		hash ^= chess_zobrist_side_to_move;
 	}
 
-	hash ^= castling_rights_hash[position->castling_rights];
+	hash ^= chess_zobrist_castling_rights[position->castling_rights];
 
 	if (position->en_passant_square != CHESS_SQUARE_NONE) {
 		ChessFile file = chess_square_file(position->en_passant_square);
-		hash ^= en_passant_file_hash[file];
+		hash ^= chess_zobrist_en_passant_file[file];
 	}
 
 	return hash;
 }
-double chess_position_evaluate(const ChessPosition *position) {
-	assert(chess_position_is_valid(position));
-
-	static const double piece_values[] = {
-		[CHESS_PIECE_WHITE_PAWN]   = 1.0,
-		[CHESS_PIECE_WHITE_KNIGHT] = 3.0,
-		[CHESS_PIECE_WHITE_BISHOP] = 3.0,
-		[CHESS_PIECE_WHITE_ROOK]   = 5.0,
-		[CHESS_PIECE_WHITE_QUEEN]  = 9.0,
-		[CHESS_PIECE_WHITE_KING]   = 200.0,
-
-		[CHESS_PIECE_BLACK_PAWN]   = -1.0,
-		[CHESS_PIECE_BLACK_KNIGHT] = -3.0,
-		[CHESS_PIECE_BLACK_BISHOP] = -3.0,
-		[CHESS_PIECE_BLACK_ROOK]   = -5.0,
-		[CHESS_PIECE_BLACK_QUEEN]  = -9.0,
-		[CHESS_PIECE_BLACK_KING]   = -200.0,
-
-		[CHESS_PIECE_NONE]         = 0.0,
-	};
-
-	double value                                                           = 0.0;
+static unsigned int chess_position_count_targets(
+    const ChessPosition *position,
+    ChessSquare from,
+    const ChessOffset *offsets,
+    size_t offset_count,
+    bool is_sliding
+) {
+	assert(chess_square_is_valid(from));
+	assert(offsets != CHESS_NULL || offset_count == 0);
 
-	unsigned int pawn_file_counts[CHESS_COLOR_BLACK + 1][CHESS_FILE_H + 1] = { 0 };
-	unsigned int weak_pawns[CHESS_COLOR_BLACK + 1]                         = { 0 };
+	ChessColor color   = chess_piece_color(position->board[from]);
 
-	for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
-		for (ChessPieceType type = CHESS_PIECE_TYPE_PAWN; type <= CHESS_PIECE_TYPE_KING; type++) {
-			for (size_t i = 0; i < position->piece_counts[color][type]; i++) {
-				ChessSquare square = position->pieces[color][type][i];
-				ChessPiece piece   = position->board[square];
+	unsigned int count = 0;
+	for (size_t i = 0; i < offset_count; i++) {
+		ChessSquare to = from;
+		do {
+			to += offsets[i];
+			if (!chess_square_is_valid(to) || chess_piece_color(position->board[to]) == color) {
+				break;
+			}
+			count++;
+		} while (is_sliding && position->board[to] == CHESS_PIECE_NONE);
+	}
 
-				value += piece_values[piece];
+	return count;
+}
+static unsigned int chess_position_mobility(const ChessPosition *position, ChessColor color) {
+	assert(chess_color_is_valid(color));
+
+	static CHESS_CONSTEXPR ChessOffset knight_offsets[] = {
+		2 * CHESS_OFFSET_NORTH + CHESS_OFFSET_EAST,
+		2 * CHESS_OFFSET_NORTH + CHESS_OFFSET_WEST,
+		2 * CHESS_OFFSET_EAST + CHESS_OFFSET_NORTH,
+		2 * CHESS_OFFSET_EAST + CHESS_OFFSET_SOUTH,
+		2 * CHESS_OFFSET_SOUTH + CHESS_OFFSET_EAST,
+		2 * CHESS_OFFSET_SOUTH + CHESS_OFFSET_WEST,
+		2 * CHESS_OFFSET_WEST + CHESS_OFFSET_NORTH,
+		2 * CHESS_OFFSET_WEST + CHESS_OFFSET_SOUTH,
+	};
+	// The first four directions are the rook's and the last four the bishop's, the queen and the king use all of them.
+	static CHESS_CONSTEXPR ChessOffset directions[] = {
+		CHESS_OFFSET_NORTH,
+		CHESS_OFFSET_EAST,
+		CHESS_OFFSET_SOUTH,
+		CHESS_OFFSET_WEST,
+		CHESS_OFFSET_NORTH_EAST,
+		CHESS_OFFSET_SOUTH_EAST,
+		CHESS_OFFSET_SOUTH_WEST,
+		CHESS_OFFSET_NORTH_WEST,
+	};
 
-				if (type == CHESS_PIECE_TYPE_PAWN) {
-					ChessFile file = chess_square_file(square);
-					pawn_file_counts[color][file]++;
+	unsigned int count = 0;
 
-					ChessOffset direction = color == CHESS_COLOR_WHITE ? CHESS_OFFSET_NORTH : CHESS_OFFSET_SOUTH;
-					if (chess_square_is_valid(square + direction) &&
-					    position->board[square + direction] != CHESS_PIECE_NONE) {
-						weak_pawns[color]++;
-					}
-				}
-			}
+	ChessOffset direction = color == CHESS_COLOR_WHITE ? CHESS_OFFSET_NORTH : CHESS_OFFSET_SOUTH;
+	for (size_t i = 0; i < position->piece_counts[color][CHESS_PIECE_TYPE_PAWN]; i++) {
+		ChessSquare from = position->pieces[color][CHESS_PIECE_TYPE_PAWN][i];
+		if (position->board[from + direction] == CHESS_PIECE_NONE) {
+			count++;
+		}
+		ChessSquare to = (ChessSquare)(from + direction + CHESS_OFFSET_EAST);
+		if (chess_square_is_valid(to) && chess_piece_color(position->board[to]) == chess_color_opposite(color)) {
+			count++;
+		}
+		to = (ChessSquare)(from + direction + CHESS_OFFSET_WEST);
+		if (chess_square_is_valid(to) && chess_piece_color(position->board[to]) == chess_color_opposite(color)) {
+			count++;
 		}
 	}
 
-	for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
-		for (ChessFile file = CHESS_FILE_A; file <= CHESS_FILE_H; file++) {
-			if (pawn_file_counts[color][file] == 0) {
-				continue;
-			}
+	for (size_t i = 0; i < position->piece_counts[color][CHESS_PIECE_TYPE_KNIGHT]; i++) {
+		count += chess_position_count_targets(position, position->pieces[color][CHESS_PIECE_TYPE_KNIGHT][i], knight_offsets, CHESS_ARRAY_LENGTH(knight_offsets), false);
+	}
+	for (size_t i = 0; i < position->piece_counts[color][CHESS_PIECE_TYPE_BISHOP]; i++) {
+		count += chess_position_count_targets(position, position->pieces[color][CHESS_PIECE_TYPE_BISHOP][i], directions + 4, 4, true);
+	}
+	for (size_t i = 0; i < position->piece_counts[color][CHESS_PIECE_TYPE_ROOK]; i++) {
+		count += chess_position_count_targets(position, position->pieces[color][CHESS_PIECE_TYPE_ROOK][i], directions, 4, true);
+	}
+	for (size_t i = 0; i < position->piece_counts[color][CHESS_PIECE_TYPE_QUEEN]; i++) {
+		count += chess_position_count_targets(position, position->pieces[color][CHESS_PIECE_TYPE_QUEEN][i], directions, CHESS_ARRAY_LENGTH(directions), true);
+	}
+	for (size_t i = 0; i < position->piece_counts[color][CHESS_PIECE_TYPE_KING]; i++) {
+		count += chess_position_count_targets(position, position->pieces[color][CHESS_PIECE_TYPE_KING][i], directions, CHESS_ARRAY_LENGTH(directions), false);
+	}
 
-			weak_pawns[color] += pawn_file_counts[color][file] - 1;
+	return count;
+}
+ChessScore chess_position_evaluate(const ChessPosition *position) {
+	assert(chess_position_is_valid(position));
 
-			if (!(file > CHESS_FILE_A && pawn_file_counts[color][file - 1] > 0) && !(file < CHESS_FILE_H && pawn_file_counts[color][file + 1] > 0)) {
-				weak_pawns[color] += pawn_file_counts[color][file];
-			}
-		}
-	}
+	return chess_position_evaluate_with_pawn_table(position, CHESS_NULL);
+}
+ChessScore chess_position_evaluate_with_pawn_table(const ChessPosition *position, ChessPawnTable *pawn_table) {
+	assert(chess_position_is_valid(position));
+	assert(pawn_table == CHESS_NULL || chess_pawn_table_is_valid(pawn_table));
 
-	value -= 0.5 * weak_pawns[CHESS_COLOR_WHITE];
-	value += 0.5 * weak_pawns[CHESS_COLOR_BLACK];
+	static CHESS_CONSTEXPR ChessScore mobility_bonus = 10;
 
-	ChessPosition temporary = *position;
-	if (position->side_to_move == CHESS_COLOR_WHITE) {
-		value += 0.1 * (double)chess_moves_generate(&temporary).count;
-		temporary.side_to_move      = CHESS_COLOR_BLACK;
-		temporary.en_passant_square = CHESS_SQUARE_NONE;
-		value -= 0.1 * (double)chess_moves_generate(&temporary).count;
-	} else {
-		value -= 0.1 * (double)chess_moves_generate(&temporary).count;
-		temporary.side_to_move      = CHESS_COLOR_WHITE;
-		temporary.en_passant_square = CHESS_SQUARE_NONE;
-		value += 0.1 * (double)chess_moves_generate(&temporary).count;
-	}
+	unsigned int phase                               = position->phase < CHESS_POSITION_MAXIMUM_PHASE ? position->phase : CHESS_POSITION_MAXIMUM_PHASE;
+	ChessScore value                                 = (position->midgame_score * (ChessScore)phase + position->endgame_score * (ChessScore)(CHESS_POSITION_MAXIMUM_PHASE - phase)) / (ChessScore)CHESS_POSITION_MAXIMUM_PHASE;
+
+	value += chess_pawn_table_probe(pawn_table, position).score;
+
+	value += mobility_bonus * (ChessScore)chess_position_mobility(position, CHESS_COLOR_WHITE);
+	value -= mobility_bonus * (ChessScore)chess_position_mobility(position, CHESS_COLOR_BLACK);
 
 	return value;
 }
@@ -1,99 +1,224 @@
 #include <chess/position_counter.h>
 
+#include <chess/allocator.h>
 #include <chess/position.h>
 
 #include <assert.h>
-#include <inttypes.h>
-#include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64)
+	#define CHESS_POSITION_COUNTER_HAS_SSE2
+
+	#include <emmintrin.h>
+#endif
+
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_POSITION_COUNTER_GROUP_SIZE, 16);
 CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_POSITION_COUNTER_INITIAL_SIZE, 64);
-#define CHESS_POSITION_COUNTER_MAXIMUM_LOAD_FACTOR (0.75F)
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint8_t, CHESS_POSITION_COUNTER_TAG_EMPTY, 0x80);
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint8_t, CHESS_POSITION_COUNTER_TAG_DELETED, 0xFE);
 
+static uint8_t chess_position_counter_tag(uint64_t key) {
+	return (uint8_t)(key >> 57U);
+}
 bool chess_position_counter_is_valid(const ChessPositionCounter *counter) {
 	assert(counter != CHESS_NULL);
 
+	if (!chess_allocator_is_valid(&counter->allocator)) {
+		return false;
+	}
+
 	if (counter->entries == CHESS_NULL) {
-		return counter->size == 0 && counter->count == 0;
+		return counter->tags == CHESS_NULL && counter->size == 0 && counter->count == 0 && counter->deleted_count == 0;
 	}
 
-	if (counter->size == 0 || counter->count > counter->size) {
+	if (counter->tags != (uint8_t *)(counter->entries + counter->size) ||
+	    counter->size < CHESS_POSITION_COUNTER_GROUP_SIZE || (counter->size & (counter->size - 1)) != 0 ||
+	    counter->count + counter->deleted_count >= counter->size) {
 		return false;
 	}
 
-	size_t count = 0;
+	size_t count         = 0;
+	size_t deleted_count = 0;
 	for (size_t i = 0; i < counter->size; i++) {
-		if (counter->entries[i].value != 0) {
+		uint8_t tag = counter->tags[i];
+		if (tag == CHESS_POSITION_COUNTER_TAG_DELETED) {
+			deleted_count++;
+		} else if (tag != CHESS_POSITION_COUNTER_TAG_EMPTY) {
+			if (tag != chess_position_counter_tag(counter->entries[i].key) || counter->entries[i].value == 0) {
+				return false;
+			}
 			count++;
 		}
 	}
 
-	return counter->count == count;
+	return counter->count == count && counter->deleted_count == deleted_count;
 }
 ChessPositionCounter chess_position_counter_new(void) {
+	return chess_position_counter_new_with_allocator(chess_allocator_default());
+}
+ChessPositionCounter chess_position_counter_new_with_allocator(ChessAllocator allocator) {
+	assert(chess_allocator_is_valid(&allocator));
+
 	return (ChessPositionCounter){
-		.entries = CHESS_NULL,
-		.size    = 0,
-		.count   = 0,
+		.entries       = CHESS_NULL,
+		.tags          = CHESS_NULL,
+		.size          = 0,
+		.count         = 0,
+		.deleted_count = 0,
+		.allocator     = allocator,
 	};
 }
 void chess_position_counter_drop(ChessPositionCounter *counter) {
 	assert(chess_position_counter_is_valid(counter));
 
-	free(counter->entries);
+	chess_allocator_deallocate(&counter->allocator, counter->entries, counter->size * (sizeof(*counter->entries) + 1));
 
-	counter->entries = CHESS_NULL;
-	counter->size    = 0;
-	counter->count   = 0;
+	counter->entries       = CHESS_NULL;
+	counter->tags          = CHESS_NULL;
+	counter->size          = 0;
+	counter->count         = 0;
+	counter->deleted_count = 0;
 }
 void chess_position_counter_clear(ChessPositionCounter *counter) {
 	assert(chess_position_counter_is_valid(counter));
 
-	memset(counter->entries, 0, counter->size * sizeof(counter->entries[0]));
-	counter->count = 0;
+	if (counter->tags != CHESS_NULL) {
+		memset(counter->tags, CHESS_POSITION_COUNTER_TAG_EMPTY, counter->size);
+	}
+	counter->count         = 0;
+	counter->deleted_count = 0;
 }
-static bool chess_position_counter_expand(ChessPositionCounter *counter) {
-	assert(chess_position_counter_is_valid(counter));
+// Gets a mask of the entries of the group starting at the given tag that have the given tag.
+static unsigned int chess_position_counter_match(const uint8_t *tags, uint8_t tag) {
+#ifdef CHESS_POSITION_COUNTER_HAS_SSE2
+	__m128i group = _mm_loadu_si128((const __m128i *)tags);
+	return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)tag)));
+#else
+	unsigned int mask = 0;
+	for (size_t i = 0; i < CHESS_POSITION_COUNTER_GROUP_SIZE; i++) {
+		mask |= (unsigned int)(tags[i] == tag) << i;
+	}
+	return mask;
+#endif
+}
+// Gets a mask of the entries of the group starting at the given tag that are empty or deleted, that is whose tag has its
+// high bit set.
+static unsigned int chess_position_counter_match_free(const uint8_t *tags) {
+#ifdef CHESS_POSITION_COUNTER_HAS_SSE2
+	return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)tags));
+#else
+	unsigned int mask = 0;
+	for (size_t i = 0; i < CHESS_POSITION_COUNTER_GROUP_SIZE; i++) {
+		mask |= (unsigned int)(tags[i] >> 7U) << i;
+	}
+	return mask;
+#endif
+}
+static size_t chess_position_counter_lowest_bit(unsigned int mask) {
+	assert(mask != 0);
+
+#if defined(__GNUC__) || defined(__clang__)
+	return (size_t)__builtin_ctz(mask);
+#else
+	size_t index = 0;
+	while ((mask & 1U) == 0) {
+		mask >>= 1U;
+		index++;
+	}
+	return index;
+#endif
+}
+// Gets the index of the entry of the given key, or the size of the table if there is none. The groups are probed
+// triangularly, which visits every group of a table of a power of two size, and a probe ends at the first group that has
+// an empty entry, since the key would have been placed in it.
+static size_t chess_position_counter_find(const ChessPositionCounter *counter, uint64_t key) {
+	assert(counter->entries != CHESS_NULL);
+
+	uint8_t tag  = chess_position_counter_tag(key);
+	size_t mask  = counter->size - 1;
+	size_t group = (size_t)key & mask & ~(CHESS_POSITION_COUNTER_GROUP_SIZE - 1);
+	for (size_t step = CHESS_POSITION_COUNTER_GROUP_SIZE;; step += CHESS_POSITION_COUNTER_GROUP_SIZE) {
+		for (unsigned int matches = chess_position_counter_match(counter->tags + group, tag); matches != 0; matches &= matches - 1) {
+			size_t index = group + chess_position_counter_lowest_bit(matches);
+			if (counter->entries[index].key == key) {
+				return index;
+			}
+		}
 
-	if (counter->size >= SIZE_MAX / sizeof(counter->entries[0])) {
-		return false;
+		if (chess_position_counter_match(counter->tags + group, CHESS_POSITION_COUNTER_TAG_EMPTY) != 0) {
+			return counter->size;
+		}
+
+		group = (group + step) & mask;
 	}
+}
+// Gets the index of the first empty or deleted entry on the probe sequence of the given key.
+static size_t chess_position_counter_find_free(const ChessPositionCounter *counter, uint64_t key) {
+	assert(counter->entries != CHESS_NULL);
+	assert(counter->count + counter->deleted_count < counter->size);
+
+	size_t mask  = counter->size - 1;
+	size_t group = (size_t)key & mask & ~(CHESS_POSITION_COUNTER_GROUP_SIZE - 1);
+	for (size_t step = CHESS_POSITION_COUNTER_GROUP_SIZE;; step += CHESS_POSITION_COUNTER_GROUP_SIZE) {
+		unsigned int matches = chess_position_counter_match_free(counter->tags + group);
+		if (matches != 0) {
+			return group + chess_position_counter_lowest_bit(matches);
+		}
 
-	size_t size = 0;
-	if (counter->size == 0) {
-		size = CHESS_POSITION_COUNTER_INITIAL_SIZE;
-	} else if (counter->size > SIZE_MAX / sizeof(counter->entries[0]) / 2) {
-		size = SIZE_MAX / sizeof(*counter->entries);
-	} else {
-		size = counter->size * 2;
+		group = (group + step) & mask;
 	}
+}
+static bool chess_position_counter_rehash(ChessPositionCounter *counter, size_t size) {
+	assert(chess_position_counter_is_valid(counter));
+	assert(size >= CHESS_POSITION_COUNTER_GROUP_SIZE && (size & (size - 1)) == 0);
+	assert(counter->count < size);
 
-	ChessPositionCounterEntry *entries = calloc(size, sizeof(*entries));
-	if (entries == NULL) {
+	if (size > SIZE_MAX / (sizeof(*counter->entries) + 1)) {
 		return false;
 	}
 
-	if (counter->entries != CHESS_NULL) {
-		for (size_t i = 0; i < counter->size; i++) {
-			if (counter->entries[i].value != 0) {
-				size_t probe = counter->entries[i].key % size;
-				while (entries[probe].value != 0) {
-					probe = (probe + 1) % size;
-				}
-
-				entries[probe] = counter->entries[i];
-			}
-		}
+	ChessPositionCounterEntry *entries = chess_allocator_allocate(&counter->allocator, size * (sizeof(*entries) + 1));
+	if (entries == CHESS_NULL) {
+		return false;
+	}
 
-		free(counter->entries);
+	ChessPositionCounter new_counter = {
+		.entries       = entries,
+		.tags          = (uint8_t *)(entries + size),
+		.size          = size,
+		.count         = counter->count,
+		.deleted_count = 0,
+		.allocator     = counter->allocator,
+	};
+	memset(new_counter.tags, CHESS_POSITION_COUNTER_TAG_EMPTY, size);
+
+	for (size_t i = 0; i < counter->size; i++) {
+		if ((counter->tags[i] & CHESS_POSITION_COUNTER_TAG_EMPTY) == 0) {
+			size_t index               = chess_position_counter_find_free(&new_counter, counter->entries[i].key);
+			new_counter.tags[index]    = counter->tags[i];
+			new_counter.entries[index] = counter->entries[i];
+		}
 	}
 
-	counter->entries = entries;
-	counter->size    = size;
+	chess_allocator_deallocate(&counter->allocator, counter->entries, counter->size * (sizeof(*counter->entries) + 1));
+	*counter = new_counter;
 
 	return true;
 }
+bool chess_position_counter_reserve(ChessPositionCounter *counter, size_t count) {
+	assert(chess_position_counter_is_valid(counter));
+
+	// The table is kept at most three quarters full.
+	size_t size = counter->size == 0 ? CHESS_POSITION_COUNTER_INITIAL_SIZE : counter->size;
+	while (size / 4 * 3 < count) {
+		if (size > SIZE_MAX / 2) {
+			return false;
+		}
+		size *= 2;
+	}
+
+	return size == counter->size || chess_position_counter_rehash(counter, size);
+}
 unsigned int chess_position_counter_count(const ChessPositionCounter *counter, const ChessPosition *position) {
 	assert(chess_position_counter_is_valid(counter));
 	assert(chess_position_is_valid(position));
@@ -102,39 +227,49 @@ unsigned int chess_position_counter_count(const ChessPositionCounter *counter, c
 		return 0;
 	}
 
-	uint64_t key = chess_position_hash(position);
-	size_t probe = key % counter->size;
-	while (counter->entries[probe].value != 0) {
-		if (counter->entries[probe].key == key) {
-			return counter->entries[probe].value;
-		}
-		probe = (probe + 1) % counter->size;
-	}
+	size_t index = chess_position_counter_find(counter, chess_position_hash(position));
 
-	return 0;
+	return index != counter->size ? counter->entries[index].value : 0;
 }
 bool chess_position_counter_increment(ChessPositionCounter *counter, const ChessPosition *position) {
 	assert(chess_position_counter_is_valid(counter));
 	assert(chess_position_is_valid(position));
 
-	if (counter->entries == CHESS_NULL || (float)counter->count / (float)counter->size > CHESS_POSITION_COUNTER_MAXIMUM_LOAD_FACTOR) {
-		if (!chess_position_counter_expand(counter)) {
-			return false;
+	uint64_t key = chess_position_hash(position);
+	if (counter->entries != CHESS_NULL) {
+		size_t index = chess_position_counter_find(counter, key);
+		if (index != counter->size) {
+			counter->entries[index].value++;
+			return true;
 		}
 	}
 
-	uint64_t key = chess_position_hash(position);
-	size_t probe = key % counter->size;
-	while (counter->entries[probe].value != 0) {
-		if (counter->entries[probe].key == key) {
-			counter->entries[probe].value++;
-			return true;
+	// The table is kept at most three quarters full, counting the deleted entries. A table that is mostly filled with
+	// deleted entries is rebuilt at the same size, which drops them.
+	if ((counter->count + counter->deleted_count + 1) * 4 > counter->size * 3) {
+		size_t size = 0;
+		if (counter->size == 0) {
+			size = CHESS_POSITION_COUNTER_INITIAL_SIZE;
+		} else if (counter->count < counter->size / 2) {
+			size = counter->size;
+		} else if (counter->size <= SIZE_MAX / 2) {
+			size = counter->size * 2;
+		} else {
+			return false;
+		}
+
+		if (!chess_position_counter_rehash(counter, size)) {
+			return false;
 		}
-		probe = (probe + 1) % counter->size;
 	}
 
-	counter->entries[probe].key   = key;
-	counter->entries[probe].value = 1;
+	size_t index = chess_position_counter_find_free(counter, key);
+	if (counter->tags[index] == CHESS_POSITION_COUNTER_TAG_DELETED) {
+		counter->deleted_count--;
+	}
+	counter->tags[index]          = chess_position_counter_tag(key);
+	counter->entries[index].key   = key;
+	counter->entries[index].value = 1;
 	counter->count++;
 
 	return true;
@@ -147,29 +282,24 @@ bool chess_position_counter_decrement(ChessPositionCounter *counter, const Chess
 		return false;
 	}
 
-	uint64_t key   = chess_position_hash(position);
-	size_t probe_1 = key % counter->size;
-	while (counter->entries[probe_1].value != 0) {
-		if (counter->entries[probe_1].key == key) {
-			counter->entries[probe_1].value--;
-
-			if (counter->entries[probe_1].value == 0) {
-				counter->count--;
-
-				for (size_t probe_2 = (probe_1 + 1) % counter->size; counter->entries[probe_2].value != 0; probe_2 = (probe_2 + 1) % counter->size) {
-					size_t hash = counter->entries[probe_2].key % counter->size;
-					if ((hash <= probe_2 && (hash < probe_1 && probe_1 <= probe_2)) || (hash > probe_2 && (probe_1 <= probe_2 || hash < probe_1))) {
-						counter->entries[probe_1]       = counter->entries[probe_2];
-						counter->entries[probe_2].value = 0;
-						probe_1                         = probe_2;
-					}
-				}
-			}
+	size_t index = chess_position_counter_find(counter, chess_position_hash(position));
+	if (index == counter->size) {
+		return false;
+	}
 
-			return true;
+	if (--counter->entries[index].value == 0) {
+		counter->count--;
+
+		// Probes end at a group with an empty entry, so such a group can take another one, while any other group has to keep
+		// its entry marked deleted for the probes that pass through it.
+		size_t group = index & ~(CHESS_POSITION_COUNTER_GROUP_SIZE - 1);
+		if (chess_position_counter_match(counter->tags + group, CHESS_POSITION_COUNTER_TAG_EMPTY) != 0) {
+			counter->tags[index] = CHESS_POSITION_COUNTER_TAG_EMPTY;
+		} else {
+			counter->tags[index] = CHESS_POSITION_COUNTER_TAG_DELETED;
+			counter->deleted_count++;
 		}
-		probe_1 = (probe_1 + 1) % counter->size;
 	}
 
-	return false;
+	return true;
 }
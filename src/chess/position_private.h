@@ -12,6 +12,7 @@ extern "C" {
 	#include <stdbool.h>
 #endif
 
+void chess_position_clear_board(ChessPosition *position);
 void chess_position_place_piece(ChessPosition *position, ChessPiece piece, ChessSquare square);
 ChessPiece chess_position_remove_piece(ChessPosition *position, ChessSquare square);
 void chess_position_move_piece(ChessPosition *position, ChessSquare from, ChessSquare to);
@@ -0,0 +1,63 @@
+#include <chess/score.h>
+
+#include <chess/macros_private.h>
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+void chess_score_debug(ChessScore score) {
+	if (score == CHESS_SCORE_INFINITE) {
+		printf("CHESS_SCORE_INFINITE");
+	} else if (score == -CHESS_SCORE_INFINITE) {
+		printf("-CHESS_SCORE_INFINITE");
+	} else if (chess_score_is_mate(score)) {
+		printf("%s(%u)", score > 0 ? "chess_score_mate_in" : "chess_score_mated_in", chess_score_mate_plies(score));
+	} else {
+		printf("(ChessScore)%" PRId32, score);
+	}
+}
+bool chess_score_is_valid(ChessScore score) {
+	return -CHESS_SCORE_INFINITE <= score && score <= CHESS_SCORE_INFINITE;
+}
+ChessScore chess_score_mate_in(unsigned int plies) {
+	assert(plies <= (unsigned int)CHESS_SCORE_MAXIMUM_MATE_PLIES);
+
+	return CHESS_SCORE_MATE - (ChessScore)plies;
+}
+ChessScore chess_score_mated_in(unsigned int plies) {
+	assert(plies <= (unsigned int)CHESS_SCORE_MAXIMUM_MATE_PLIES);
+
+	return -CHESS_SCORE_MATE + (ChessScore)plies;
+}
+bool chess_score_is_mate(ChessScore score) {
+	assert(chess_score_is_valid(score));
+
+	return abs(score) >= CHESS_SCORE_MATE_BOUND && abs(score) <= CHESS_SCORE_MATE;
+}
+unsigned int chess_score_mate_plies(ChessScore score) {
+	assert(chess_score_is_mate(score));
+
+	return (unsigned int)(CHESS_SCORE_MATE - abs(score));
+}
+size_t chess_score_to_string(ChessScore score, char *string, size_t string_size) {
+	assert(chess_score_is_valid(score));
+	assert(string != CHESS_NULL || string_size == 0);
+
+	size_t total_written = 0;
+
+	if (chess_score_is_mate(score)) {
+		unsigned int plies = chess_score_mate_plies(score);
+		if (score > 0) {
+			CHESS_WRITE_FORMATTED("#%u", (plies + 1) / 2);
+		} else {
+			CHESS_WRITE_FORMATTED("#-%u", plies / 2);
+		}
+	} else {
+		unsigned int centipawns = (unsigned int)abs(score);
+		CHESS_WRITE_FORMATTED("%c%u.%02u", score < 0 ? '-' : '+', centipawns / 100, centipawns % 100);
+	}
+
+	return total_written;
+}
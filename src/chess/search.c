@@ -0,0 +1,512 @@
+#include <chess/search.h>
+
+#include <chess/clock.h>
+#include <chess/color.h>
+#include <chess/move.h>
+#include <chess/move_private.h>
+#include <chess/moves.h>
+#include <chess/network.h>
+#include <chess/pawn_table.h>
+#include <chess/position.h>
+#include <chess/score.h>
+#include <chess/piece.h>
+#include <chess/piece_type.h>
+#include <chess/square.h>
+#include <chess/tablebase.h>
+#include <chess/transposition_table.h>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_SEARCH_PAWN_TABLE_SIZE, 16384);
+
+// History scores are halved once one reaches this bound, so that they stay below the order of captures.
+CHESS_DEFINE_INTEGRAL_CONSTANT(int32_t, CHESS_SEARCH_MAXIMUM_HISTORY, 1 << 20);
+
+typedef struct ChessSearch {
+	ChessSearchLimits limits;
+	uint64_t start_time;
+	uint64_t nodes;
+	bool is_stopped;
+	ChessPawnTable pawn_table;
+	ChessTranspositionTable *table;
+	ChessTranspositionTable own_table;
+	int16_t *accumulators;
+	int32_t history[CHESS_PIECE_BLACK_KING + 1][CHESS_SQUARE_H8 + 1];
+	ChessMove variations[CHESS_SEARCH_MAXIMUM_DEPTH + 1][CHESS_SEARCH_MAXIMUM_DEPTH];
+	size_t variation_lengths[CHESS_SEARCH_MAXIMUM_DEPTH + 1];
+	ChessSearchStatistics statistics;
+	uint64_t keys[CHESS_SEARCH_MAXIMUM_KEY_COUNT + CHESS_SEARCH_MAXIMUM_DEPTH + 1];
+	size_t key_count;
+} ChessSearch;
+
+static bool chess_search_poll(ChessSearch *search) {
+	assert(search != CHESS_NULL);
+
+	if (search->limits.stop != CHESS_NULL && *search->limits.stop) {
+		search->is_stopped = true;
+	} else if (search->limits.time != 0 && chess_clock_milliseconds() - search->start_time >= search->limits.time) {
+		search->is_stopped = true;
+	}
+
+	return search->is_stopped;
+}
+static bool chess_search_should_stop(ChessSearch *search) {
+	assert(search != CHESS_NULL);
+
+	if (search->is_stopped) {
+		return true;
+	}
+
+	if (search->limits.nodes != 0 && search->nodes >= search->limits.nodes) {
+		search->is_stopped = true;
+		return true;
+	}
+
+	if (search->nodes % CHESS_SEARCH_POLL_INTERVAL == 0) {
+		return chess_search_poll(search);
+	}
+
+	return false;
+}
+static int16_t *chess_search_accumulator(ChessSearch *search, unsigned int ply) {
+	assert(search != CHESS_NULL);
+	assert(ply <= CHESS_SEARCH_MAXIMUM_DEPTH);
+
+	if (search->accumulators == CHESS_NULL) {
+		return CHESS_NULL;
+	}
+
+	return search->accumulators + ply * chess_network_accumulator_size(search->limits.network);
+}
+static ChessScore chess_search_tablebase_score(ChessTablebaseResult result, unsigned int ply) {
+	switch (result.outcome) {
+		case CHESS_TABLEBASE_OUTCOME_WIN: return chess_score_mate_in(ply + 2 * result.moves - 1);
+		case CHESS_TABLEBASE_OUTCOME_LOSS: return chess_score_mated_in(ply + 2 * result.moves);
+		default: return CHESS_SCORE_DRAW;
+	}
+}
+// Mate scores count plies from the root in the search, but from the position in the table, as the position may be
+// reached at another ply.
+static ChessScore chess_search_score_to_table(ChessScore score, unsigned int ply) {
+	if (!chess_score_is_mate(score)) {
+		return score;
+	}
+	return score > 0 ? score + (ChessScore)ply : score - (ChessScore)ply;
+}
+static ChessScore chess_search_score_from_table(ChessScore score, unsigned int ply) {
+	if (!chess_score_is_mate(score)) {
+		return score;
+	}
+	return score > 0 ? score - (ChessScore)ply : score + (ChessScore)ply;
+}
+static bool chess_search_is_quiet(ChessMove move) {
+	return move.captured_piece == CHESS_PIECE_NONE && move.promotion_type == CHESS_PIECE_TYPE_NONE;
+}
+static void chess_search_order_moves(const ChessSearch *search, const ChessPosition *position, const ChessMoves *moves, const ChessTranspositionTableEntry *entry, int32_t *orders) {
+	assert(search != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+	assert(moves != CHESS_NULL);
+	assert(orders != CHESS_NULL);
+
+	// The best move of the table comes first, then captures and promotions, most valuable victim first and least valuable
+	// attacker breaking ties, then quiet moves by their history.
+	for (size_t i = 0; i < moves->count; i++) {
+		ChessMove move = moves->moves[i];
+		if (entry != CHESS_NULL && move.from == entry->from && move.to == entry->to && move.promotion_type == entry->promotion_type) {
+			orders[i] = INT32_MAX;
+		} else if (chess_search_is_quiet(move)) {
+			orders[i] = search->history[position->board[move.from]][move.to];
+		} else {
+			orders[i] = CHESS_SEARCH_MAXIMUM_HISTORY + 1;
+			if (move.captured_piece != CHESS_PIECE_NONE) {
+				orders[i] += 8 * (int32_t)(chess_piece_type(move.captured_piece) + 1) - (int32_t)chess_piece_type(position->board[move.from]);
+			}
+			if (move.promotion_type != CHESS_PIECE_TYPE_NONE) {
+				orders[i] += 8 * (int32_t)move.promotion_type;
+			}
+		}
+	}
+}
+static ChessMove chess_search_pick_move(ChessMoves *moves, int32_t *orders, size_t index) {
+	assert(moves != CHESS_NULL);
+	assert(orders != CHESS_NULL);
+	assert(index < moves->count);
+
+	// Moves are picked lazily, as a cutoff often leaves most of them unsearched.
+	size_t best_index = index;
+	for (size_t i = index + 1; i < moves->count; i++) {
+		if (orders[i] > orders[best_index]) {
+			best_index = i;
+		}
+	}
+
+	ChessMove move           = moves->moves[best_index];
+	int32_t order            = orders[best_index];
+	moves->moves[best_index] = moves->moves[index];
+	orders[best_index]       = orders[index];
+	moves->moves[index]      = move;
+	orders[index]            = order;
+
+	return move;
+}
+static void chess_search_update_history(ChessSearch *search, const ChessPosition *position, ChessMove move, unsigned int depth) {
+	assert(search != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+
+	int32_t *history = &search->history[position->board[move.from]][move.to];
+	*history += (int32_t)(depth * depth);
+	if (*history >= CHESS_SEARCH_MAXIMUM_HISTORY) {
+		for (ChessPiece piece = CHESS_PIECE_WHITE_PAWN; piece <= CHESS_PIECE_BLACK_KING; piece++) {
+			for (ChessSquare square = CHESS_SQUARE_A1; square <= CHESS_SQUARE_H8; square++) {
+				search->history[piece][square] /= 2;
+			}
+		}
+	}
+}
+static void chess_search_update_variation(ChessSearch *search, unsigned int ply, ChessMove move) {
+	assert(search != CHESS_NULL);
+	assert(ply < CHESS_SEARCH_MAXIMUM_DEPTH);
+
+	size_t length              = search->variation_lengths[ply + 1];
+	search->variations[ply][0] = move;
+	for (size_t i = 0; i < length && i + 1 < CHESS_SEARCH_MAXIMUM_DEPTH; i++) {
+		search->variations[ply][i + 1] = search->variations[ply + 1][i];
+	}
+	search->variation_lengths[ply] = length + 1 < CHESS_SEARCH_MAXIMUM_DEPTH ? length + 1 : CHESS_SEARCH_MAXIMUM_DEPTH;
+}
+static bool chess_search_is_repetition(const ChessSearch *search, const ChessPosition *position, unsigned int ply) {
+	assert(search != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+
+	// The keys of the game are followed by those of the current line, the key of a node being at its ply past them. Only
+	// positions with the same side to move and since the last capture or pawn move can be repeated, so they are scanned
+	// two plies at a time back to the last irreversible move, the closest possible repetition being four plies back.
+	size_t index    = search->key_count + ply;
+	size_t distance = position->half_move_clock < index ? position->half_move_clock : index;
+	for (size_t back = 4; back <= distance; back += 2) {
+		if (search->keys[index - back] == search->keys[index]) {
+			return true;
+		}
+	}
+
+	return false;
+}
+static ChessScore chess_search_negamax(ChessSearch *search, const ChessPosition *position, unsigned int depth, unsigned int ply, ChessScore alpha, ChessScore beta) {
+	assert(search != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+	assert(chess_score_is_valid(alpha) && chess_score_is_valid(beta));
+
+	search->nodes++;
+	search->variation_lengths[ply] = 0;
+	if (ply > search->statistics.selective_depth) {
+		search->statistics.selective_depth = ply;
+	}
+	if (chess_search_should_stop(search)) {
+		return CHESS_SCORE_DRAW;
+	}
+
+	uint64_t key                          = chess_position_hash(position);
+	search->keys[search->key_count + ply] = key;
+	if (chess_search_is_repetition(search, position, ply)) {
+		return CHESS_SCORE_DRAW;
+	}
+
+	ChessTablebaseResult tablebase_result;
+	if (search->limits.tablebase != CHESS_NULL && chess_tablebase_probe(search->limits.tablebase, position, &tablebase_result)) {
+		return chess_search_tablebase_score(tablebase_result, ply);
+	}
+
+	if (depth == 0) {
+		search->statistics.leaf_nodes++;
+		if (search->accumulators != CHESS_NULL) {
+			return chess_network_evaluate(search->limits.network, chess_search_accumulator(search, ply), position->side_to_move);
+		}
+
+		ChessScore value = chess_position_evaluate_with_pawn_table(position, &search->pawn_table);
+		return position->side_to_move == CHESS_COLOR_WHITE ? value : -value;
+	}
+
+	ChessTranspositionTableEntry entry;
+	bool is_hit = chess_transposition_table_probe(search->table, key, &entry);
+	search->statistics.table_probes++;
+	search->statistics.table_hits += is_hit;
+	if (is_hit && entry.depth >= depth) {
+		ChessScore value = chess_search_score_from_table(entry.score, ply);
+		if (entry.bound == CHESS_TRANSPOSITION_TABLE_BOUND_EXACT ||
+		    (entry.bound == CHESS_TRANSPOSITION_TABLE_BOUND_LOWER && value >= beta) ||
+		    (entry.bound == CHESS_TRANSPOSITION_TABLE_BOUND_UPPER && value <= alpha)) {
+			return value;
+		}
+	}
+
+	ChessMoves moves = chess_moves_generate(position);
+	if (moves.count == 0) {
+		return chess_position_is_check(position) ? chess_score_mated_in(ply) : CHESS_SCORE_DRAW;
+	}
+
+	int32_t orders[CHESS_MOVES_MAXIMUM_COUNT];
+	chess_search_order_moves(search, position, &moves, is_hit ? &entry : CHESS_NULL, orders);
+
+	ChessScore original_alpha = alpha;
+	ChessScore maximum_value  = -CHESS_SCORE_INFINITE;
+	ChessMove best_move       = moves.moves[0];
+	for (size_t i = 0; i < moves.count; i++) {
+		ChessMove move = chess_search_pick_move(&moves, orders, i);
+		if (search->accumulators != CHESS_NULL) {
+			chess_network_accumulator_update(search->limits.network, position, move, chess_search_accumulator(search, ply), chess_search_accumulator(search, ply + 1));
+		}
+
+		ChessPosition position_after_move = *position;
+		chess_move_do_unchecked(&position_after_move, move);
+		ChessScore value = -chess_search_negamax(search, &position_after_move, depth - 1, ply + 1, -beta, -alpha);
+		if (search->is_stopped) {
+			return CHESS_SCORE_DRAW;
+		}
+		if (value > maximum_value) {
+			maximum_value = value;
+			best_move     = move;
+			if (value > alpha) {
+				alpha = value;
+				chess_search_update_variation(search, ply, move);
+			}
+		}
+		if (alpha >= beta) {
+			search->statistics.cutoff_count++;
+			search->statistics.first_move_cutoff_count += i == 0;
+			if (chess_search_is_quiet(move)) {
+				chess_search_update_history(search, position, move, depth);
+			}
+			break;
+		}
+	}
+
+	ChessTranspositionTableBound bound = CHESS_TRANSPOSITION_TABLE_BOUND_EXACT;
+	if (maximum_value <= original_alpha) {
+		bound = CHESS_TRANSPOSITION_TABLE_BOUND_UPPER;
+	} else if (maximum_value >= beta) {
+		bound = CHESS_TRANSPOSITION_TABLE_BOUND_LOWER;
+	}
+	chess_transposition_table_store(
+	    search->table,
+	    (ChessTranspositionTableEntry){
+	        .key            = key,
+	        .score          = chess_search_score_to_table(maximum_value, ply),
+	        .depth          = (uint8_t)depth,
+	        .bound          = bound,
+	        .from           = best_move.from,
+	        .to             = best_move.to,
+	        .promotion_type = best_move.promotion_type,
+	    }
+	);
+
+	return maximum_value;
+}
+static void chess_search_insert_line(const ChessSearch *search, ChessSearchLine *lines, size_t *line_count, size_t maximum_line_count, ChessMove move, ChessScore score) {
+	assert(search != CHESS_NULL);
+	assert(lines != CHESS_NULL);
+	assert(line_count != CHESS_NULL && *line_count <= maximum_line_count);
+	assert(maximum_line_count > 0);
+
+	// The lines are kept sorted by score, the worst one making room for a better one once they are all taken.
+	size_t index = *line_count < maximum_line_count ? (*line_count)++ : maximum_line_count - 1;
+	while (index > 0 && lines[index - 1].score < score) {
+		lines[index] = lines[index - 1];
+		index--;
+	}
+
+	ChessSearchLine *line = &lines[index];
+	line->score           = score;
+	line->moves[0]        = move;
+	line->move_count      = 1;
+	for (size_t i = 0; i < search->variation_lengths[1] && line->move_count < CHESS_SEARCH_MAXIMUM_DEPTH; i++) {
+		line->moves[line->move_count++] = search->variations[1][i];
+	}
+}
+static void chess_search_extend_line(const ChessSearch *search, const ChessPosition *position, ChessSearchLine *line, unsigned int depth) {
+	assert(search != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+	assert(line != CHESS_NULL);
+
+	// Variations end where a node returned the score of the table, so they are followed on through its best moves.
+	ChessPosition position_after_line = *position;
+	for (size_t i = 0; i < line->move_count; i++) {
+		chess_move_do_unchecked(&position_after_line, line->moves[i]);
+	}
+
+	while (line->move_count < depth) {
+		ChessTranspositionTableEntry entry;
+		if (!chess_transposition_table_probe(search->table, chess_position_hash(&position_after_line), &entry)) {
+			break;
+		}
+
+		// The best move of the entry is checked in constant time instead of being looked for among the generated moves.
+		ChessMove move;
+		if (!chess_move_new_if_pseudolegal(&position_after_line, entry.from, entry.to, entry.promotion_type, &move) ||
+		    !chess_move_do_if_legal(&position_after_line, move)) {
+			break;
+		}
+
+		line->moves[line->move_count++] = move;
+	}
+}
+ChessSearchResult chess_search(const ChessPosition *position, ChessSearchLimits limits) {
+	assert(chess_position_is_valid(position));
+	assert(limits.table == CHESS_NULL || chess_transposition_table_is_valid(limits.table));
+
+	ChessSearch search = {
+		.limits            = limits,
+		.start_time        = chess_clock_milliseconds(),
+		.nodes             = 0,
+		.is_stopped        = false,
+		.pawn_table        = chess_pawn_table_new(CHESS_SEARCH_PAWN_TABLE_SIZE),
+		.table             = limits.table,
+		.own_table         = chess_transposition_table_new(limits.table == CHESS_NULL ? CHESS_SEARCH_TRANSPOSITION_TABLE_SIZE : 0),
+		.accumulators      = CHESS_NULL,
+		.history           = { { 0 } },
+		.variations        = { { { 0 } } },
+		.variation_lengths = { 0 },
+		.statistics        = { 0 },
+		.keys              = { 0 },
+		.key_count         = 0,
+	};
+	if (search.table == CHESS_NULL) {
+		search.table = &search.own_table;
+	}
+
+	// Only the most recent keys of the game are kept, the older ones lying beyond the reach of the seventy-five-move rule.
+	if (limits.keys != CHESS_NULL) {
+		search.key_count = limits.key_count < CHESS_SEARCH_MAXIMUM_KEY_COUNT ? limits.key_count : CHESS_SEARCH_MAXIMUM_KEY_COUNT;
+		memcpy(search.keys, limits.keys + limits.key_count - search.key_count, search.key_count * sizeof(search.keys[0]));
+	}
+	search.keys[search.key_count] = chess_position_hash(position);
+
+	// Positions are copied rather than unmade, so each ply keeps its own accumulator and undoing a move is free.
+	if (limits.network != CHESS_NULL) {
+		search.accumulators = malloc((CHESS_SEARCH_MAXIMUM_DEPTH + 1) * chess_network_accumulator_size(limits.network) * sizeof(search.accumulators[0]));
+		if (search.accumulators != CHESS_NULL) {
+			chess_network_accumulator_refresh(limits.network, position, chess_search_accumulator(&search, 0));
+		}
+	}
+
+	ChessSearchResult result = {
+		.best_move = {
+		    .from                       = CHESS_SQUARE_NONE,
+		    .to                         = CHESS_SQUARE_NONE,
+		    .promotion_type             = CHESS_PIECE_TYPE_NONE,
+		    .captured_piece             = CHESS_PIECE_NONE,
+		    .previous_castling_rights   = position->castling_rights,
+		    .previous_en_passant_square = position->en_passant_square,
+		    .previous_half_move_clock   = position->half_move_clock,
+		},
+		.score      = CHESS_SCORE_DRAW,
+		.depth      = 0,
+		.nodes      = 0,
+		.time       = 0,
+		.lines      = { { 0 } },
+		.line_count = 0,
+		.statistics = { 0 },
+	};
+
+	ChessMoves moves = chess_moves_generate(position);
+	if (moves.count > 0) {
+		result.best_move = moves.moves[0];
+	}
+
+	size_t maximum_line_count = limits.line_count != 0 ? limits.line_count : 1;
+	if (maximum_line_count > CHESS_SEARCH_MAXIMUM_LINE_COUNT) {
+		maximum_line_count = CHESS_SEARCH_MAXIMUM_LINE_COUNT;
+	}
+	if (maximum_line_count > moves.count) {
+		maximum_line_count = moves.count;
+	}
+
+	unsigned int maximum_depth = limits.depth != 0 && limits.depth < CHESS_SEARCH_MAXIMUM_DEPTH ? limits.depth : CHESS_SEARCH_MAXIMUM_DEPTH;
+	for (unsigned int depth = 1; depth <= maximum_depth && moves.count > 0; depth++) {
+		if (chess_search_poll(&search)) {
+			break;
+		}
+
+		uint64_t iteration_start_time  = chess_clock_milliseconds();
+		uint64_t iteration_start_nodes = search.nodes;
+		search.statistics              = (ChessSearchStatistics){ .depth = depth };
+
+		// Once the lines are all taken, a move only enters them by beating the worst one, whose score bounds the window of
+		// the remaining moves, as the best score does with a single line.
+		ChessSearchLine lines[CHESS_SEARCH_MAXIMUM_LINE_COUNT];
+		size_t line_count = 0;
+		for (size_t i = 0; i < moves.count; i++) {
+			if (search.accumulators != CHESS_NULL) {
+				chess_network_accumulator_update(limits.network, position, moves.moves[i], chess_search_accumulator(&search, 0), chess_search_accumulator(&search, 1));
+			}
+
+			ChessScore alpha                  = line_count == maximum_line_count ? lines[line_count - 1].score : -CHESS_SCORE_INFINITE;
+
+			ChessPosition position_after_move = *position;
+			chess_move_do_unchecked(&position_after_move, moves.moves[i]);
+			ChessScore value = -chess_search_negamax(&search, &position_after_move, depth - 1, 1, -CHESS_SCORE_INFINITE, -alpha);
+			if (search.is_stopped) {
+				break;
+			}
+			if (value > alpha) {
+				chess_search_insert_line(&search, lines, &line_count, maximum_line_count, moves.moves[i], value);
+			}
+		}
+		if (search.is_stopped) {
+			break;
+		}
+
+		// The moves of the lines are searched first in the next iteration, in the order of their scores.
+		for (size_t i = 0; i < line_count; i++) {
+			size_t index = i;
+			while (moves.moves[index].from != lines[i].moves[0].from || moves.moves[index].to != lines[i].moves[0].to || moves.moves[index].promotion_type != lines[i].moves[0].promotion_type) {
+				index++;
+			}
+
+			ChessMove move     = moves.moves[index];
+			moves.moves[index] = moves.moves[i];
+			moves.moves[i]     = move;
+		}
+
+		for (size_t i = 0; i < line_count; i++) {
+			result.lines[i] = lines[i];
+			chess_search_extend_line(&search, position, &result.lines[i], depth);
+		}
+		result.line_count = line_count;
+		result.best_move  = lines[0].moves[0];
+		result.score      = lines[0].score;
+		result.depth      = depth;
+
+		// The nodes of the previous iteration are still those of the result, whose statistics are only updated now.
+		ChessSearchStatistics *statistics      = &search.statistics;
+		uint64_t time                          = chess_clock_milliseconds();
+		statistics->best_move                  = result.best_move;
+		statistics->score                      = result.score;
+		statistics->nodes                      = search.nodes - iteration_start_nodes;
+		statistics->effective_branching_factor = result.statistics.nodes != 0 ? (double)statistics->nodes / (double)result.statistics.nodes : 0.0;
+		statistics->time                       = time - iteration_start_time;
+		statistics->total_nodes                = search.nodes;
+		statistics->total_time                 = time - search.start_time;
+		statistics->nodes_per_second           = statistics->total_nodes * 1000U / (statistics->total_time != 0 ? statistics->total_time : 1);
+		result.statistics                      = *statistics;
+		if (limits.callback != CHESS_NULL) {
+			limits.callback(statistics, limits.callback_data);
+		}
+	}
+
+	result.nodes = search.nodes;
+	result.time  = chess_clock_milliseconds() - search.start_time;
+
+	chess_pawn_table_drop(&search.pawn_table);
+	chess_transposition_table_drop(&search.own_table);
+	free(search.accumulators);
+
+	return result;
+}
+ChessMove chess_position_best_move(const ChessPosition *position, unsigned int depth) {
+	assert(chess_position_is_valid(position));
+	assert(depth > 0);
+
+	return chess_search(position, (ChessSearchLimits){ .depth = depth }).best_move;
+}
@@ -0,0 +1,23 @@
+#ifndef CHESS_SQUARE_PRIVATE_H_INCLUDED
+#define CHESS_SQUARE_PRIVATE_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <chess/offset.h>
+#include <chess/square.h>
+
+#include <stdint.h>
+
+// Both tables are indexed by the difference between two squares plus 0x77, which on the 0x88 board tells the vector from
+// one square to the other apart from every other. The first holds the set of piece types that can attack along the
+// vector, a pawn for either color, and the second the direction of the line joining the squares, or 0 if there is none.
+extern const uint8_t chess_square_attacks[256];
+extern const ChessOffset chess_square_directions[256];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_SQUARE_PRIVATE_H_INCLUDED
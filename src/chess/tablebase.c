@@ -0,0 +1,835 @@
+#include <chess/tablebase.h>
+
+#include <chess/castling_rights.h>
+#include <chess/color.h>
+#include <chess/file.h>
+#include <chess/mapping.h>
+#include <chess/move.h>
+#include <chess/move_private.h>
+#include <chess/moves.h>
+#include <chess/piece_type.h>
+#include <chess/position.h>
+#include <chess/position_private.h>
+#include <chess/rank.h>
+#include <chess/square.h>
+#include <chess/unmoves.h>
+
+#include <assert.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint8_t, CHESS_TABLEBASE_VERSION, 1);
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_TABLEBASE_HEADER_SIZE, 16);
+
+// Values are from the perspective of the side to move: a draw, a mate in 1 to 126 moves, or getting mated in 0 to 125
+// moves offset by `CHESS_TABLEBASE_VALUE_LOSS`. Unknown values only exist while a table is generated.
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint8_t, CHESS_TABLEBASE_VALUE_DRAW, 0);
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint8_t, CHESS_TABLEBASE_VALUE_MAXIMUM_WIN, 126);
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint8_t, CHESS_TABLEBASE_VALUE_LOSS, 128);
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint8_t, CHESS_TABLEBASE_VALUE_MAXIMUM_LOSS, 253);
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint8_t, CHESS_TABLEBASE_VALUE_UNKNOWN, 254);
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint8_t, CHESS_TABLEBASE_VALUE_INVALID, 255);
+
+// Marks the positions with children whose values are only found by looking at their own children, which are evaluated
+// forwards while a table is generated.
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint8_t, CHESS_TABLEBASE_CHILD_COUNT_FORWARD, 255);
+
+typedef struct ChessTablebaseMaterial {
+	uint8_t piece_counts[CHESS_COLOR_BLACK + 1][CHESS_PIECE_TYPE_KING + 1];
+} ChessTablebaseMaterial;
+
+// The White king is mirrored into the a1-d1-d4 triangle without pawns, and onto the queenside with them.
+static CHESS_CONSTEXPR size_t chess_tablebase_king_slot_counts[2] = { 10, 32 };
+static CHESS_CONSTEXPR uint8_t chess_tablebase_king_slots[2][64]  = {
+    {
+        0,   1,   2,   3,   255, 255, 255, 255,
+        255, 4,   5,   6,   255, 255, 255, 255,
+        255, 255, 7,   8,   255, 255, 255, 255,
+        255, 255, 255, 9,   255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+    },
+    {
+        0,  1,  2,  3,  255, 255, 255, 255,
+        4,  5,  6,  7,  255, 255, 255, 255,
+        8,  9,  10, 11, 255, 255, 255, 255,
+        12, 13, 14, 15, 255, 255, 255, 255,
+        16, 17, 18, 19, 255, 255, 255, 255,
+        20, 21, 22, 23, 255, 255, 255, 255,
+        24, 25, 26, 27, 255, 255, 255, 255,
+        28, 29, 30, 31, 255, 255, 255, 255,
+    },
+};
+static CHESS_CONSTEXPR uint8_t chess_tablebase_king_squares[2][32] = {
+	{ 0, 1, 2, 3, 9, 10, 11, 18, 19, 27 },
+	{ 0, 1, 2, 3, 8, 9, 10, 11, 16, 17, 18, 19, 24, 25, 26, 27, 32, 33, 34, 35, 40, 41, 42, 43, 48, 49, 50, 51, 56, 57, 58, 59 },
+};
+
+static bool chess_tablebase_has_pawns(const ChessPiece *pieces, size_t piece_count) {
+	assert(pieces != CHESS_NULL);
+
+	for (size_t i = 0; i < piece_count; i++) {
+		if (chess_piece_type(pieces[i]) == CHESS_PIECE_TYPE_PAWN) {
+			return true;
+		}
+	}
+
+	return false;
+}
+static size_t chess_tablebase_value_count(const ChessPiece *pieces, size_t piece_count) {
+	assert(pieces != CHESS_NULL);
+	assert(2 <= piece_count && piece_count <= CHESS_TABLEBASE_MAXIMUM_PIECE_COUNT);
+
+	size_t value_count = chess_tablebase_king_slot_counts[chess_tablebase_has_pawns(pieces, piece_count)] * 2;
+	for (size_t i = 1; i < piece_count; i++) {
+		value_count *= 64;
+	}
+
+	return value_count;
+}
+static bool chess_tablebase_is_flipped(const ChessTablebaseMaterial *material) {
+	assert(material != CHESS_NULL);
+
+	unsigned int counts[CHESS_COLOR_BLACK + 1] = { 0 };
+	for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
+		for (ChessPieceType type = CHESS_PIECE_TYPE_PAWN; type <= CHESS_PIECE_TYPE_KING; type++) {
+			counts[color] += material->piece_counts[color][type];
+		}
+	}
+
+	if (counts[CHESS_COLOR_WHITE] != counts[CHESS_COLOR_BLACK]) {
+		return counts[CHESS_COLOR_BLACK] > counts[CHESS_COLOR_WHITE];
+	}
+
+	for (ChessPieceType type = CHESS_PIECE_TYPE_QUEEN + 1; type-- > CHESS_PIECE_TYPE_PAWN;) {
+		if (material->piece_counts[CHESS_COLOR_WHITE][type] != material->piece_counts[CHESS_COLOR_BLACK][type]) {
+			return material->piece_counts[CHESS_COLOR_BLACK][type] > material->piece_counts[CHESS_COLOR_WHITE][type];
+		}
+	}
+
+	return false;
+}
+static size_t chess_tablebase_pieces(const ChessTablebaseMaterial *material, bool is_flipped, ChessPiece pieces[CHESS_TABLEBASE_MAXIMUM_PIECE_COUNT]) {
+	assert(material != CHESS_NULL);
+	assert(pieces != CHESS_NULL);
+
+	size_t piece_count = 0;
+	for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
+		if (piece_count < CHESS_TABLEBASE_MAXIMUM_PIECE_COUNT) {
+			pieces[piece_count++] = chess_piece_new(color, CHESS_PIECE_TYPE_KING);
+		}
+	}
+	for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
+		ChessColor position_color = is_flipped ? chess_color_opposite(color) : color;
+		for (ChessPieceType type = CHESS_PIECE_TYPE_QUEEN + 1; type-- > CHESS_PIECE_TYPE_PAWN;) {
+			for (size_t i = 0; i < material->piece_counts[position_color][type]; i++) {
+				if (piece_count == CHESS_TABLEBASE_MAXIMUM_PIECE_COUNT) {
+					return piece_count + 1;
+				}
+				pieces[piece_count++] = chess_piece_new(color, type);
+			}
+		}
+	}
+
+	return piece_count;
+}
+static const ChessTablebaseTable *chess_tablebase_find(const ChessTablebase *tablebase, const ChessPiece *pieces, size_t piece_count) {
+	assert(tablebase != CHESS_NULL);
+	assert(pieces != CHESS_NULL);
+
+	for (size_t i = 0; i < tablebase->table_count; i++) {
+		const ChessTablebaseTable *table = &tablebase->tables[i];
+		if (table->piece_count == piece_count && memcmp(table->pieces, pieces, piece_count * sizeof(pieces[0])) == 0) {
+			return table;
+		}
+	}
+
+	return CHESS_NULL;
+}
+static size_t chess_tablebase_index_squares(const ChessTablebaseTable *table, const uint8_t *squares, bool is_file_flipped, bool is_rank_flipped, bool is_transposed) {
+	assert(table != CHESS_NULL);
+	assert(squares != CHESS_NULL);
+
+	bool has_pawns = chess_tablebase_has_pawns(table->pieces, table->piece_count);
+
+	uint8_t transformed_squares[CHESS_TABLEBASE_MAXIMUM_PIECE_COUNT] = { 0 };
+	for (size_t i = 0; i < table->piece_count; i++) {
+		unsigned int file = squares[i] % 8U;
+		unsigned int rank = squares[i] / 8U;
+		if (is_file_flipped) {
+			file = 7 - file;
+		}
+		if (is_rank_flipped) {
+			rank = 7 - rank;
+		}
+		transformed_squares[i] = (uint8_t)(is_transposed ? file * 8 + rank : rank * 8 + file);
+
+		// Identical pieces are ordered by square, so that swapping them leaves the index unchanged.
+		for (size_t j = i; j > 0 && table->pieces[j - 1] == table->pieces[j] && transformed_squares[j - 1] > transformed_squares[j]; j--) {
+			uint8_t square             = transformed_squares[j];
+			transformed_squares[j]     = transformed_squares[j - 1];
+			transformed_squares[j - 1] = square;
+		}
+	}
+
+	size_t index = chess_tablebase_king_slots[has_pawns][transformed_squares[0]];
+	for (size_t i = 1; i < table->piece_count; i++) {
+		index = index * 64 + transformed_squares[i];
+	}
+
+	return index;
+}
+static size_t chess_tablebase_index(const ChessTablebaseTable *table, const ChessPosition *position, bool is_flipped) {
+	assert(table != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+
+	uint8_t squares[CHESS_TABLEBASE_MAXIMUM_PIECE_COUNT]                  = { 0 };
+	uint8_t piece_indices[CHESS_COLOR_BLACK + 1][CHESS_PIECE_TYPE_KING + 1] = { { 0 } };
+	for (size_t i = 0; i < table->piece_count; i++) {
+		ChessColor color    = chess_piece_color(table->pieces[i]);
+		ChessPieceType type = chess_piece_type(table->pieces[i]);
+
+		ChessSquare square  = position->pieces[is_flipped ? chess_color_opposite(color) : color][type][piece_indices[color][type]++];
+		ChessRank rank      = chess_square_rank(square);
+		squares[i]          = (uint8_t)((is_flipped ? CHESS_RANK_8 - rank : rank) * 8 + chess_square_file(square));
+	}
+
+	bool has_pawns         = chess_tablebase_has_pawns(table->pieces, table->piece_count);
+
+	unsigned int king_file = squares[0] % 8U;
+	unsigned int king_rank = squares[0] / 8U;
+	bool is_file_flipped   = king_file > 3;
+	bool is_rank_flipped   = !has_pawns && king_rank > 3;
+	if (is_file_flipped) {
+		king_file = 7 - king_file;
+	}
+	if (is_rank_flipped) {
+		king_rank = 7 - king_rank;
+	}
+
+	// Symmetric positions share their index, so with the king on the diagonal the smaller index of the position and its
+	// transposition is taken.
+	size_t index = chess_tablebase_index_squares(table, squares, is_file_flipped, is_rank_flipped, !has_pawns && king_rank > king_file);
+	if (!has_pawns && king_rank == king_file) {
+		size_t transposed_index = chess_tablebase_index_squares(table, squares, is_file_flipped, is_rank_flipped, true);
+		if (transposed_index < index) {
+			index = transposed_index;
+		}
+	}
+
+	ChessColor side_to_move = is_flipped ? chess_color_opposite(position->side_to_move) : position->side_to_move;
+
+	return index * 2 + side_to_move;
+}
+static bool chess_tablebase_position(const ChessTablebaseTable *table, size_t index, ChessPosition *position) {
+	assert(table != CHESS_NULL);
+	assert(index < table->value_count);
+	assert(position != CHESS_NULL);
+
+	bool has_pawns = chess_tablebase_has_pawns(table->pieces, table->piece_count);
+
+	chess_position_clear_board(position);
+	position->side_to_move      = (ChessColor)(index % 2);
+	position->castling_rights   = CHESS_CASTLING_RIGHTS_NONE;
+	position->en_passant_square = CHESS_SQUARE_NONE;
+	position->half_move_clock   = 0;
+	position->full_move_number  = 1;
+	index /= 2;
+
+	for (size_t i = table->piece_count; i-- > 0;) {
+		uint8_t square = i == 0 ? chess_tablebase_king_squares[has_pawns][index] : (uint8_t)(index % 64);
+		index /= 64;
+
+		ChessFile file = (ChessFile)(square % 8U);
+		ChessRank rank = (ChessRank)(square / 8U);
+		if (chess_piece_type(table->pieces[i]) == CHESS_PIECE_TYPE_PAWN && (rank == CHESS_RANK_1 || rank == CHESS_RANK_8)) {
+			return false;
+		}
+
+		ChessSquare board_square = chess_square_new(file, rank);
+		if (position->board[board_square] != CHESS_PIECE_NONE) {
+			return false;
+		}
+		chess_position_place_piece(position, table->pieces[i], board_square);
+	}
+
+	return !chess_position_is_king_attacked(position, chess_color_opposite(position->side_to_move));
+}
+static uint8_t chess_tablebase_value_from_moves(const ChessTablebase *tablebase, const ChessPosition *position, unsigned int maximum_win);
+static uint8_t chess_tablebase_value(const ChessTablebase *tablebase, const ChessPosition *position, unsigned int maximum_win) {
+	assert(tablebase != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+
+	if (position->castling_rights != CHESS_CASTLING_RIGHTS_NONE) {
+		return CHESS_TABLEBASE_VALUE_UNKNOWN;
+	}
+
+	size_t piece_count = 0;
+	for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
+		for (ChessPieceType type = CHESS_PIECE_TYPE_PAWN; type <= CHESS_PIECE_TYPE_KING; type++) {
+			piece_count += position->piece_counts[color][type];
+		}
+	}
+	if (piece_count == 2) {
+		return CHESS_TABLEBASE_VALUE_DRAW;
+	}
+	if (piece_count > tablebase->maximum_piece_count) {
+		return CHESS_TABLEBASE_VALUE_UNKNOWN;
+	}
+
+	// Positions are stored without en passant squares, so the captures they allow are looked at directly.
+	if (position->en_passant_square != CHESS_SQUARE_NONE) {
+		return chess_tablebase_value_from_moves(tablebase, position, maximum_win);
+	}
+
+	ChessTablebaseMaterial material;
+	memcpy(material.piece_counts, position->piece_counts, sizeof(material.piece_counts));
+
+	ChessPiece pieces[CHESS_TABLEBASE_MAXIMUM_PIECE_COUNT];
+	bool is_flipped                  = chess_tablebase_is_flipped(&material);
+	size_t material_piece_count      = chess_tablebase_pieces(&material, is_flipped, pieces);
+
+	const ChessTablebaseTable *table = chess_tablebase_find(tablebase, pieces, material_piece_count);
+	if (table == CHESS_NULL) {
+		return CHESS_TABLEBASE_VALUE_UNKNOWN;
+	}
+
+	return table->values[chess_tablebase_index(table, position, is_flipped)];
+}
+static uint8_t chess_tablebase_value_from_moves(const ChessTablebase *tablebase, const ChessPosition *position, unsigned int maximum_win) {
+	assert(tablebase != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+
+	ChessMoves moves = chess_moves_generate(position);
+	if (moves.count == 0) {
+		return chess_position_is_check(position) ? CHESS_TABLEBASE_VALUE_LOSS : CHESS_TABLEBASE_VALUE_DRAW;
+	}
+
+	unsigned int win  = UINT_MAX;
+	unsigned int loss = 0;
+	bool is_loss      = true;
+	bool is_unknown   = false;
+	for (size_t i = 0; i < moves.count; i++) {
+		ChessPosition position_after_move = *position;
+		chess_move_do_unchecked(&position_after_move, moves.moves[i]);
+
+		uint8_t value = chess_tablebase_value(tablebase, &position_after_move, maximum_win);
+		if (value == CHESS_TABLEBASE_VALUE_UNKNOWN || value == CHESS_TABLEBASE_VALUE_INVALID) {
+			is_unknown = true;
+			is_loss    = false;
+		} else if (value >= CHESS_TABLEBASE_VALUE_LOSS) {
+			if (value - CHESS_TABLEBASE_VALUE_LOSS + 1U < win) {
+				win = value - CHESS_TABLEBASE_VALUE_LOSS + 1U;
+			}
+			is_loss = false;
+		} else if (value == CHESS_TABLEBASE_VALUE_DRAW) {
+			is_loss = false;
+		} else if (value > loss) {
+			loss = value;
+		}
+	}
+
+	// A win is only certain once every shorter loss of the opponent is known, which the generator guarantees up to
+	// `maximum_win` moves.
+	if (win <= maximum_win && win <= CHESS_TABLEBASE_VALUE_MAXIMUM_WIN) {
+		return (uint8_t)win;
+	}
+	if (is_loss && CHESS_TABLEBASE_VALUE_LOSS + loss <= CHESS_TABLEBASE_VALUE_MAXIMUM_LOSS) {
+		return (uint8_t)(CHESS_TABLEBASE_VALUE_LOSS + loss);
+	}
+
+	return is_unknown || win != UINT_MAX || is_loss ? CHESS_TABLEBASE_VALUE_UNKNOWN : CHESS_TABLEBASE_VALUE_DRAW;
+}
+static void chess_tablebase_update_maximum_piece_count(ChessTablebase *tablebase) {
+	assert(tablebase != CHESS_NULL);
+
+	tablebase->maximum_piece_count = 0;
+	for (size_t i = 0; i < tablebase->table_count; i++) {
+		if (tablebase->tables[i].piece_count > tablebase->maximum_piece_count) {
+			tablebase->maximum_piece_count = tablebase->tables[i].piece_count;
+		}
+	}
+}
+bool chess_tablebase_is_valid(const ChessTablebase *tablebase) {
+	if (tablebase == CHESS_NULL || tablebase->table_count > CHESS_TABLEBASE_MAXIMUM_TABLE_COUNT) {
+		return false;
+	}
+
+	size_t maximum_piece_count = 0;
+	for (size_t i = 0; i < tablebase->table_count; i++) {
+		const ChessTablebaseTable *table = &tablebase->tables[i];
+		if (table->piece_count <= 2 || table->piece_count > CHESS_TABLEBASE_MAXIMUM_PIECE_COUNT || table->values == CHESS_NULL ||
+		    table->value_count != chess_tablebase_value_count(table->pieces, table->piece_count)) {
+			return false;
+		}
+
+		if (table->piece_count > maximum_piece_count) {
+			maximum_piece_count = table->piece_count;
+		}
+	}
+
+	return tablebase->maximum_piece_count == maximum_piece_count;
+}
+ChessTablebase chess_tablebase_new(void) {
+	return (ChessTablebase){
+		.tables              = { { .pieces = { 0 } } },
+		.table_count         = 0,
+		.maximum_piece_count = 0,
+	};
+}
+void chess_tablebase_drop(ChessTablebase *tablebase) {
+	assert(chess_tablebase_is_valid(tablebase));
+
+	for (size_t i = 0; i < tablebase->table_count; i++) {
+		if (tablebase->tables[i].mapping != CHESS_NULL) {
+			chess_mapping_unmap(tablebase->tables[i].mapping, tablebase->tables[i].mapping_size);
+		}
+	}
+
+	tablebase->table_count         = 0;
+	tablebase->maximum_piece_count = 0;
+}
+bool chess_tablebase_load(ChessTablebase *tablebase, const char *path) {
+	assert(chess_tablebase_is_valid(tablebase));
+	assert(path != CHESS_NULL);
+
+	if (tablebase->table_count == CHESS_TABLEBASE_MAXIMUM_TABLE_COUNT) {
+		return false;
+	}
+
+	size_t mapping_size = 0;
+	void *mapping       = chess_mapping_map(path, &mapping_size);
+	if (mapping == CHESS_NULL) {
+		return false;
+	}
+
+	if (mapping_size < CHESS_TABLEBASE_HEADER_SIZE) {
+		chess_mapping_unmap(mapping, mapping_size);
+		return false;
+	}
+
+	const uint8_t *bytes      = mapping;
+	ChessTablebaseTable table = {
+		.pieces       = { 0 },
+		.piece_count  = bytes[5],
+		.values       = bytes + CHESS_TABLEBASE_HEADER_SIZE,
+		.value_count  = mapping_size - CHESS_TABLEBASE_HEADER_SIZE,
+		.mapping      = mapping,
+		.mapping_size = mapping_size,
+	};
+
+	bool is_successful = memcmp(bytes, "CHTB", 4) == 0 && bytes[4] == CHESS_TABLEBASE_VERSION &&
+	                     2 < table.piece_count && table.piece_count <= CHESS_TABLEBASE_MAXIMUM_PIECE_COUNT;
+
+	// The pieces must be the canonical material, so that probes of positions with that material find the table.
+	ChessTablebaseMaterial material = { .piece_counts = { { 0 } } };
+	for (size_t i = 0; is_successful && i < table.piece_count; i++) {
+		table.pieces[i] = bytes[6 + i];
+		is_successful   = chess_piece_is_valid(table.pieces[i]);
+		if (is_successful) {
+			material.piece_counts[chess_piece_color(table.pieces[i])][chess_piece_type(table.pieces[i])]++;
+		}
+	}
+
+	ChessPiece pieces[CHESS_TABLEBASE_MAXIMUM_PIECE_COUNT];
+	is_successful = is_successful &&
+	                !chess_tablebase_is_flipped(&material) &&
+	                chess_tablebase_pieces(&material, false, pieces) == table.piece_count &&
+	                memcmp(pieces, table.pieces, table.piece_count * sizeof(pieces[0])) == 0 &&
+	                table.value_count == chess_tablebase_value_count(table.pieces, table.piece_count) &&
+	                chess_tablebase_find(tablebase, table.pieces, table.piece_count) == CHESS_NULL;
+
+	if (!is_successful) {
+		chess_mapping_unmap(mapping, mapping_size);
+		return false;
+	}
+
+	tablebase->tables[tablebase->table_count++] = table;
+	chess_tablebase_update_maximum_piece_count(tablebase);
+
+	return true;
+}
+static bool chess_tablebase_material_from_string(ChessTablebaseMaterial *material, const char *string) {
+	assert(material != CHESS_NULL);
+	assert(string != CHESS_NULL);
+
+	static CHESS_CONSTEXPR char piece_type_letters[] = "PNBRQK";
+
+	memset(material->piece_counts, 0, sizeof(material->piece_counts));
+
+	size_t piece_count = 0;
+	ChessColor color   = CHESS_COLOR_WHITE;
+	for (size_t i = 0; string[i] != '\0'; i++) {
+		if (string[i] == 'v' && color == CHESS_COLOR_WHITE) {
+			color = CHESS_COLOR_BLACK;
+			continue;
+		}
+
+		const char *letter = strchr(piece_type_letters, string[i]);
+		if (letter == CHESS_NULL || *letter == '\0' || ++piece_count > CHESS_TABLEBASE_MAXIMUM_PIECE_COUNT) {
+			return false;
+		}
+		material->piece_counts[color][letter - piece_type_letters]++;
+	}
+
+	return color == CHESS_COLOR_BLACK &&
+	       material->piece_counts[CHESS_COLOR_WHITE][CHESS_PIECE_TYPE_KING] == 1 &&
+	       material->piece_counts[CHESS_COLOR_BLACK][CHESS_PIECE_TYPE_KING] == 1;
+}
+static void chess_tablebase_material_to_string(const ChessPiece *pieces, size_t piece_count, char *string) {
+	assert(pieces != CHESS_NULL);
+	assert(string != CHESS_NULL);
+
+	static CHESS_CONSTEXPR char piece_type_letters[] = "PNBRQK";
+
+	size_t length                                    = 0;
+	for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
+		if (color == CHESS_COLOR_BLACK) {
+			string[length++] = 'v';
+		}
+		for (size_t i = 0; i < piece_count; i++) {
+			if (chess_piece_color(pieces[i]) == color) {
+				string[length++] = piece_type_letters[chess_piece_type(pieces[i])];
+			}
+		}
+	}
+	string[length] = '\0';
+}
+static bool chess_tablebase_write(const char *path, const ChessTablebaseTable *table) {
+	assert(path != CHESS_NULL);
+	assert(table != CHESS_NULL);
+
+	uint8_t header[CHESS_TABLEBASE_HEADER_SIZE] = { 'C', 'H', 'T', 'B', CHESS_TABLEBASE_VERSION, (uint8_t)table->piece_count };
+	for (size_t i = 0; i < table->piece_count; i++) {
+		header[6 + i] = table->pieces[i];
+	}
+
+	FILE *file = fopen(path, "wb");
+	if (file == CHESS_NULL) {
+		return false;
+	}
+
+	bool is_successful = fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+	                     fwrite(table->values, 1, table->value_count, file) == table->value_count;
+	is_successful      = fclose(file) == 0 && is_successful;
+
+	if (!is_successful) {
+		remove(path);
+	}
+
+	return is_successful;
+}
+// Every loss can make the positions leading to it won one move later, so generating goes on at least until then.
+static void chess_tablebase_update_horizon(unsigned int *horizon, uint8_t value) {
+	assert(horizon != CHESS_NULL);
+
+	if (CHESS_TABLEBASE_VALUE_LOSS <= value && value <= CHESS_TABLEBASE_VALUE_MAXIMUM_LOSS && value - CHESS_TABLEBASE_VALUE_LOSS + 1U > *horizon) {
+		*horizon = value - CHESS_TABLEBASE_VALUE_LOSS + 1U;
+	}
+}
+static size_t chess_tablebase_parents(const ChessTablebaseTable *table, const ChessPosition *position, size_t *parents) {
+	assert(table != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+	assert(parents != CHESS_NULL);
+
+	ChessUnmoves unmoves = chess_unmoves_generate_quiet(position);
+
+	size_t parent_count  = 0;
+	for (size_t i = 0; i < unmoves.count; i++) {
+		if (unmoves.unmoves[i].previous_en_passant_square != CHESS_SQUARE_NONE) {
+			continue;
+		}
+
+		ChessPosition position_before_move = *position;
+		chess_move_undo_unchecked(&position_before_move, unmoves.unmoves[i]);
+		size_t parent = chess_tablebase_index(table, &position_before_move, false);
+
+		size_t j      = 0;
+		while (j < parent_count && parents[j] != parent) {
+			j++;
+		}
+		if (j == parent_count) {
+			parents[parent_count++] = parent;
+		}
+	}
+
+	return parent_count;
+}
+static bool chess_tablebase_generate_table(ChessTablebase *tablebase, const ChessPiece *pieces, size_t piece_count, const char *path) {
+	assert(chess_tablebase_is_valid(tablebase));
+	assert(pieces != CHESS_NULL);
+	assert(path != CHESS_NULL);
+
+	if (tablebase->table_count == CHESS_TABLEBASE_MAXIMUM_TABLE_COUNT) {
+		return false;
+	}
+
+	// Besides its value, each position keeps the number of its children in this table which are not yet known to be won
+	// for the opponent, and the shortest mate it has through a smaller table.
+	size_t value_count     = chess_tablebase_value_count(pieces, piece_count);
+	uint8_t *values        = malloc(value_count);
+	uint8_t *child_counts  = malloc(value_count);
+	uint8_t *shortest_wins = malloc(value_count);
+	size_t *indices        = malloc(CHESS_UNMOVES_MAXIMUM_COUNT * sizeof(indices[0]));
+	if (values == CHESS_NULL || child_counts == CHESS_NULL || shortest_wins == CHESS_NULL || indices == CHESS_NULL) {
+		free(values);
+		free(child_counts);
+		free(shortest_wins);
+		free(indices);
+		return false;
+	}
+	memset(values, CHESS_TABLEBASE_VALUE_UNKNOWN, value_count);
+	memset(shortest_wins, 0, value_count);
+
+	ChessTablebaseTable *table = &tablebase->tables[tablebase->table_count++];
+	*table                     = (ChessTablebaseTable){
+		.pieces       = { 0 },
+		.piece_count  = piece_count,
+		.values       = values,
+		.value_count  = value_count,
+		.mapping      = CHESS_NULL,
+		.mapping_size = 0,
+	};
+	memcpy(table->pieces, pieces, piece_count * sizeof(pieces[0]));
+	chess_tablebase_update_maximum_piece_count(tablebase);
+
+	ChessPosition position = {
+		.side_to_move      = CHESS_COLOR_WHITE,
+		.castling_rights   = CHESS_CASTLING_RIGHTS_NONE,
+		.en_passant_square = CHESS_SQUARE_NONE,
+	};
+
+	// Mates and stalemates are known right away, as are the children in smaller tables. A child with an en passant
+	// square is not stored but evaluated through its own children, which can lie in this table, so a position with one
+	// whose value is not known yet is evaluated forwards on every pass instead.
+	unsigned int horizon = 0;
+	for (size_t i = 0; i < value_count; i++) {
+		if (!chess_tablebase_position(table, i, &position) || chess_tablebase_index(table, &position, false) != i) {
+			values[i] = CHESS_TABLEBASE_VALUE_INVALID;
+			continue;
+		}
+
+		ChessMoves moves = chess_moves_generate(&position);
+		if (moves.count == 0) {
+			values[i] = chess_position_is_check(&position) ? CHESS_TABLEBASE_VALUE_LOSS : CHESS_TABLEBASE_VALUE_DRAW;
+			chess_tablebase_update_horizon(&horizon, values[i]);
+			continue;
+		}
+
+		size_t child_count = 0;
+		bool is_drawn      = false;
+		bool is_forward    = false;
+		for (size_t j = 0; j < moves.count; j++) {
+			ChessPosition position_after_move = position;
+			chess_move_do_unchecked(&position_after_move, moves.moves[j]);
+
+			if (moves.moves[j].captured_piece == CHESS_PIECE_NONE && moves.moves[j].promotion_type == CHESS_PIECE_TYPE_NONE &&
+			    position_after_move.en_passant_square == CHESS_SQUARE_NONE) {
+				indices[child_count++] = chess_tablebase_index(table, &position_after_move, false);
+				for (size_t k = 0; k + 1 < child_count; k++) {
+					if (indices[k] == indices[child_count - 1]) {
+						child_count--;
+						break;
+					}
+				}
+				continue;
+			}
+
+			uint8_t value = chess_tablebase_value(tablebase, &position_after_move, 0);
+			if (value == CHESS_TABLEBASE_VALUE_UNKNOWN || value == CHESS_TABLEBASE_VALUE_INVALID) {
+				is_forward = true;
+			} else if (value >= CHESS_TABLEBASE_VALUE_LOSS) {
+				unsigned int win = value - CHESS_TABLEBASE_VALUE_LOSS + 1U;
+				if (shortest_wins[i] == 0 || win < shortest_wins[i]) {
+					shortest_wins[i] = (uint8_t)win;
+				}
+				if (win > horizon) {
+					horizon = win;
+				}
+			} else if (value == CHESS_TABLEBASE_VALUE_DRAW) {
+				is_drawn = true;
+			}
+		}
+
+		// A drawn child is never won for the opponent, so it is counted without ever being counted off.
+		child_counts[i] = is_forward ? CHESS_TABLEBASE_CHILD_COUNT_FORWARD : (uint8_t)(child_count + is_drawn);
+		if (child_counts[i] == 0 && shortest_wins[i] == 0) {
+			values[i] = chess_tablebase_value_from_moves(tablebase, &position, UINT_MAX);
+			chess_tablebase_update_horizon(&horizon, values[i]);
+		}
+	}
+
+	// Pass `n` finds the mates in `n` moves from the positions getting mated in `n - 1` moves, then counts them off the
+	// children of their parents. A parent whose children are all won for the opponent is lost, in as many moves as the
+	// longest of those wins, which is never shorter than `n`.
+	for (unsigned int maximum_win = 1; maximum_win <= CHESS_TABLEBASE_VALUE_MAXIMUM_WIN; maximum_win++) {
+		bool is_changed = false;
+
+		for (size_t i = 0; i < value_count; i++) {
+			if (values[i] == CHESS_TABLEBASE_VALUE_LOSS + maximum_win - 1) {
+				chess_tablebase_position(table, i, &position);
+				size_t parent_count = chess_tablebase_parents(table, &position, indices);
+				for (size_t j = 0; j < parent_count; j++) {
+					if (values[indices[j]] == CHESS_TABLEBASE_VALUE_UNKNOWN) {
+						values[indices[j]] = (uint8_t)maximum_win;
+						is_changed         = true;
+					}
+				}
+			} else if (values[i] == CHESS_TABLEBASE_VALUE_UNKNOWN && shortest_wins[i] == maximum_win) {
+				values[i]  = (uint8_t)maximum_win;
+				is_changed = true;
+			}
+		}
+
+		for (bool is_forward_changed = true; is_forward_changed;) {
+			is_forward_changed = false;
+			for (size_t i = 0; i < value_count; i++) {
+				if (values[i] != CHESS_TABLEBASE_VALUE_UNKNOWN || child_counts[i] != CHESS_TABLEBASE_CHILD_COUNT_FORWARD) {
+					continue;
+				}
+
+				chess_tablebase_position(table, i, &position);
+				uint8_t value = chess_tablebase_value_from_moves(tablebase, &position, maximum_win);
+				if (value != CHESS_TABLEBASE_VALUE_UNKNOWN) {
+					values[i]          = value;
+					is_forward_changed = true;
+					chess_tablebase_update_horizon(&horizon, value);
+				}
+			}
+			is_changed = is_changed || is_forward_changed;
+		}
+
+		for (size_t i = 0; i < value_count; i++) {
+			if (values[i] != maximum_win) {
+				continue;
+			}
+
+			chess_tablebase_position(table, i, &position);
+			size_t parent_count = chess_tablebase_parents(table, &position, indices);
+			for (size_t j = 0; j < parent_count; j++) {
+				size_t parent = indices[j];
+				if (values[parent] != CHESS_TABLEBASE_VALUE_UNKNOWN || child_counts[parent] == CHESS_TABLEBASE_CHILD_COUNT_FORWARD ||
+				    child_counts[parent] == 0 || --child_counts[parent] != 0 || shortest_wins[parent] != 0) {
+					continue;
+				}
+
+				ChessPosition parent_position = position;
+				chess_tablebase_position(table, parent, &parent_position);
+				values[parent] = chess_tablebase_value_from_moves(tablebase, &parent_position, UINT_MAX);
+				is_changed     = true;
+				chess_tablebase_update_horizon(&horizon, values[parent]);
+			}
+		}
+
+		if (!is_changed && maximum_win >= horizon) {
+			break;
+		}
+	}
+
+	for (size_t i = 0; i < value_count; i++) {
+		if (values[i] == CHESS_TABLEBASE_VALUE_UNKNOWN) {
+			values[i] = CHESS_TABLEBASE_VALUE_DRAW;
+		}
+	}
+
+	bool is_successful = chess_tablebase_write(path, table);
+
+	tablebase->table_count--;
+	chess_tablebase_update_maximum_piece_count(tablebase);
+	free(values);
+	free(child_counts);
+	free(shortest_wins);
+	free(indices);
+
+	return is_successful && chess_tablebase_load(tablebase, path);
+}
+static bool chess_tablebase_generate_material(ChessTablebase *tablebase, const char *directory, const ChessTablebaseMaterial *material) {
+	assert(chess_tablebase_is_valid(tablebase));
+	assert(directory != CHESS_NULL);
+	assert(material != CHESS_NULL);
+
+	ChessPiece pieces[CHESS_TABLEBASE_MAXIMUM_PIECE_COUNT];
+	size_t piece_count = chess_tablebase_pieces(material, chess_tablebase_is_flipped(material), pieces);
+	if (piece_count > CHESS_TABLEBASE_MAXIMUM_PIECE_COUNT) {
+		return false;
+	}
+	if (piece_count == 2 || chess_tablebase_find(tablebase, pieces, piece_count) != CHESS_NULL) {
+		return true;
+	}
+
+	char name[CHESS_TABLEBASE_MAXIMUM_MATERIAL_LENGTH + 1];
+	chess_tablebase_material_to_string(pieces, piece_count, name);
+
+	char path[FILENAME_MAX];
+	int length = snprintf(path, sizeof(path), "%s/%s.ctb", directory, name);
+	if (length < 0 || (size_t)length >= sizeof(path)) {
+		return false;
+	}
+
+	if (chess_tablebase_load(tablebase, path)) {
+		return true;
+	}
+
+	// Every capture and promotion leads into another table, which must be complete before this one is generated.
+	for (ChessColor color = CHESS_COLOR_WHITE; color <= CHESS_COLOR_BLACK; color++) {
+		for (ChessPieceType type = CHESS_PIECE_TYPE_PAWN; type < CHESS_PIECE_TYPE_KING; type++) {
+			if (material->piece_counts[color][type] == 0) {
+				continue;
+			}
+
+			ChessTablebaseMaterial next_material = *material;
+			next_material.piece_counts[color][type]--;
+			if (!chess_tablebase_generate_material(tablebase, directory, &next_material)) {
+				return false;
+			}
+
+			if (type == CHESS_PIECE_TYPE_PAWN) {
+				for (ChessPieceType promotion_type = CHESS_PIECE_TYPE_KNIGHT; promotion_type <= CHESS_PIECE_TYPE_QUEEN; promotion_type++) {
+					next_material.piece_counts[color][promotion_type]++;
+					if (!chess_tablebase_generate_material(tablebase, directory, &next_material)) {
+						return false;
+					}
+					next_material.piece_counts[color][promotion_type]--;
+				}
+			}
+		}
+	}
+
+	return chess_tablebase_generate_table(tablebase, pieces, piece_count, path);
+}
+bool chess_tablebase_generate(ChessTablebase *tablebase, const char *directory, const char *material) {
+	assert(chess_tablebase_is_valid(tablebase));
+	assert(directory != CHESS_NULL);
+	assert(material != CHESS_NULL);
+
+	ChessTablebaseMaterial parsed_material;
+	if (!chess_tablebase_material_from_string(&parsed_material, material)) {
+		return false;
+	}
+
+	return chess_tablebase_generate_material(tablebase, directory, &parsed_material);
+}
+bool chess_tablebase_probe(const ChessTablebase *tablebase, const ChessPosition *position, ChessTablebaseResult *result) {
+	assert(chess_tablebase_is_valid(tablebase));
+	assert(chess_position_is_valid(position));
+	assert(result != CHESS_NULL);
+
+	uint8_t value = chess_tablebase_value(tablebase, position, UINT_MAX);
+	if (value == CHESS_TABLEBASE_VALUE_UNKNOWN || value == CHESS_TABLEBASE_VALUE_INVALID) {
+		return false;
+	}
+
+	if (value == CHESS_TABLEBASE_VALUE_DRAW) {
+		*result = (ChessTablebaseResult){ .outcome = CHESS_TABLEBASE_OUTCOME_DRAW, .moves = 0 };
+	} else if (value >= CHESS_TABLEBASE_VALUE_LOSS) {
+		*result = (ChessTablebaseResult){ .outcome = CHESS_TABLEBASE_OUTCOME_LOSS, .moves = value - CHESS_TABLEBASE_VALUE_LOSS };
+	} else {
+		*result = (ChessTablebaseResult){ .outcome = CHESS_TABLEBASE_OUTCOME_WIN, .moves = value };
+	}
+
+	return true;
+}
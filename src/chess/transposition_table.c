@@ -0,0 +1,108 @@
+#include <chess/transposition_table.h>
+
+#include <chess/piece_type.h>
+#include <chess/square.h>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool chess_transposition_table_is_valid(const ChessTranspositionTable *table) {
+	assert(table != CHESS_NULL);
+
+	if (table->slots == CHESS_NULL) {
+		return table->size == 0;
+	}
+
+	return table->size != 0 && (table->size & (table->size - 1)) == 0;
+}
+ChessTranspositionTable chess_transposition_table_new(size_t size) {
+	while ((size & (size - 1)) != 0) {
+		size &= size - 1;
+	}
+
+	ChessTranspositionTableSlot *slots = size != 0 ? calloc(size, sizeof(*slots)) : CHESS_NULL;
+
+	return (ChessTranspositionTable){
+		.slots = slots,
+		.size  = slots != CHESS_NULL ? size : 0,
+	};
+}
+void chess_transposition_table_drop(ChessTranspositionTable *table) {
+	assert(chess_transposition_table_is_valid(table));
+
+	free(table->slots);
+
+	table->slots = CHESS_NULL;
+	table->size  = 0;
+}
+void chess_transposition_table_clear(ChessTranspositionTable *table) {
+	assert(chess_transposition_table_is_valid(table));
+
+	if (table->slots != CHESS_NULL) {
+		memset(table->slots, 0, table->size * sizeof(table->slots[0]));
+	}
+}
+// An entry is packed with its score in the low 32 bits, followed by its depth, bound, squares and promotion type.
+static uint64_t chess_transposition_table_pack(ChessTranspositionTableEntry entry) {
+	return (uint64_t)(uint32_t)entry.score |
+	       (uint64_t)entry.depth << 32U |
+	       (uint64_t)entry.bound << 40U |
+	       (uint64_t)entry.from << 42U |
+	       (uint64_t)entry.to << 50U |
+	       (uint64_t)entry.promotion_type << 58U;
+}
+static ChessTranspositionTableEntry chess_transposition_table_unpack(uint64_t key, uint64_t data) {
+	return (ChessTranspositionTableEntry){
+		.key            = key,
+		.score          = (ChessScore)(int32_t)(uint32_t)data,
+		.depth          = (uint8_t)(data >> 32U),
+		.bound          = (ChessTranspositionTableBound)(data >> 40U & 0x3U),
+		.from           = (ChessSquare)(data >> 42U & 0xFFU),
+		.to             = (ChessSquare)(data >> 50U & 0xFFU),
+		.promotion_type = (ChessPieceType)(data >> 58U & 0x7U),
+	};
+}
+bool chess_transposition_table_probe(const ChessTranspositionTable *table, uint64_t key, ChessTranspositionTableEntry *entry) {
+	assert(chess_transposition_table_is_valid(table));
+	assert(entry != CHESS_NULL);
+
+	if (table->slots == CHESS_NULL) {
+		return false;
+	}
+
+	// Cleared slots have a bound of none, so they never match, even for a key of 0.
+	ChessTranspositionTableSlot *slot = &table->slots[key & (table->size - 1)];
+	uint64_t data                     = slot->data;
+	if ((slot->key ^ data) != key || (data >> 40U & 0x3U) == CHESS_TRANSPOSITION_TABLE_BOUND_NONE) {
+		return false;
+	}
+
+	*entry = chess_transposition_table_unpack(key, data);
+	return true;
+}
+void chess_transposition_table_store(ChessTranspositionTable *table, ChessTranspositionTableEntry entry) {
+	assert(chess_transposition_table_is_valid(table));
+	assert(entry.bound != CHESS_TRANSPOSITION_TABLE_BOUND_NONE);
+
+	if (table->slots == CHESS_NULL) {
+		return;
+	}
+
+	ChessTranspositionTableSlot *slot = &table->slots[entry.key & (table->size - 1)];
+	ChessTranspositionTableEntry stored_entry;
+	if (chess_transposition_table_probe(table, entry.key, &stored_entry)) {
+		if (stored_entry.depth > entry.depth && entry.bound != CHESS_TRANSPOSITION_TABLE_BOUND_EXACT) {
+			return;
+		}
+		if (entry.from == CHESS_SQUARE_NONE) {
+			entry.from           = stored_entry.from;
+			entry.to             = stored_entry.to;
+			entry.promotion_type = stored_entry.promotion_type;
+		}
+	}
+
+	uint64_t data = chess_transposition_table_pack(entry);
+	slot->key     = entry.key ^ data;
+	slot->data    = data;
+}
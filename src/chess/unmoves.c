@@ -0,0 +1,370 @@
+#include <chess/unmoves.h>
+
+#include <chess/castling_rights.h>
+#include <chess/color.h>
+#include <chess/file.h>
+#include <chess/move.h>
+#include <chess/move_private.h>
+#include <chess/offset.h>
+#include <chess/piece.h>
+#include <chess/piece_type.h>
+#include <chess/position.h>
+#include <chess/position_private.h>
+#include <chess/rank.h>
+#include <chess/square.h>
+
+#include <assert.h>
+
+static void chess_unmoves_add(ChessUnmoves *unmoves, const ChessPosition *position, ChessMove unmove) {
+	assert(unmoves != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+	assert(chess_move_is_valid(unmove));
+
+	ChessPosition position_before_move = *position;
+	chess_move_undo_unchecked(&position_before_move, unmove);
+	if (chess_position_is_king_attacked(&position_before_move, position->side_to_move)) {
+		return;
+	}
+
+	assert(unmoves->count < CHESS_UNMOVES_MAXIMUM_COUNT);
+	unmoves->unmoves[unmoves->count++] = unmove;
+
+	if (unmove.previous_en_passant_square != CHESS_SQUARE_NONE) {
+		return;
+	}
+
+	// The position before the unmove may itself follow a double push of the side to move, which left an en passant
+	// square behind.
+	ChessColor color      = position->side_to_move;
+	ChessOffset direction = color == CHESS_COLOR_WHITE ? CHESS_OFFSET_NORTH : CHESS_OFFSET_SOUTH;
+	ChessRank rank        = color == CHESS_COLOR_WHITE ? CHESS_RANK_3 : CHESS_RANK_6;
+	for (ChessFile file = CHESS_FILE_A; file <= CHESS_FILE_H; file++) {
+		ChessSquare square = chess_square_new(file, rank);
+		if (position_before_move.board[square] != CHESS_PIECE_NONE ||
+		    position_before_move.board[square - direction] != CHESS_PIECE_NONE ||
+		    position_before_move.board[square + direction] != chess_piece_new(color, CHESS_PIECE_TYPE_PAWN)) {
+			continue;
+		}
+
+		// The double push was legal, so the other king is not attacked with the pawn back on its initial square.
+		ChessPosition position_before_push = position_before_move;
+		chess_position_move_piece(&position_before_push, (ChessSquare)(square + direction), (ChessSquare)(square - direction));
+		if (chess_position_is_king_attacked(&position_before_push, chess_color_opposite(color))) {
+			continue;
+		}
+
+		unmove.previous_en_passant_square  = square;
+		assert(unmoves->count < CHESS_UNMOVES_MAXIMUM_COUNT);
+		unmoves->unmoves[unmoves->count++] = unmove;
+	}
+}
+static bool chess_unmoves_is_material_reachable(const ChessPosition *position, ChessColor color, ChessPieceType added_type, ChessPieceType removed_type) {
+	assert(chess_position_is_valid(position));
+	assert(chess_color_is_valid(color));
+
+	static CHESS_CONSTEXPR unsigned int initial_counts[CHESS_PIECE_TYPE_KING + 1] = { 8, 2, 2, 2, 1, 1 };
+
+	unsigned int counts[CHESS_PIECE_TYPE_KING + 1];
+	unsigned int count = 0;
+	for (ChessPieceType type = CHESS_PIECE_TYPE_PAWN; type <= CHESS_PIECE_TYPE_KING; type++) {
+		counts[type] = position->piece_counts[color][type] + (type == added_type) - (type == removed_type);
+		count       += counts[type];
+	}
+
+	// Every piece beyond the initial ones was promoted from a pawn that is no longer on the board.
+	unsigned int promoted_count = 0;
+	for (ChessPieceType type = CHESS_PIECE_TYPE_KNIGHT; type <= CHESS_PIECE_TYPE_QUEEN; type++) {
+		if (counts[type] > initial_counts[type]) {
+			promoted_count += counts[type] - initial_counts[type];
+		}
+	}
+
+	return count <= 16 && counts[CHESS_PIECE_TYPE_PAWN] + promoted_count <= initial_counts[CHESS_PIECE_TYPE_PAWN];
+}
+static bool chess_unmoves_is_castling_square(const ChessPosition *position, ChessSquare square) {
+	assert(chess_position_is_valid(position));
+	assert(chess_square_is_valid(square));
+
+	switch (square) {
+		case CHESS_SQUARE_E1: return (position->castling_rights & CHESS_CASTLING_RIGHTS_WHITE) != 0;
+		case CHESS_SQUARE_H1: return (position->castling_rights & CHESS_CASTLING_RIGHTS_WHITE_KINGSIDE) != 0;
+		case CHESS_SQUARE_A1: return (position->castling_rights & CHESS_CASTLING_RIGHTS_WHITE_QUEENSIDE) != 0;
+		case CHESS_SQUARE_E8: return (position->castling_rights & CHESS_CASTLING_RIGHTS_BLACK) != 0;
+		case CHESS_SQUARE_H8: return (position->castling_rights & CHESS_CASTLING_RIGHTS_BLACK_KINGSIDE) != 0;
+		case CHESS_SQUARE_A8: return (position->castling_rights & CHESS_CASTLING_RIGHTS_BLACK_QUEENSIDE) != 0;
+		default: return false;
+	}
+}
+static void chess_unmoves_generate_uncaptures(
+    ChessUnmoves *unmoves,
+    const ChessPosition *position,
+    ChessSquare from,
+    ChessSquare to,
+    ChessPieceType promotion_type,
+    bool is_quiet_allowed,
+    bool is_capture_allowed
+) {
+	assert(unmoves != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+	assert(chess_square_is_valid(from));
+	assert(chess_square_is_valid(to));
+
+	ChessMove unmove = {
+		.from                       = from,
+		.to                         = to,
+		.promotion_type             = promotion_type,
+		.captured_piece             = CHESS_PIECE_NONE,
+		.previous_castling_rights   = position->castling_rights,
+		.previous_en_passant_square = CHESS_SQUARE_NONE,
+		.previous_half_move_clock   = position->half_move_clock > 0 ? position->half_move_clock - 1 : 0,
+	};
+
+	if (is_quiet_allowed) {
+		chess_unmoves_add(unmoves, position, unmove);
+	}
+
+	// Captures reset the half-move clock, so they can only have led to a position in which it is 0.
+	if (!is_capture_allowed || position->half_move_clock != 0) {
+		return;
+	}
+
+	ChessRank rank = chess_square_rank(to);
+	for (ChessPieceType type = CHESS_PIECE_TYPE_PAWN; type < CHESS_PIECE_TYPE_KING; type++) {
+		if (type == CHESS_PIECE_TYPE_PAWN && (rank == CHESS_RANK_1 || rank == CHESS_RANK_8)) {
+			continue;
+		}
+		if (!chess_unmoves_is_material_reachable(position, position->side_to_move, type, CHESS_PIECE_TYPE_NONE)) {
+			continue;
+		}
+
+		unmove.captured_piece = chess_piece_new(position->side_to_move, type);
+		chess_unmoves_add(unmoves, position, unmove);
+	}
+}
+static void chess_unmoves_generate_pawn(ChessUnmoves *unmoves, const ChessPosition *position, ChessSquare to, bool is_quiet) {
+	assert(unmoves != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+	assert(chess_square_is_valid(to));
+
+	ChessColor color          = chess_color_opposite(position->side_to_move);
+	ChessOffset direction     = color == CHESS_COLOR_WHITE ? CHESS_OFFSET_NORTH : CHESS_OFFSET_SOUTH;
+	ChessRank first_rank      = color == CHESS_COLOR_WHITE ? CHESS_RANK_1 : CHESS_RANK_8;
+	ChessRank en_passant_rank = color == CHESS_COLOR_WHITE ? CHESS_RANK_6 : CHESS_RANK_3;
+
+	// Pawn moves reset the half-move clock, so they can only have led to a position in which it is 0.
+	if (position->half_move_clock != 0) {
+		return;
+	}
+
+	// Double pushes always leave an en passant square behind, so they are only undone when there is one.
+	ChessSquare from          = (ChessSquare)(to - direction);
+	if (chess_square_is_valid(from) && chess_square_rank(from) != first_rank && position->board[from] == CHESS_PIECE_NONE) {
+		chess_unmoves_generate_uncaptures(unmoves, position, from, to, CHESS_PIECE_TYPE_NONE, true, false);
+	}
+
+	static CHESS_CONSTEXPR ChessOffset offsets[] = {
+		CHESS_OFFSET_EAST,
+		CHESS_OFFSET_WEST,
+	};
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(offsets) && !is_quiet; i++) {
+		from = (ChessSquare)(to - direction + offsets[i]);
+		if (!chess_square_is_valid(from) || chess_square_rank(from) == first_rank || position->board[from] != CHESS_PIECE_NONE) {
+			continue;
+		}
+
+		chess_unmoves_generate_uncaptures(unmoves, position, from, to, CHESS_PIECE_TYPE_NONE, false, true);
+
+		if (chess_square_rank(to) == en_passant_rank &&
+		    position->board[to - direction] == CHESS_PIECE_NONE &&
+		    position->board[to + direction] == CHESS_PIECE_NONE &&
+		    chess_unmoves_is_material_reachable(position, position->side_to_move, CHESS_PIECE_TYPE_PAWN, CHESS_PIECE_TYPE_NONE)) {
+			chess_unmoves_add(
+			    unmoves,
+			    position,
+			    (ChessMove){
+			        .from                       = from,
+			        .to                         = to,
+			        .promotion_type             = CHESS_PIECE_TYPE_NONE,
+			        .captured_piece             = chess_piece_new(position->side_to_move, CHESS_PIECE_TYPE_PAWN),
+			        .previous_castling_rights   = position->castling_rights,
+			        .previous_en_passant_square = to,
+			        .previous_half_move_clock   = position->half_move_clock > 0 ? position->half_move_clock - 1 : 0,
+			    }
+			);
+		}
+	}
+}
+static void chess_unmoves_generate_promotions(ChessUnmoves *unmoves, const ChessPosition *position, ChessSquare to) {
+	assert(unmoves != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+	assert(chess_square_is_valid(to));
+
+	ChessColor color         = chess_color_opposite(position->side_to_move);
+	ChessOffset direction    = color == CHESS_COLOR_WHITE ? CHESS_OFFSET_NORTH : CHESS_OFFSET_SOUTH;
+	ChessRank promotion_rank = color == CHESS_COLOR_WHITE ? CHESS_RANK_8 : CHESS_RANK_1;
+
+	ChessPieceType type      = chess_piece_type(position->board[to]);
+	if (position->half_move_clock != 0 || chess_square_rank(to) != promotion_rank || !chess_unmoves_is_material_reachable(position, color, CHESS_PIECE_TYPE_PAWN, type)) {
+		return;
+	}
+
+	static CHESS_CONSTEXPR ChessOffset offsets[] = {
+		0,
+		CHESS_OFFSET_EAST,
+		CHESS_OFFSET_WEST,
+	};
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(offsets); i++) {
+		ChessSquare from = (ChessSquare)(to - direction + offsets[i]);
+		if (chess_square_is_valid(from) && position->board[from] == CHESS_PIECE_NONE) {
+			chess_unmoves_generate_uncaptures(unmoves, position, from, to, type, offsets[i] == 0, offsets[i] != 0);
+		}
+	}
+}
+static void chess_unmoves_generate_directions(
+    ChessUnmoves *unmoves,
+    const ChessPosition *position,
+    ChessSquare to,
+    const ChessOffset *directions,
+    size_t direction_count,
+    bool is_quiet
+) {
+	assert(unmoves != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+	assert(directions != CHESS_NULL || direction_count == 0);
+
+	for (size_t i = 0; i < direction_count; i++) {
+		ChessSquare from = (ChessSquare)(to + directions[i]);
+		while (chess_square_is_valid(from) && position->board[from] == CHESS_PIECE_NONE) {
+			chess_unmoves_generate_uncaptures(unmoves, position, from, to, CHESS_PIECE_TYPE_NONE, true, !is_quiet);
+			from += directions[i];
+		}
+	}
+}
+static void chess_unmoves_generate_offsets(
+    ChessUnmoves *unmoves,
+    const ChessPosition *position,
+    ChessSquare to,
+    const ChessOffset *offsets,
+    size_t offset_count,
+    bool is_quiet
+) {
+	assert(unmoves != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+	assert(offsets != CHESS_NULL || offset_count == 0);
+
+	for (size_t i = 0; i < offset_count; i++) {
+		ChessSquare from = (ChessSquare)(to + offsets[i]);
+		if (chess_square_is_valid(from) && position->board[from] == CHESS_PIECE_NONE) {
+			chess_unmoves_generate_uncaptures(unmoves, position, from, to, CHESS_PIECE_TYPE_NONE, true, !is_quiet);
+		}
+	}
+}
+static void chess_unmoves_generate_to(ChessUnmoves *unmoves, const ChessPosition *position, ChessSquare to, bool is_quiet) {
+	assert(unmoves != CHESS_NULL);
+	assert(chess_position_is_valid(position));
+	assert(chess_square_is_valid(to));
+
+	if (chess_unmoves_is_castling_square(position, to)) {
+		return;
+	}
+
+	static CHESS_CONSTEXPR ChessOffset knight_offsets[] = {
+		2 * CHESS_OFFSET_NORTH + CHESS_OFFSET_EAST,
+		2 * CHESS_OFFSET_NORTH + CHESS_OFFSET_WEST,
+		2 * CHESS_OFFSET_EAST + CHESS_OFFSET_NORTH,
+		2 * CHESS_OFFSET_EAST + CHESS_OFFSET_SOUTH,
+		2 * CHESS_OFFSET_SOUTH + CHESS_OFFSET_EAST,
+		2 * CHESS_OFFSET_SOUTH + CHESS_OFFSET_WEST,
+		2 * CHESS_OFFSET_WEST + CHESS_OFFSET_NORTH,
+		2 * CHESS_OFFSET_WEST + CHESS_OFFSET_SOUTH,
+	};
+	static CHESS_CONSTEXPR ChessOffset directions[] = {
+		CHESS_OFFSET_NORTH_EAST,
+		CHESS_OFFSET_SOUTH_EAST,
+		CHESS_OFFSET_SOUTH_WEST,
+		CHESS_OFFSET_NORTH_WEST,
+		CHESS_OFFSET_NORTH,
+		CHESS_OFFSET_EAST,
+		CHESS_OFFSET_SOUTH,
+		CHESS_OFFSET_WEST,
+	};
+
+	ChessPieceType type = chess_piece_type(position->board[to]);
+	switch (type) {
+		case CHESS_PIECE_TYPE_PAWN: {
+			chess_unmoves_generate_pawn(unmoves, position, to, is_quiet);
+		} break;
+		case CHESS_PIECE_TYPE_KNIGHT: {
+			chess_unmoves_generate_offsets(unmoves, position, to, knight_offsets, CHESS_ARRAY_LENGTH(knight_offsets), is_quiet);
+		} break;
+		case CHESS_PIECE_TYPE_BISHOP: {
+			chess_unmoves_generate_directions(unmoves, position, to, directions, 4, is_quiet);
+		} break;
+		case CHESS_PIECE_TYPE_ROOK: {
+			chess_unmoves_generate_directions(unmoves, position, to, directions + 4, 4, is_quiet);
+		} break;
+		case CHESS_PIECE_TYPE_QUEEN: {
+			chess_unmoves_generate_directions(unmoves, position, to, directions, CHESS_ARRAY_LENGTH(directions), is_quiet);
+		} break;
+		case CHESS_PIECE_TYPE_KING: {
+			chess_unmoves_generate_offsets(unmoves, position, to, directions, CHESS_ARRAY_LENGTH(directions), is_quiet);
+		} break;
+		default: assert(false);
+	}
+
+	if (!is_quiet && type != CHESS_PIECE_TYPE_PAWN && type != CHESS_PIECE_TYPE_KING) {
+		chess_unmoves_generate_promotions(unmoves, position, to);
+	}
+}
+static ChessUnmoves chess_unmoves_generate_(const ChessPosition *position, bool is_quiet) {
+	assert(chess_position_is_valid(position));
+
+	ChessUnmoves unmoves = { .count = 0 };
+
+	ChessColor color     = chess_color_opposite(position->side_to_move);
+	if (chess_position_is_king_attacked(position, color)) {
+		return unmoves;
+	}
+
+	// An en passant square means the last move was the double push that left it behind, which reset the half-move
+	// clock.
+	if (position->en_passant_square != CHESS_SQUARE_NONE) {
+		ChessOffset direction = color == CHESS_COLOR_WHITE ? CHESS_OFFSET_NORTH : CHESS_OFFSET_SOUTH;
+		ChessSquare from      = (ChessSquare)(position->en_passant_square - direction);
+		if (position->half_move_clock == 0 && position->board[from] == CHESS_PIECE_NONE) {
+			chess_unmoves_add(
+			    &unmoves,
+			    position,
+			    (ChessMove){
+			        .from                       = from,
+			        .to                         = (ChessSquare)(position->en_passant_square + direction),
+			        .promotion_type             = CHESS_PIECE_TYPE_NONE,
+			        .captured_piece             = CHESS_PIECE_NONE,
+			        .previous_castling_rights   = position->castling_rights,
+			        .previous_en_passant_square = CHESS_SQUARE_NONE,
+			        .previous_half_move_clock   = position->half_move_clock > 0 ? position->half_move_clock - 1 : 0,
+			    }
+			);
+		}
+
+		return unmoves;
+	}
+
+	for (ChessPieceType type = CHESS_PIECE_TYPE_PAWN; type <= CHESS_PIECE_TYPE_KING; type++) {
+		for (size_t i = 0; i < position->piece_counts[color][type]; i++) {
+			chess_unmoves_generate_to(&unmoves, position, position->pieces[color][type][i], is_quiet);
+		}
+	}
+
+	return unmoves;
+}
+ChessUnmoves chess_unmoves_generate(const ChessPosition *position) {
+	assert(chess_position_is_valid(position));
+
+	return chess_unmoves_generate_(position, false);
+}
+ChessUnmoves chess_unmoves_generate_quiet(const ChessPosition *position) {
+	assert(chess_position_is_valid(position));
+
+	return chess_unmoves_generate_(position, true);
+}
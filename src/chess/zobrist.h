@@ -0,0 +1,24 @@
+#ifndef CHESS_ZOBRIST_H_INCLUDED
+#define CHESS_ZOBRIST_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <chess/castling_rights.h>
+#include <chess/file.h>
+#include <chess/piece.h>
+#include <chess/square.h>
+
+#include <stdint.h>
+
+extern const uint64_t chess_zobrist_piece_at_square[CHESS_PIECE_BLACK_KING + 1][CHESS_SQUARE_H8 + 1];
+extern const uint64_t chess_zobrist_side_to_move;
+extern const uint64_t chess_zobrist_castling_rights[CHESS_CASTLING_RIGHTS_ALL + 1];
+extern const uint64_t chess_zobrist_en_passant_file[CHESS_FILE_H + 1];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHESS_ZOBRIST_H_INCLUDED
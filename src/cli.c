@@ -1,64 +1,10 @@
-#include "chess/move_private.h"
 #include <assert.h>
 #include <chess.h>
-#include <math.h>
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 
-double chess_position_negamax(const ChessPosition *position, int depth, double alpha, double beta, int color) {
-	if (depth == 0 || chess_position_is_checkmate(position) || chess_position_is_stalemate(position)) {
-		return color * chess_position_evaluate(position);
-	}
-
-	double maximum_value = -INFINITY;
-	ChessMoves moves     = chess_moves_generate(position);
-	for (size_t i = 0; i < moves.count; i++) {
-		ChessPosition position_after_move = *position;
-		chess_move_do_unchecked(&position_after_move, moves.moves[i]);
-		double value = -chess_position_negamax(&position_after_move, depth - 1, -beta, -alpha, -color);
-		if (value > maximum_value) {
-			maximum_value = value;
-			if (value > alpha) {
-				alpha = value;
-			}
-		}
-		if (alpha >= beta) {
-			break;
-		}
-	}
-	return maximum_value;
-}
-ChessMove chess_position_best_move(const ChessPosition *position, int depth) {
-	assert(position != NULL);
-	assert(depth > 0);
-
-	ChessMove best_move = {
-		.from           = CHESS_SQUARE_NONE,
-		.to             = CHESS_SQUARE_NONE,
-		.promotion_type = CHESS_PIECE_TYPE_NONE
-	};
-	double best_value = -INFINITY;
-	ChessMoves moves  = chess_moves_generate(position);
-	for (size_t i = 0; i < moves.count; i++) {
-		ChessPosition position_after_move = *position;
-		chess_move_do_unchecked(&position_after_move, moves.moves[i]);
-		double value = -chess_position_negamax(
-		    &position_after_move,
-		    depth - 1,
-		    -INFINITY,
-		    INFINITY,
-		    (chess_position_side_to_move(position) == CHESS_COLOR_WHITE ? 1 : -1)
-		);
-		if (value > best_value) {
-			best_value = value;
-			best_move  = moves.moves[i];
-		}
-	}
-
-	return best_move;
-}
-
 void chess_position_print(const ChessPosition *chess) {
 	assert(chess != NULL);
 
@@ -129,16 +75,36 @@ void chess_position_print(const ChessPosition *chess) {
 	}
 	printf("   \033[0m\n");
 }
+// `rand` may only give 15 random bits, so three of its numbers are put together to fill the 32 bits.
+static uint32_t chess_cli_random(void) {
+	uint32_t random = (uint32_t)rand() & 0x7FFFU;
+	random          = random << 15U | ((uint32_t)rand() & 0x7FFFU);
+	random          = random << 15U | ((uint32_t)rand() & 0x7FFFU);
+
+	return random;
+}
 
-int main(void) {
+int main(int argc, char *argv[]) {
+	ChessBook book = chess_book_new();
+	if (argc > 1 && !chess_book_load(&book, argv[1])) {
+		(void)fprintf(stderr, "Error: Invalid opening book: %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	srand((unsigned int)time(NULL));
+
+	ChessGame game         = chess_game_new();
 	ChessPosition position = chess_position_new();
-	if (!chess_position_from_fen(&position, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1")) {
+	if (!chess_position_from_fen(&position, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1") || !chess_game_reset(&game, &position)) {
 		(void)fprintf(stderr, "Error: Invalid FEN position\n");
+		chess_game_drop(&game);
+		chess_book_drop(&book);
 		return EXIT_FAILURE;
 	}
 
 	chess_position_print(&position);
 	while (true) {
+		position = *chess_game_position(&game);
+
 		char fen[128];
 		chess_position_to_fen(&position, fen, sizeof(fen));
 		printf("Position: %s\n", fen);
@@ -146,10 +112,16 @@ int main(void) {
 			printf("Checkmate!\n");
 			break;
 		}
+		if (chess_game_is_threefold_repetition(&game)) {
+			printf("Draw by threefold repetition!\n");
+			break;
+		}
 		if (chess_position_is_check(&position)) {
 			printf("Check!\n");
 		}
-		printf("Score: %lg\n", chess_position_evaluate(&position));
+		char score[16];
+		chess_score_to_string(chess_position_evaluate(&position), score, sizeof(score));
+		printf("Score: %s\n", score);
 		printf("%s to move.\n", chess_position_side_to_move(&position) == CHESS_COLOR_WHITE ? "White" : "Black");
 		printf("Available moves: ");
 		ChessMoves moves = chess_moves_generate(&position);
@@ -161,15 +133,22 @@ int main(void) {
 		printf("\n");
 
 		if (chess_position_side_to_move(&position) == CHESS_COLOR_BLACK) {
+			ChessMove move;
+			if (chess_book_probe(&book, &position, CHESS_BOOK_SELECTION_WEIGHTED, chess_cli_random(), &move)) {
+				char string[8];
+				chess_move_to_algebraic(&position, move, string, sizeof(string));
+				printf("Black plays: %s (from the opening book)\n", string);
+				chess_game_do_move(&game, move);
+				chess_position_print(chess_game_position(&game));
+				continue;
+			}
+
 			printf("Black is thinking...\n");
-			clock_t start       = clock();
-			ChessMove best_move = chess_position_best_move(&position, 4);
-			clock_t end         = clock();
-			double elapsed_time = (double)(end - start) / CLOCKS_PER_SEC * 1000;
+			ChessSearchResult result = chess_search(&position, (ChessSearchLimits){ .depth = 4, .keys = game.keys, .key_count = game.move_count });
 			char string[8];
-			chess_move_to_algebraic(&position, best_move, string, sizeof(string));
-			printf("Black plays: %s (computed in %.2f milliseconds)\n", string, elapsed_time);
-			chess_move_do(&position, best_move);
+			chess_move_to_algebraic(&position, result.best_move, string, sizeof(string));
+			printf("Black plays: %s (computed in %" PRIu64 " milliseconds, %" PRIu64 " nodes at %" PRIu64 " nodes per second, %u plies deep)\n", string, result.time, result.nodes, result.statistics.nodes_per_second, result.depth);
+			chess_game_do_move(&game, result.best_move);
 		} else {
 			char string[64];
 			if (fgets(string, sizeof(string), stdin) == NULL) {
@@ -181,14 +160,15 @@ int main(void) {
 				(void)fprintf(stderr, "Invalid move: %s\n", string);
 				continue;
 			}
-			if (!chess_move_do(&position, move)) {
+			if (!chess_game_do_move(&game, move)) {
 				(void)fprintf(stderr, "Illegal move.\n");
 				continue;
 			}
 		}
 
-		chess_position_print(&position);
+		chess_position_print(chess_game_position(&game));
 	}
 
-	chess_position_drop(&position);
+	chess_game_drop(&game);
+	chess_book_drop(&book);
 }
@@ -0,0 +1,29 @@
+#include <chess.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		(void)fprintf(stderr, "Usage: %s <directory> <material>...\n", argv[0]);
+		(void)fprintf(stderr, "Generates the endgame tables of the given materials (e.g., KQvK KRPvKR) and the tables they depend on.\n");
+		return EXIT_FAILURE;
+	}
+
+	ChessTablebase tablebase = chess_tablebase_new();
+
+	int exit_status          = EXIT_SUCCESS;
+	for (int i = 2; i < argc; i++) {
+		clock_t start_time = clock();
+		if (!chess_tablebase_generate(&tablebase, argv[1], argv[i])) {
+			(void)fprintf(stderr, "Error: Failed to generate %s in %s\n", argv[i], argv[1]);
+			exit_status = EXIT_FAILURE;
+			break;
+		}
+		printf("Generated %s in %.1f s\n", argv[i], (double)(clock() - start_time) / CLOCKS_PER_SEC);
+	}
+
+	chess_tablebase_drop(&tablebase);
+
+	return exit_status;
+}
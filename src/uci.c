@@ -0,0 +1,527 @@
+#if !defined(_POSIX_C_SOURCE)
+	#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <chess.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+static const char *const chess_uci_start_fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+// The size of the transposition table in MiB, and the time kept in hand for the communication with the GUI.
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_UCI_DEFAULT_HASH, 16);
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, CHESS_UCI_MAXIMUM_HASH, 4096);
+CHESS_DEFINE_INTEGRAL_CONSTANT(uint64_t, CHESS_UCI_MOVE_OVERHEAD, 30);
+
+// The state shared by the input thread, which answers commands at once, and the search thread. The search thread owns
+// the game and the table while a search runs, the input thread only touching them once it is idle.
+typedef struct ChessUciEngine {
+	pthread_mutex_t mutex;
+	pthread_cond_t condition;
+	pthread_t thread;
+	ChessGame game;
+	ChessTranspositionTable table;
+	unsigned int line_count;
+	ChessSearchLimits limits;
+	CHESS_ATOMIC(bool) stop;
+	bool is_search_requested;
+	bool is_searching;
+	bool is_held;
+	bool is_pondering;
+	bool is_quitting;
+	uint64_t ponder_time;
+	uint64_t deadline;
+} ChessUciEngine;
+
+// The lines read from the standard input, which is read directly so that it can be polled while a deadline is pending.
+typedef struct ChessUciInput {
+	char *buffer;
+	size_t size;
+	size_t length;
+	size_t line_length;
+	bool is_closed;
+} ChessUciInput;
+
+static uint64_t chess_uci_milliseconds(void) {
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return (uint64_t)time.tv_sec * 1000U + (uint64_t)time.tv_nsec / 1000000U;
+}
+static char *chess_uci_token(char **cursor) {
+	char *token = *cursor;
+	while (*token == ' ' || *token == '\t') {
+		token++;
+	}
+	if (*token == '\0') {
+		*cursor = token;
+		return NULL;
+	}
+
+	char *end = token;
+	while (*end != '\0' && *end != ' ' && *end != '\t') {
+		end++;
+	}
+	if (*end != '\0') {
+		*end++ = '\0';
+	}
+
+	*cursor = end;
+	return token;
+}
+static char *chess_uci_input_line(ChessUciInput *input) {
+	// The previous line is consumed only now, as it was handed out in place.
+	if (input->line_length != 0) {
+		memmove(input->buffer, input->buffer + input->line_length, input->length - input->line_length);
+		input->length      -= input->line_length;
+		input->line_length  = 0;
+	}
+
+	char *end = input->length != 0 ? memchr(input->buffer, '\n', input->length) : NULL;
+	if (end == NULL) {
+		return NULL;
+	}
+
+	*end               = '\0';
+	input->line_length = (size_t)(end - input->buffer) + 1;
+	if (end != input->buffer && end[-1] == '\r') {
+		end[-1] = '\0';
+	}
+
+	return input->buffer;
+}
+static bool chess_uci_input_read(ChessUciInput *input) {
+	if (input->length == input->size) {
+		size_t size  = input->size == 0 ? 4096 : 2 * input->size;
+		char *buffer = realloc(input->buffer, size);
+		if (buffer == NULL) {
+			return false;
+		}
+		input->buffer = buffer;
+		input->size   = size;
+	}
+
+	ssize_t count = read(STDIN_FILENO, input->buffer + input->length, input->size - input->length);
+	if (count < 0) {
+		return errno == EINTR;
+	}
+	if (count == 0) {
+		input->is_closed = true;
+	}
+
+	input->length += (size_t)count;
+	return true;
+}
+static void chess_uci_print_score(ChessScore score) {
+	if (chess_score_is_mate(score)) {
+		unsigned int plies = chess_score_mate_plies(score);
+		if (score > 0) {
+			printf(" score mate %u", (plies + 1) / 2);
+		} else {
+			printf(" score mate -%u", plies / 2);
+		}
+	} else {
+		printf(" score cp %" PRId32, score);
+	}
+}
+// Reports every iteration as it completes, so that the GUI follows the progress of long searches.
+static void chess_uci_print_statistics(const ChessSearchStatistics *statistics, void *data) {
+	(void)data;
+
+	flockfile(stdout);
+	printf("info depth %u seldepth %u", statistics->depth, statistics->selective_depth);
+	chess_uci_print_score(statistics->score);
+	printf(" nodes %" PRIu64 " nps %" PRIu64 " time %" PRIu64 "\n", statistics->total_nodes, statistics->nodes_per_second, statistics->total_time);
+	fflush(stdout);
+	funlockfile(stdout);
+}
+static void chess_uci_print_result(const ChessSearchResult *result) {
+	flockfile(stdout);
+
+	uint64_t nodes_per_second = result->time != 0 ? result->nodes * 1000U / result->time : result->nodes * 1000U;
+	for (size_t i = 0; i < result->line_count; i++) {
+		const ChessSearchLine *line = &result->lines[i];
+
+		printf("info depth %u seldepth %u multipv %zu", result->depth, result->statistics.selective_depth, i + 1);
+		chess_uci_print_score(line->score);
+		printf(" nodes %" PRIu64 " nps %" PRIu64 " time %" PRIu64 " pv", result->nodes, nodes_per_second, result->time);
+		for (size_t j = 0; j < line->move_count; j++) {
+			char string[8];
+			chess_move_to_uci(line->moves[j], string, sizeof(string));
+			printf(" %s", string);
+		}
+		printf("\n");
+	}
+
+	if (result->best_move.from == CHESS_SQUARE_NONE) {
+		printf("bestmove 0000\n");
+	} else {
+		char string[8];
+		chess_move_to_uci(result->best_move, string, sizeof(string));
+		printf("bestmove %s", string);
+		if (result->line_count != 0 && result->lines[0].move_count > 1) {
+			chess_move_to_uci(result->lines[0].moves[1], string, sizeof(string));
+			printf(" ponder %s", string);
+		}
+		printf("\n");
+	}
+	fflush(stdout);
+
+	funlockfile(stdout);
+}
+static void chess_uci_print(const char *string) {
+	flockfile(stdout);
+	printf("%s\n", string);
+	fflush(stdout);
+	funlockfile(stdout);
+}
+static void *chess_uci_search(void *argument) {
+	ChessUciEngine *engine = argument;
+
+	pthread_mutex_lock(&engine->mutex);
+	while (true) {
+		while (!engine->is_search_requested && !engine->is_quitting) {
+			pthread_cond_wait(&engine->condition, &engine->mutex);
+		}
+		if (engine->is_quitting) {
+			break;
+		}
+		engine->is_search_requested = false;
+
+		ChessPosition position      = engine->game.position;
+		ChessSearchLimits limits    = engine->limits;
+		pthread_mutex_unlock(&engine->mutex);
+
+		ChessSearchResult result = chess_search(&position, limits);
+
+		// While pondering or searching infinitely, the best move is only given once the GUI asks for it.
+		pthread_mutex_lock(&engine->mutex);
+		while (engine->is_held && !engine->stop) {
+			pthread_cond_wait(&engine->condition, &engine->mutex);
+		}
+		chess_uci_print_result(&result);
+
+		engine->is_searching = false;
+		engine->deadline     = 0;
+		pthread_cond_broadcast(&engine->condition);
+	}
+	pthread_mutex_unlock(&engine->mutex);
+
+	return NULL;
+}
+static void chess_uci_stop(ChessUciEngine *engine, bool is_waiting) {
+	pthread_mutex_lock(&engine->mutex);
+	if (engine->is_searching) {
+		engine->stop     = true;
+		engine->is_held  = false;
+		engine->deadline = 0;
+		pthread_cond_broadcast(&engine->condition);
+	}
+	while (is_waiting && engine->is_searching) {
+		pthread_cond_wait(&engine->condition, &engine->mutex);
+	}
+	pthread_mutex_unlock(&engine->mutex);
+}
+static void chess_uci_ponderhit(ChessUciEngine *engine) {
+	pthread_mutex_lock(&engine->mutex);
+	if (engine->is_searching && engine->is_pondering) {
+		// The opponent played the expected move, so the search goes on as a normal one whose clock starts now.
+		engine->is_pondering = false;
+		engine->is_held      = false;
+		if (engine->ponder_time != 0) {
+			engine->deadline = chess_uci_milliseconds() + engine->ponder_time;
+		}
+		pthread_cond_broadcast(&engine->condition);
+	}
+	pthread_mutex_unlock(&engine->mutex);
+}
+static void chess_uci_check_deadline(ChessUciEngine *engine) {
+	pthread_mutex_lock(&engine->mutex);
+	if (engine->deadline != 0 && chess_uci_milliseconds() >= engine->deadline) {
+		engine->stop     = true;
+		engine->deadline = 0;
+	}
+	pthread_mutex_unlock(&engine->mutex);
+}
+static uint64_t chess_uci_time_budget(uint64_t time, uint64_t increment, uint64_t moves_to_go) {
+	// An even share of the remaining time over the moves to go, 30 when unknown, and most of the increment.
+	uint64_t budget  = time / (moves_to_go != 0 ? moves_to_go : 30) + increment * 3 / 4;
+	uint64_t maximum = time > 2 * CHESS_UCI_MOVE_OVERHEAD ? time - 2 * CHESS_UCI_MOVE_OVERHEAD : time / 2;
+	if (budget > maximum) {
+		budget = maximum;
+	}
+
+	return budget > CHESS_UCI_MOVE_OVERHEAD ? budget - CHESS_UCI_MOVE_OVERHEAD : 1;
+}
+static void chess_uci_go(ChessUciEngine *engine, char *cursor) {
+	chess_uci_stop(engine, true);
+
+	uint64_t times[CHESS_COLOR_BLACK + 1]      = { 0 };
+	uint64_t increments[CHESS_COLOR_BLACK + 1] = { 0 };
+	uint64_t moves_to_go                       = 0;
+	uint64_t move_time                         = 0;
+	bool is_infinite                           = false;
+	bool is_pondering                          = false;
+
+	ChessSearchLimits limits                   = {
+		.depth         = 0,
+		.nodes         = 0,
+		.time          = 0,
+		.line_count    = engine->line_count,
+		.stop          = &engine->stop,
+		.network       = CHESS_NULL,
+		.tablebase     = CHESS_NULL,
+		.table         = &engine->table,
+		.keys          = engine->game.keys,
+		.key_count     = engine->game.move_count,
+		.callback      = chess_uci_print_statistics,
+		.callback_data = CHESS_NULL,
+	};
+
+	char *token;
+	while ((token = chess_uci_token(&cursor)) != NULL) {
+		if (strcmp(token, "infinite") == 0) {
+			is_infinite = true;
+		} else if (strcmp(token, "ponder") == 0) {
+			is_pondering = true;
+		} else {
+			char *value = chess_uci_token(&cursor);
+			if (value == NULL) {
+				break;
+			}
+
+			uint64_t number = strtoull(value, NULL, 10);
+			if (strcmp(token, "wtime") == 0) {
+				times[CHESS_COLOR_WHITE] = number;
+			} else if (strcmp(token, "btime") == 0) {
+				times[CHESS_COLOR_BLACK] = number;
+			} else if (strcmp(token, "winc") == 0) {
+				increments[CHESS_COLOR_WHITE] = number;
+			} else if (strcmp(token, "binc") == 0) {
+				increments[CHESS_COLOR_BLACK] = number;
+			} else if (strcmp(token, "movestogo") == 0) {
+				moves_to_go = number;
+			} else if (strcmp(token, "movetime") == 0) {
+				move_time = number;
+			} else if (strcmp(token, "depth") == 0) {
+				limits.depth = (unsigned int)number;
+			} else if (strcmp(token, "nodes") == 0) {
+				limits.nodes = number;
+			}
+		}
+	}
+
+	ChessColor color = chess_position_side_to_move(chess_game_position(&engine->game));
+	uint64_t budget  = 0;
+	if (move_time != 0) {
+		budget = move_time;
+	} else if (times[color] != 0) {
+		budget = chess_uci_time_budget(times[color], increments[color], moves_to_go);
+	}
+
+	pthread_mutex_lock(&engine->mutex);
+	// While pondering the clock of the engine is not running yet, so the budget only applies from the ponderhit on.
+	limits.time                 = is_pondering || is_infinite ? 0 : budget;
+	engine->limits              = limits;
+	engine->stop                = false;
+	engine->is_search_requested = true;
+	engine->is_searching        = true;
+	engine->is_held             = is_pondering || is_infinite;
+	engine->is_pondering        = is_pondering;
+	engine->ponder_time         = is_infinite ? 0 : budget;
+	engine->deadline            = 0;
+	pthread_cond_broadcast(&engine->condition);
+	pthread_mutex_unlock(&engine->mutex);
+}
+static void chess_uci_position(ChessUciEngine *engine, char *cursor) {
+	chess_uci_stop(engine, true);
+
+	char fen[128]     = { 0 };
+	size_t fen_length = 0;
+
+	char *token       = chess_uci_token(&cursor);
+	if (token != NULL && strcmp(token, "fen") == 0) {
+		while ((token = chess_uci_token(&cursor)) != NULL && strcmp(token, "moves") != 0) {
+			int written = snprintf(fen + fen_length, sizeof(fen) - fen_length, "%s%s", fen_length != 0 ? " " : "", token);
+			if (written < 0 || (size_t)written >= sizeof(fen) - fen_length) {
+				chess_uci_print("info string invalid fen");
+				return;
+			}
+			fen_length += (size_t)written;
+		}
+	} else if (token != NULL && strcmp(token, "startpos") == 0) {
+		token = chess_uci_token(&cursor);
+	} else {
+		chess_uci_print("info string invalid position");
+		return;
+	}
+
+	ChessPosition position = chess_position_new();
+	if (!chess_position_from_fen(&position, fen_length != 0 ? fen : chess_uci_start_fen) || !chess_game_reset(&engine->game, &position)) {
+		chess_uci_print("info string invalid fen");
+		return;
+	}
+
+	// The moves are played in the game, whose keys let the search avoid or claim repetitions of the positions before it.
+	if (token != NULL && strcmp(token, "moves") == 0) {
+		size_t move_count = 0;
+		cursor += chess_game_do_uci_moves(&engine->game, cursor, &move_count);
+		if ((token = chess_uci_token(&cursor)) != NULL) {
+			flockfile(stdout);
+			printf("info string illegal move %s\n", token);
+			fflush(stdout);
+			funlockfile(stdout);
+		}
+	}
+}
+static void chess_uci_set_option(ChessUciEngine *engine, char *cursor) {
+	chess_uci_stop(engine, true);
+
+	char *token = chess_uci_token(&cursor);
+	if (token == NULL || strcmp(token, "name") != 0) {
+		return;
+	}
+
+	char *name  = chess_uci_token(&cursor);
+	token       = chess_uci_token(&cursor);
+	char *value = token != NULL && strcmp(token, "value") == 0 ? chess_uci_token(&cursor) : NULL;
+	if (name == NULL || value == NULL) {
+		return;
+	}
+
+	if (strcmp(name, "Hash") == 0) {
+		size_t hash = (size_t)strtoull(value, NULL, 10);
+		if (hash < 1) {
+			hash = 1;
+		} else if (hash > CHESS_UCI_MAXIMUM_HASH) {
+			hash = CHESS_UCI_MAXIMUM_HASH;
+		}
+
+		chess_transposition_table_drop(&engine->table);
+		engine->table = chess_transposition_table_new(hash * 1024 * 1024 / sizeof(ChessTranspositionTableSlot));
+	} else if (strcmp(name, "MultiPV") == 0) {
+		unsigned long line_count = strtoul(value, NULL, 10);
+		engine->line_count       = line_count < 1 ? 1 : line_count > CHESS_SEARCH_MAXIMUM_LINE_COUNT ? (unsigned int)CHESS_SEARCH_MAXIMUM_LINE_COUNT : (unsigned int)line_count;
+	}
+}
+// Handles a command, returning false once the engine should quit.
+static bool chess_uci_handle(ChessUciEngine *engine, char *line) {
+	char *cursor  = line;
+	char *command = chess_uci_token(&cursor);
+	if (command == NULL) {
+		return true;
+	}
+
+	if (strcmp(command, "uci") == 0) {
+		flockfile(stdout);
+		printf("id name chess\n");
+		printf("id author Tarek Saeed\n");
+		printf("option name Hash type spin default %zu min 1 max %zu\n", (size_t)CHESS_UCI_DEFAULT_HASH, (size_t)CHESS_UCI_MAXIMUM_HASH);
+		printf("option name MultiPV type spin default 1 min 1 max %zu\n", (size_t)CHESS_SEARCH_MAXIMUM_LINE_COUNT);
+		printf("option name Ponder type check default false\n");
+		printf("uciok\n");
+		fflush(stdout);
+		funlockfile(stdout);
+	} else if (strcmp(command, "isready") == 0) {
+		chess_uci_print("readyok");
+	} else if (strcmp(command, "ucinewgame") == 0) {
+		chess_uci_stop(engine, true);
+		chess_transposition_table_clear(&engine->table);
+	} else if (strcmp(command, "setoption") == 0) {
+		chess_uci_set_option(engine, cursor);
+	} else if (strcmp(command, "position") == 0) {
+		chess_uci_position(engine, cursor);
+	} else if (strcmp(command, "go") == 0) {
+		chess_uci_go(engine, cursor);
+	} else if (strcmp(command, "stop") == 0) {
+		chess_uci_stop(engine, false);
+	} else if (strcmp(command, "ponderhit") == 0) {
+		chess_uci_ponderhit(engine);
+	} else if (strcmp(command, "quit") == 0) {
+		return false;
+	}
+
+	return true;
+}
+
+int main(void) {
+	ChessUciEngine engine = {
+		.game                = chess_game_new(),
+		.table               = chess_transposition_table_new(CHESS_UCI_DEFAULT_HASH * 1024 * 1024 / sizeof(ChessTranspositionTableSlot)),
+		.line_count          = 1,
+		.stop                = false,
+		.is_search_requested = false,
+		.is_searching        = false,
+		.is_held             = false,
+		.is_pondering        = false,
+		.is_quitting         = false,
+		.ponder_time         = 0,
+		.deadline            = 0,
+	};
+	pthread_mutex_init(&engine.mutex, NULL);
+	pthread_cond_init(&engine.condition, NULL);
+
+	if (pthread_create(&engine.thread, NULL, chess_uci_search, &engine) != 0) {
+		(void)fprintf(stderr, "Error: Failed to start the search thread\n");
+		chess_transposition_table_drop(&engine.table);
+		chess_game_drop(&engine.game);
+		return EXIT_FAILURE;
+	}
+
+	ChessUciInput input = { .buffer = NULL, .size = 0, .length = 0, .line_length = 0, .is_closed = false };
+	while (true) {
+		char *line = chess_uci_input_line(&input);
+		if (line != NULL) {
+			if (!chess_uci_handle(&engine, line)) {
+				break;
+			}
+			continue;
+		}
+		if (input.is_closed) {
+			break;
+		}
+
+		// The input is polled until the deadline of a pondering search that was hit, if any.
+		pthread_mutex_lock(&engine.mutex);
+		uint64_t deadline = engine.deadline;
+		pthread_mutex_unlock(&engine.mutex);
+
+		int timeout       = -1;
+		if (deadline != 0) {
+			uint64_t now = chess_uci_milliseconds();
+			timeout      = deadline > now ? (int)(deadline - now) : 0;
+		}
+
+		struct pollfd descriptor = { .fd = STDIN_FILENO, .events = POLLIN, .revents = 0 };
+		int ready                = poll(&descriptor, 1, timeout);
+		if (ready < 0 && errno != EINTR) {
+			break;
+		}
+		if (ready > 0 && !chess_uci_input_read(&input)) {
+			break;
+		}
+		chess_uci_check_deadline(&engine);
+	}
+
+	chess_uci_stop(&engine, true);
+	pthread_mutex_lock(&engine.mutex);
+	engine.is_quitting = true;
+	pthread_cond_broadcast(&engine.condition);
+	pthread_mutex_unlock(&engine.mutex);
+	pthread_join(engine.thread, NULL);
+
+	pthread_cond_destroy(&engine.condition);
+	pthread_mutex_destroy(&engine.mutex);
+	chess_transposition_table_drop(&engine.table);
+	chess_game_drop(&engine.game);
+	free(input.buffer);
+
+	return EXIT_SUCCESS;
+}
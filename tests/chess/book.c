@@ -0,0 +1,212 @@
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmocka.h>
+
+#include <chess/book.h>
+
+#include <chess/move.h>
+#include <chess/position.h>
+#include <chess/square.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char *const book_path = "./book.bin";
+
+typedef struct ChessBookTestEntry {
+	const char *fen;
+	uint16_t move;
+	uint16_t weight;
+} ChessBookTestEntry;
+
+static uint16_t chess_book_test_move(ChessSquare from, ChessSquare to, unsigned int promotion) {
+	return (uint16_t)(chess_square_file(to) | chess_square_rank(to) << 3U | chess_square_file(from) << 6U |
+	                  chess_square_rank(from) << 9U | promotion << 12U);
+}
+static int chess_book_test_compare(const void *a, const void *b) {
+	const uint8_t *entry_a = a;
+	const uint8_t *entry_b = b;
+	for (size_t i = 0; i < 8; i++) {
+		if (entry_a[i] != entry_b[i]) {
+			return entry_a[i] < entry_b[i] ? -1 : 1;
+		}
+	}
+	return 0;
+}
+static bool chess_book_test_write(const ChessBookTestEntry *entries, size_t entry_count, bool is_sorted) {
+	uint8_t bytes[16][CHESS_BOOK_ENTRY_SIZE] = { { 0 } };
+	if (entry_count > CHESS_ARRAY_LENGTH(bytes)) {
+		return false;
+	}
+
+	for (size_t i = 0; i < entry_count; i++) {
+		ChessPosition position = chess_position_new();
+		if (!chess_position_from_fen(&position, entries[i].fen)) {
+			return false;
+		}
+
+		uint64_t key = chess_book_key(&position);
+		for (size_t j = 0; j < 8; j++) {
+			bytes[i][j] = (uint8_t)(key >> (56U - 8U * j));
+		}
+		bytes[i][8]  = (uint8_t)(entries[i].move >> 8U);
+		bytes[i][9]  = (uint8_t)entries[i].move;
+		bytes[i][10] = (uint8_t)(entries[i].weight >> 8U);
+		bytes[i][11] = (uint8_t)entries[i].weight;
+	}
+
+	if (is_sorted) {
+		qsort(bytes, entry_count, sizeof(bytes[0]), chess_book_test_compare);
+	}
+
+	FILE *file = fopen(book_path, "wb");
+	if (file == CHESS_NULL) {
+		return false;
+	}
+
+	bool is_successful = fwrite(bytes, sizeof(bytes[0]), entry_count, file) == entry_count;
+	return fclose(file) == 0 && is_successful;
+}
+
+static void test_chess_book_key(void **state) {
+	(void)state;
+
+	// The keys given by the description of the Polyglot book format.
+	static const struct {
+		const char *fen;
+		uint64_t key;
+	} test_cases[] = {
+		{ "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 0x463B96181691FC9CULL },
+		{ "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1", 0x823C9B50FD114196ULL },
+		{ "rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2", 0x0756B94461C50FB0ULL },
+		{ "rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2", 0x662FAFB965DB29D4ULL },
+		{ "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3", 0x22A48B5A8E47FF78ULL },
+		{ "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3", 0x652A607CA3F242C1ULL },
+		{ "rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4", 0x00FDD303C946BDD9ULL },
+		{ "rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3", 0x3C8123EA7B067637ULL },
+		{ "rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4", 0x5C3F9B829B279560ULL },
+	};
+
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(test_cases); i++) {
+		ChessPosition position = chess_position_new();
+		assert_true(chess_position_from_fen(&position, test_cases[i].fen));
+
+		assert_int_equal(chess_book_key(&position), test_cases[i].key);
+	}
+}
+
+static void test_chess_book_encode_move(void **state) {
+	(void)state;
+
+	static const struct {
+		const char *fen;
+		const char *move;
+		ChessSquare from;
+		ChessSquare to;
+		unsigned int promotion;
+	} test_cases[] = {
+		{ "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", "e4", CHESS_SQUARE_E2, CHESS_SQUARE_E4, 0 },
+		{ "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1", "O-O", CHESS_SQUARE_E1, CHESS_SQUARE_H1, 0 },
+		{ "r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 0 1", "O-O-O", CHESS_SQUARE_E8, CHESS_SQUARE_A8, 0 },
+		{ "4k3/1P6/8/8/8/8/8/4K3 w - - 0 1", "b8=N", CHESS_SQUARE_B7, CHESS_SQUARE_B8, 1 },
+		{ "4k3/8/8/8/8/8/6p1/4K2R b - - 0 1", "gxh1=Q", CHESS_SQUARE_G2, CHESS_SQUARE_H1, 4 },
+	};
+
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(test_cases); i++) {
+		ChessPosition position = chess_position_new();
+		assert_true(chess_position_from_fen(&position, test_cases[i].fen));
+
+		ChessMove move;
+		assert_true(chess_move_from_algebraic(&position, &move, test_cases[i].move));
+		assert_int_equal(chess_book_encode_move(&position, move), chess_book_test_move(test_cases[i].from, test_cases[i].to, test_cases[i].promotion));
+	}
+}
+
+static void test_chess_book_probe(void **state) {
+	(void)state;
+
+	static const char *const start_fen    = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+	static const char *const castling_fen = "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1";
+
+	const ChessBookTestEntry entries[]    = {
+		{ start_fen, chess_book_test_move(CHESS_SQUARE_E2, CHESS_SQUARE_E4, 0), 10 },
+		{ start_fen, chess_book_test_move(CHESS_SQUARE_E2, CHESS_SQUARE_E5, 0), 100 },
+		{ start_fen, chess_book_test_move(CHESS_SQUARE_D2, CHESS_SQUARE_D4, 0), 5 },
+		{ start_fen, chess_book_test_move(CHESS_SQUARE_B1, CHESS_SQUARE_C3, 0), 0 },
+		{ castling_fen, chess_book_test_move(CHESS_SQUARE_E1, CHESS_SQUARE_A1, 0), 1 },
+	};
+	assert_true(chess_book_test_write(entries, CHESS_ARRAY_LENGTH(entries), true));
+
+	ChessBook book = chess_book_new();
+	assert_true(chess_book_load(&book, book_path));
+	assert_int_equal(book.entry_count, CHESS_ARRAY_LENGTH(entries));
+
+	ChessPosition position = chess_position_new();
+	assert_true(chess_position_from_fen(&position, start_fen));
+
+	// The illegal move is skipped, however large its weight.
+	ChessMove move;
+	assert_true(chess_book_probe(&book, &position, CHESS_BOOK_SELECTION_BEST, 0, &move));
+	assert_int_equal(move.from, CHESS_SQUARE_E2);
+	assert_int_equal(move.to, CHESS_SQUARE_E4);
+
+	// The moves are chosen in proportion to their weights, e2e4 taking 10 of the 15 shares and Nc3 none.
+	size_t e4_count = 0;
+	for (uint32_t random = 0; random < 15; random++) {
+		assert_true(chess_book_probe(&book, &position, CHESS_BOOK_SELECTION_WEIGHTED, random, &move));
+		assert_true(move.from == CHESS_SQUARE_E2 || move.from == CHESS_SQUARE_D2);
+		e4_count += move.from == CHESS_SQUARE_E2;
+	}
+	assert_int_equal(e4_count, 10);
+
+	assert_true(chess_position_from_fen(&position, castling_fen));
+	assert_true(chess_book_probe(&book, &position, CHESS_BOOK_SELECTION_BEST, 0, &move));
+	assert_int_equal(move.from, CHESS_SQUARE_E1);
+	assert_int_equal(move.to, CHESS_SQUARE_C1);
+
+	assert_true(chess_position_from_fen(&position, "4k3/8/8/8/8/8/8/4K3 w - - 0 1"));
+	assert_false(chess_book_probe(&book, &position, CHESS_BOOK_SELECTION_BEST, 0, &move));
+	assert_false(chess_book_probe(&book, &position, CHESS_BOOK_SELECTION_WEIGHTED, 0, &move));
+
+	chess_book_drop(&book);
+	assert_int_equal(remove(book_path), 0);
+}
+
+static void test_chess_book_load(void **state) {
+	(void)state;
+
+	const ChessBookTestEntry entries[] = {
+		{ "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1", 0, 1 },
+		{ "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 0, 1 },
+	};
+
+	ChessBook book = chess_book_new();
+	assert_false(chess_book_load(&book, "./missing.bin"));
+
+	// The key of the start position is the smaller one, so the entries are not sorted as written.
+	assert_true(chess_book_test_write(entries, CHESS_ARRAY_LENGTH(entries), false));
+	assert_false(chess_book_load(&book, book_path));
+	assert_true(chess_book_is_valid(&book));
+	assert_int_equal(book.entry_count, 0);
+
+	assert_true(chess_book_test_write(entries, CHESS_ARRAY_LENGTH(entries), true));
+	assert_true(chess_book_load(&book, book_path));
+	assert_int_equal(book.entry_count, 2);
+
+	chess_book_drop(&book);
+	assert_int_equal(remove(book_path), 0);
+}
+
+int main(void) {
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_chess_book_key),
+		cmocka_unit_test(test_chess_book_encode_move),
+		cmocka_unit_test(test_chess_book_probe),
+		cmocka_unit_test(test_chess_book_load),
+	};
+
+	return cmocka_run_group_tests(tests, CHESS_NULL, CHESS_NULL);
+}
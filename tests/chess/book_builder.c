@@ -0,0 +1,127 @@
+// The book builder is a program of its own, so its source is included with its entry point renamed, for the test to
+// run it on a PGN file it writes.
+#define main chess_book_builder_main
+#include <book_builder.c>
+#undef main
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmocka.h>
+
+#include <chess/book.h>
+
+#include <chess/move.h>
+#include <chess/position.h>
+#include <chess/square.h>
+
+static const char *const pgn_path  = "./book_builder.pgn";
+static const char *const book_path = "./book_builder.bin";
+
+// Gets the weight of the given move in the given position from the entries of the book, or -1 if it has none.
+static int32_t chess_book_builder_test_weight(const ChessBook *book, const char *fen, const char *move_string) {
+	ChessPosition position = chess_position_new();
+	ChessMove move;
+	if (!chess_position_from_fen(&position, fen) || !chess_move_from_algebraic(&position, &move, move_string)) {
+		return -1;
+	}
+
+	uint64_t key          = chess_book_key(&position);
+	uint16_t encoded_move = chess_book_encode_move(&position, move);
+	for (size_t i = 0; i < book->entry_count; i++) {
+		const uint8_t *entry = &book->entries[i * CHESS_BOOK_ENTRY_SIZE];
+
+		uint64_t entry_key   = 0;
+		for (size_t j = 0; j < 8; j++) {
+			entry_key = entry_key << 8U | entry[j];
+		}
+		if (entry_key == key && (uint16_t)(entry[8] << 8U | entry[9]) == encoded_move) {
+			return entry[10] << 8U | entry[11];
+		}
+	}
+
+	return -1;
+}
+
+static void test_chess_book_builder_build(void **state) {
+	(void)state;
+
+	// The castlings are written with zeros in the first game, the second one running into its move number, and with
+	// letters in the second game.
+	FILE *file = fopen(pgn_path, "w");
+	assert_non_null(file);
+	assert_true(fputs("[Event \"First\"]\n"
+	                  "[Result \"1-0\"]\n"
+	                  "\n"
+	                  "1. e4 e5 2. Nf3 Nc6 3. Bc4 {Italian} Bc5 4. 0-0 Nf6 5. d3 5...0-0 1-0\n"
+	                  "\n"
+	                  "[Event \"Second\"]\n"
+	                  "[Result \"1/2-1/2\"]\n"
+	                  "\n"
+	                  "1. e4 e5 2. Nf3 Nc6 (2... d6) 3. Bc4 Bc5 4. O-O Nf6 5. d3 d6 1/2-1/2\n"
+	                  "\n"
+	                  "[Event \"Third\"]\n"
+	                  "[Result \"0-1\"]\n"
+	                  "\n"
+	                  "1. d4 d5 0-1\n",
+	                  file) >= 0);
+	assert_int_equal(fclose(file), 0);
+
+	// Two workers each read a share of the file, so that their entries are merged.
+	char program[]            = "book_builder";
+	char minimum_games_flag[] = "-m";
+	char minimum_games[]      = "1";
+	char worker_count_flag[]  = "-j";
+	char worker_count[]       = "2";
+	char book[]               = "./book_builder.bin";
+	char pgn[]                = "./book_builder.pgn";
+	char *arguments[]         = { program, minimum_games_flag, minimum_games, worker_count_flag, worker_count, book, pgn };
+	assert_int_equal(chess_book_builder_main((int)CHESS_ARRAY_LENGTH(arguments), arguments), EXIT_SUCCESS);
+
+	ChessBook loaded_book = chess_book_new();
+	assert_true(chess_book_load(&loaded_book, book_path));
+
+	// Ten moves of the first game, the one move of the second game departing from it and the two of the third game.
+	assert_int_equal(loaded_book.entry_count, 13);
+
+	// A move weighs twice its wins plus its draws.
+	static const char *const start_fen   = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+	static const char *const italian_fen = "r1bqk1nr/pppp1ppp/2n5/2b1p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4";
+	static const char *const castled_fen = "r1bqk2r/pppp1ppp/2n2n2/2b1p3/2B1P3/3P1N2/PPP2PPP/RNBQ1RK1 b kq - 0 5";
+	assert_int_equal(chess_book_builder_test_weight(&loaded_book, start_fen, "e4"), 3);
+	assert_int_equal(chess_book_builder_test_weight(&loaded_book, start_fen, "d4"), 0);
+	assert_int_equal(chess_book_builder_test_weight(&loaded_book, italian_fen, "O-O"), 3);
+	assert_int_equal(chess_book_builder_test_weight(&loaded_book, castled_fen, "O-O"), 0);
+	assert_int_equal(chess_book_builder_test_weight(&loaded_book, castled_fen, "d6"), 1);
+
+	ChessPosition position = chess_position_new();
+	ChessMove move;
+	assert_true(chess_position_from_fen(&position, start_fen));
+	assert_true(chess_book_probe(&loaded_book, &position, CHESS_BOOK_SELECTION_BEST, 0, &move));
+	assert_int_equal(move.from, CHESS_SQUARE_E2);
+	assert_int_equal(move.to, CHESS_SQUARE_E4);
+
+	assert_true(chess_position_from_fen(&position, italian_fen));
+	assert_true(chess_book_probe(&loaded_book, &position, CHESS_BOOK_SELECTION_BEST, 0, &move));
+	assert_int_equal(move.from, CHESS_SQUARE_E1);
+	assert_int_equal(move.to, CHESS_SQUARE_G1);
+
+	assert_true(chess_position_from_fen(&position, castled_fen));
+	assert_true(chess_book_probe(&loaded_book, &position, CHESS_BOOK_SELECTION_BEST, 0, &move));
+	assert_int_equal(move.from, CHESS_SQUARE_D7);
+	assert_int_equal(move.to, CHESS_SQUARE_D6);
+
+	chess_book_drop(&loaded_book);
+	assert_int_equal(remove(book_path), 0);
+	assert_int_equal(remove(pgn_path), 0);
+}
+
+int main(void) {
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_chess_book_builder_build),
+	};
+
+	return cmocka_run_group_tests(tests, CHESS_NULL, CHESS_NULL);
+}
@@ -0,0 +1,189 @@
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmocka.h>
+
+#include <chess/game.h>
+
+#include <chess/allocator.h>
+#include <chess/move.h>
+#include <chess/moves.h>
+#include <chess/position.h>
+
+#include <stdlib.h>
+
+static bool chess_game_test_play(ChessGame *game, const char *string) {
+	ChessMove move;
+	return chess_move_from_uci(chess_game_position(game), &move, string) != 0 && chess_game_do_move(game, move);
+}
+
+static void *chess_game_test_allocate(size_t size, void *data) {
+	(*(size_t *)data)++;
+	return malloc(size);
+}
+
+static void chess_game_test_deallocate(void *pointer, size_t size, void *data) {
+	(void)size;
+	(void)data;
+	free(pointer);
+}
+
+static void test_chess_game_do_move(void **state) {
+	(void)state;
+
+	ChessGame game      = chess_game_new();
+	ChessPosition start = *chess_game_position(&game);
+	assert_true(chess_game_is_valid(&game));
+
+	assert_true(chess_game_test_play(&game, "e2e4"));
+	assert_true(chess_game_test_play(&game, "e7e5"));
+	assert_int_equal(game.move_count, 2);
+	assert_int_equal(game.keys[0], chess_position_hash(&start));
+
+	// The position is a plain value, so a copy is not affected by moves played in the game.
+	ChessPosition position = *chess_game_position(&game);
+	ChessMove move         = chess_move_new(&position, CHESS_SQUARE_E4, CHESS_SQUARE_E5, CHESS_PIECE_TYPE_NONE);
+	assert_false(chess_game_do_move(&game, move));
+	assert_true(chess_game_test_play(&game, "g1f3"));
+	assert_int_equal(position.board[CHESS_SQUARE_G1], CHESS_PIECE_WHITE_KNIGHT);
+
+	assert_true(chess_game_undo_move(&game));
+	assert_int_equal(chess_position_hash(chess_game_position(&game)), chess_position_hash(&position));
+	assert_true(chess_game_undo_move(&game));
+	assert_true(chess_game_undo_move(&game));
+	assert_int_equal(chess_position_hash(chess_game_position(&game)), chess_position_hash(&start));
+	assert_false(chess_game_undo_move(&game));
+	assert_int_equal(chess_game_repetition_count(&game), 1);
+
+	chess_game_drop(&game);
+}
+
+static void test_chess_game_is_threefold_repetition(void **state) {
+	(void)state;
+
+	static const char *const moves[] = { "g1f3", "g8f6", "f3g1", "f6g8" };
+
+	ChessGame game                   = chess_game_new();
+	for (size_t i = 0; i < 2 * CHESS_ARRAY_LENGTH(moves); i++) {
+		assert_false(chess_game_is_threefold_repetition(&game));
+		assert_true(chess_game_test_play(&game, moves[i % CHESS_ARRAY_LENGTH(moves)]));
+	}
+	assert_int_equal(chess_game_repetition_count(&game), 3);
+	assert_true(chess_game_is_threefold_repetition(&game));
+
+	assert_true(chess_game_undo_move(&game));
+	assert_false(chess_game_is_threefold_repetition(&game));
+
+	// Resetting the game forgets its history.
+	ChessPosition position = chess_position_new();
+	assert_true(chess_game_reset(&game, &position));
+	assert_int_equal(game.move_count, 0);
+	assert_int_equal(chess_game_repetition_count(&game), 1);
+
+	chess_game_drop(&game);
+}
+
+static void test_chess_game_redo_move(void **state) {
+	(void)state;
+
+	ChessGame game = chess_game_new();
+	assert_false(chess_game_redo_move(&game));
+
+	assert_true(chess_game_test_play(&game, "e2e4"));
+	assert_true(chess_game_test_play(&game, "e7e5"));
+	ChessPosition position = *chess_game_position(&game);
+	assert_true(chess_game_test_play(&game, "g1f3"));
+
+	assert_true(chess_game_undo_move(&game));
+	assert_true(chess_game_undo_move(&game));
+	assert_true(chess_game_undo_move(&game));
+	assert_int_equal(game.redo_count, 3);
+	assert_true(chess_game_redo_move(&game));
+	assert_true(chess_game_redo_move(&game));
+	assert_int_equal(chess_position_hash(chess_game_position(&game)), chess_position_hash(&position));
+	assert_int_equal(chess_game_repetition_count(&game), 1);
+
+	// Playing the move that was taken back keeps the moves after it, any other move drops them.
+	assert_true(chess_game_undo_move(&game));
+	assert_true(chess_game_test_play(&game, "e7e5"));
+	assert_int_equal(game.redo_count, 1);
+	assert_true(chess_game_test_play(&game, "b1c3"));
+	assert_int_equal(game.redo_count, 0);
+	assert_false(chess_game_redo_move(&game));
+
+	assert_true(chess_game_undo_move(&game));
+	assert_true(chess_game_redo_move(&game));
+	assert_int_equal(game.moves[game.move_count - 1].from, CHESS_SQUARE_B1);
+	assert_int_equal(game.move_count, 3);
+
+	chess_game_drop(&game);
+}
+
+static void test_chess_game_do_moves(void **state) {
+	(void)state;
+
+	ChessGame game     = chess_game_new();
+	size_t move_count  = 0;
+	const char *string = "g1f3 g8f6 f3g1 f6g8 g1f3 g8f6 f3g1 f6g8 e2e5 e2e4";
+	assert_int_equal(chess_game_do_uci_moves(&game, string, &move_count), 39);
+	assert_int_equal(move_count, 8);
+	assert_int_equal(game.move_count, 8);
+	assert_true(chess_game_is_threefold_repetition(&game));
+
+	// The moves played are taken back one by one as if they had been played separately.
+	ChessMove moves[8];
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(moves); i++) {
+		moves[i] = game.moves[i];
+	}
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(moves); i++) {
+		assert_true(chess_game_undo_move(&game));
+	}
+	assert_int_equal(chess_game_repetition_count(&game), 1);
+
+	moves[5] = moves[4];
+	assert_int_equal(chess_game_do_moves(&game, moves, CHESS_ARRAY_LENGTH(moves)), 5);
+	assert_int_equal(game.move_count, 5);
+	assert_int_equal(game.keys[4], game.keys[0]);
+
+	chess_game_drop(&game);
+}
+
+static void test_chess_game_reserve(void **state) {
+	(void)state;
+
+	size_t allocation_count  = 0;
+	ChessAllocator allocator = {
+		.allocate   = chess_game_test_allocate,
+		.deallocate = chess_game_test_deallocate,
+		.data       = &allocation_count,
+	};
+	ChessGame game = chess_game_new_with_allocator(allocator);
+	assert_true(chess_game_reserve(&game, 200));
+
+	// Once room is made, playing the moves does not allocate.
+	size_t reserved_allocation_count = allocation_count;
+	for (size_t i = 0; i < 200; i++) {
+		ChessMoves moves = chess_moves_generate(chess_game_position(&game));
+		if (moves.count == 0) {
+			break;
+		}
+		assert_true(chess_game_do_move(&game, moves.moves[(i * 7) % moves.count]));
+	}
+	assert_int_equal(allocation_count, reserved_allocation_count);
+
+	chess_game_drop(&game);
+}
+
+int main(void) {
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_chess_game_do_move),
+		cmocka_unit_test(test_chess_game_is_threefold_repetition),
+		cmocka_unit_test(test_chess_game_redo_move),
+		cmocka_unit_test(test_chess_game_do_moves),
+		cmocka_unit_test(test_chess_game_reserve),
+	};
+
+	return cmocka_run_group_tests(tests, CHESS_NULL, CHESS_NULL);
+}
@@ -0,0 +1,111 @@
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmocka.h>
+
+#include <chess/game_tree.h>
+
+#include <chess/move.h>
+#include <chess/moves.h>
+#include <chess/position.h>
+
+static uint32_t chess_game_tree_test_add(ChessGameTree *tree, uint32_t node, const char *string) {
+	ChessPosition position = chess_game_tree_position(tree, node);
+	ChessMove move;
+	if (chess_move_from_uci(&position, &move, string) == 0) {
+		return CHESS_GAME_TREE_NONE;
+	}
+	return chess_game_tree_add_move(tree, node, move);
+}
+
+static void test_chess_game_tree_add_move(void **state) {
+	(void)state;
+
+	ChessPosition start = chess_position_new();
+	ChessGameTree tree  = chess_game_tree_new(&start);
+	assert_true(chess_game_tree_is_valid(&tree));
+	assert_int_equal(chess_game_tree_first_child(&tree, CHESS_GAME_TREE_ROOT), CHESS_GAME_TREE_NONE);
+
+	uint32_t e4 = chess_game_tree_test_add(&tree, CHESS_GAME_TREE_ROOT, "e2e4");
+	uint32_t d4 = chess_game_tree_test_add(&tree, CHESS_GAME_TREE_ROOT, "d2d4");
+	uint32_t c4 = chess_game_tree_test_add(&tree, CHESS_GAME_TREE_ROOT, "c2c4");
+	assert_int_not_equal(e4, CHESS_GAME_TREE_NONE);
+	assert_int_not_equal(d4, CHESS_GAME_TREE_NONE);
+	assert_int_not_equal(c4, CHESS_GAME_TREE_NONE);
+
+	// Adding a move that was already added gives back the same node, and an illegal move is rejected.
+	assert_int_equal(chess_game_tree_test_add(&tree, CHESS_GAME_TREE_ROOT, "d2d4"), d4);
+	assert_int_equal(tree.node_count, 4);
+	ChessMove move = chess_move_new(&start, CHESS_SQUARE_E2, CHESS_SQUARE_E5, CHESS_PIECE_TYPE_NONE);
+	assert_int_equal(chess_game_tree_add_move(&tree, CHESS_GAME_TREE_ROOT, move), CHESS_GAME_TREE_NONE);
+
+	uint32_t e5 = chess_game_tree_test_add(&tree, e4, "e7e5");
+	assert_int_equal(chess_game_tree_parent(&tree, e5), e4);
+	assert_int_equal(chess_game_tree_parent(&tree, CHESS_GAME_TREE_ROOT), CHESS_GAME_TREE_NONE);
+	assert_int_equal(chess_game_tree_move(&tree, e5).from, CHESS_SQUARE_E7);
+	ChessPosition position = chess_game_tree_position(&tree, e5);
+	assert_int_equal(position.board[CHESS_SQUARE_E5], CHESS_PIECE_BLACK_PAWN);
+	assert_int_equal(position.board[CHESS_SQUARE_E4], CHESS_PIECE_WHITE_PAWN);
+
+	// Promoting a variation makes it the main line, keeping the order of the other variations.
+	assert_int_equal(chess_game_tree_first_child(&tree, CHESS_GAME_TREE_ROOT), e4);
+	chess_game_tree_promote_variation(&tree, c4);
+	assert_int_equal(chess_game_tree_first_child(&tree, CHESS_GAME_TREE_ROOT), c4);
+	assert_int_equal(chess_game_tree_next_sibling(&tree, c4), e4);
+	assert_int_equal(chess_game_tree_next_sibling(&tree, e4), d4);
+	assert_int_equal(chess_game_tree_next_sibling(&tree, d4), CHESS_GAME_TREE_NONE);
+	chess_game_tree_promote_variation(&tree, c4);
+	assert_int_equal(chess_game_tree_first_child(&tree, CHESS_GAME_TREE_ROOT), c4);
+
+	chess_game_tree_drop(&tree);
+}
+
+static void test_chess_game_tree_position(void **state) {
+	(void)state;
+
+	ChessPosition position = chess_position_new();
+	ChessGameTree tree     = chess_game_tree_new(&position);
+
+	// Plays a long main line with a side variation at every move, checking the rebuilt positions against the played ones.
+	uint32_t node = CHESS_GAME_TREE_ROOT;
+	size_t ply    = 0;
+	for (; ply < 150; ply++) {
+		ChessMoves moves = chess_moves_generate(&position);
+		if (moves.count < 2) {
+			break;
+		}
+
+		uint32_t variation = chess_game_tree_add_move(&tree, node, moves.moves[(ply * 5 + 1) % moves.count]);
+		uint32_t child     = chess_game_tree_add_move(&tree, node, moves.moves[(ply * 7) % moves.count]);
+		assert_int_not_equal(variation, CHESS_GAME_TREE_NONE);
+		assert_int_not_equal(child, CHESS_GAME_TREE_NONE);
+
+		ChessPosition variation_position = position;
+		chess_move_do(&variation_position, chess_game_tree_move(&tree, variation));
+		ChessPosition tree_position = chess_game_tree_position(&tree, variation);
+		assert_int_equal(chess_position_hash(&tree_position), chess_position_hash(&variation_position));
+
+		chess_move_do(&position, chess_game_tree_move(&tree, child));
+		tree_position = chess_game_tree_position(&tree, child);
+		assert_int_equal(chess_position_hash(&tree_position), chess_position_hash(&position));
+		node = child;
+	}
+	assert_true(ply > 2 * CHESS_GAME_TREE_CHECKPOINT_INTERVAL);
+
+	// Only one position in every interval of moves along a line is cached.
+	assert_true(tree.checkpoint_count <= tree.node_count / CHESS_GAME_TREE_CHECKPOINT_INTERVAL + 1);
+	assert_true(tree.checkpoint_count >= 2);
+
+	chess_game_tree_drop(&tree);
+}
+
+int main(void) {
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_chess_game_tree_add_move),
+		cmocka_unit_test(test_chess_game_tree_position),
+	};
+
+	return cmocka_run_group_tests(tests, CHESS_NULL, CHESS_NULL);
+}
@@ -0,0 +1,72 @@
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmocka.h>
+
+#include <chess/mate.h>
+
+#include <chess/move.h>
+#include <chess/move_private.h>
+#include <chess/position.h>
+
+static void test_chess_mate_solve(void **state) {
+	(void)state;
+
+	static const struct {
+		const char *fen;
+		size_t move_count;
+	} test_cases[] = {
+		{ "6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1", 1 },
+		{ "kbK5/pp6/1P6/8/8/8/8/R7 w - - 0 1", 3 },
+		{ "r2qkb1r/pp2nppp/3p4/2pNN1B1/2BnP3/3P4/PPP2PPP/R2bK2R w KQkq - 1 1", 3 },
+		{ "r1b2k1r/ppppq3/5N1p/4P2Q/4PP2/1B6/PP5P/n2K2R1 w - - 1 1", 3 },
+	};
+
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(test_cases); i++) {
+		ChessPosition position = chess_position_new();
+		assert_true(chess_position_from_fen(&position, test_cases[i].fen));
+
+		ChessMateResult result = chess_mate_solve(&position, (ChessMateLimits){ .nodes = 0, .table_size = 0 });
+		assert_true(result.is_proven);
+		assert_int_equal(result.move_count, test_cases[i].move_count);
+
+		// The line is legal and ends in checkmate.
+		for (size_t j = 0; j < result.move_count; j++) {
+			assert_true(chess_move_is_legal(&position, result.moves[j]));
+			chess_move_do_unchecked(&position, result.moves[j]);
+		}
+		assert_true(chess_position_is_checkmate(&position));
+	}
+}
+
+static void test_chess_mate_solve_unproven(void **state) {
+	(void)state;
+
+	static const char *const fens[] = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"R5k1/5ppp/8/8/8/8/8/6K1 b - - 0 1",
+		"7k/5Q2/6K1/8/8/8/8/8 b - - 0 1",
+		"4k3/8/8/8/8/8/8/4K3 w - - 0 1",
+	};
+
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(fens); i++) {
+		ChessPosition position = chess_position_new();
+		assert_true(chess_position_from_fen(&position, fens[i]));
+
+		ChessMateResult result = chess_mate_solve(&position, (ChessMateLimits){ .nodes = 10000, .table_size = 1U << 12U });
+		assert_false(result.is_proven);
+		assert_int_equal(result.move_count, 0);
+		assert_true(result.nodes <= 10000);
+	}
+}
+
+int main(void) {
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_chess_mate_solve),
+		cmocka_unit_test(test_chess_mate_solve_unproven),
+	};
+
+	return cmocka_run_group_tests(tests, CHESS_NULL, CHESS_NULL);
+}
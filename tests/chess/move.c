@@ -7,6 +7,12 @@
 
 #include <chess/move.h>
 
+#include <chess/move_private.h>
+#include <chess/moves.h>
+#include <chess/position.h>
+
+#include <string.h>
+
 static void test_chess_move_is_valid(void **state) {
 	(void)state;
 
@@ -113,9 +119,201 @@ static void test_chess_move_is_valid(void **state) {
 	}
 }
 
+static void test_chess_move_uci(void **state) {
+	(void)state;
+
+	static const char *const fens[] = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+		"n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+	};
+
+	ChessPosition position = chess_position_new();
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(fens); i++) {
+		assert_true(chess_position_from_fen(&position, fens[i]));
+
+		ChessMoves moves = chess_moves_generate(&position);
+		for (size_t j = 0; j < moves.count; j++) {
+			char string[8];
+			size_t written = chess_move_to_uci(moves.moves[j], string, sizeof(string));
+			assert_int_equal(written, strlen(string));
+			assert_true(written == 4 || written == 5);
+
+			ChessMove move;
+			assert_int_equal(chess_move_from_uci(&position, &move, string), written);
+			assert_int_equal(move.from, moves.moves[j].from);
+			assert_int_equal(move.to, moves.moves[j].to);
+			assert_int_equal(move.promotion_type, moves.moves[j].promotion_type);
+		}
+	}
+
+	ChessMove move;
+	assert_true(chess_position_from_fen(&position, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"));
+	assert_int_equal(chess_move_from_uci(&position, &move, " e2e4 e7e5"), 5);
+	assert_int_equal(move.from, CHESS_SQUARE_E2);
+	assert_int_equal(move.to, CHESS_SQUARE_E4);
+	assert_int_equal(chess_move_from_uci(&position, &move, "e2e5"), 0);
+	assert_int_equal(chess_move_from_uci(&position, &move, "e7e5"), 0);
+	assert_int_equal(chess_move_from_uci(&position, &move, "e3e4"), 0);
+	assert_int_equal(chess_move_from_uci(&position, &move, "e2"), 0);
+	assert_int_equal(chess_move_from_uci(&position, &move, "0000"), 0);
+}
+
+static void test_chess_position_apply_moves(void **state) {
+	(void)state;
+
+	// Replays a long game both from its moves and from their UCI notation.
+	ChessMove moves[200];
+	char string[CHESS_ARRAY_LENGTH(moves) * 6] = { 0 };
+	size_t string_length                       = 0;
+	size_t move_count                          = 0;
+	ChessPosition position                     = chess_position_new();
+	while (move_count < CHESS_ARRAY_LENGTH(moves)) {
+		ChessMoves legal_moves = chess_moves_generate(&position);
+		if (legal_moves.count == 0) {
+			break;
+		}
+		moves[move_count] = legal_moves.moves[(move_count * 7) % legal_moves.count];
+		string_length += chess_move_to_uci(moves[move_count], string + string_length, sizeof(string) - string_length);
+		string[string_length++] = ' ';
+		assert_true(chess_move_do(&position, moves[move_count++]));
+	}
+
+	ChessPosition applied_position = chess_position_new();
+	assert_int_equal(chess_position_apply_moves(&applied_position, moves, move_count), move_count);
+	assert_int_equal(chess_position_hash(&applied_position), chess_position_hash(&position));
+
+	size_t applied_count = 0;
+	applied_position     = chess_position_new();
+	assert_int_equal(chess_position_apply_uci_moves(&applied_position, string, &applied_count), string_length);
+	assert_int_equal(applied_count, move_count);
+	assert_int_equal(chess_position_hash(&applied_position), chess_position_hash(&position));
+
+	// The moves stop at the first one that is malformed or illegal, here the king stepping into the check of the queen.
+	position = chess_position_new();
+	assert_int_equal(chess_position_apply_uci_moves(&position, "e2e4 f7f6 d1h5", &applied_count), 14);
+	applied_position = chess_position_new();
+	assert_int_equal(chess_position_apply_uci_moves(&applied_position, "e2e4 f7f6 d1h5 e8f7 g1f3", &applied_count), 14);
+	assert_int_equal(applied_count, 3);
+	assert_int_equal(chess_position_hash(&applied_position), chess_position_hash(&position));
+
+	applied_position = chess_position_new();
+	assert_int_equal(chess_position_apply_uci_moves(&applied_position, " e2e4x e7e5", &applied_count), 0);
+	assert_int_equal(applied_count, 0);
+	assert_int_equal(chess_position_apply_uci_moves(&applied_position, "", &applied_count), 0);
+}
+
+static void test_chess_move_new_if_pseudolegal(void **state) {
+	(void)state;
+
+	static const char *const fens[] = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/Pp2P3/2N2Q1p/1PPBBPPP/R3K2R b KQkq a3 0 1",
+		"n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+		"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+		"r3k2r/8/8/8/8/8/5r2/R3K2R w KQkq - 0 1",
+	};
+
+	// Every combination of squares and promotion is tried, and those that are pseudo-legal and legal are exactly the
+	// legal moves.
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(fens); i++) {
+		ChessPosition position;
+		assert_int_not_equal(chess_position_from_fen(&position, fens[i]), 0);
+		ChessMoves moves   = chess_moves_generate(&position);
+
+		size_t legal_count = 0;
+		for (ChessSquare from = CHESS_SQUARE_A1; from <= CHESS_SQUARE_H8; from++) {
+			for (ChessSquare to = CHESS_SQUARE_A1; to <= CHESS_SQUARE_H8; to++) {
+				for (ChessPieceType promotion_type = CHESS_PIECE_TYPE_PAWN; promotion_type <= CHESS_PIECE_TYPE_NONE; promotion_type++) {
+					ChessMove move;
+					ChessPosition position_after_move = position;
+					if (!chess_move_new_if_pseudolegal(&position, from, to, promotion_type, &move) ||
+					    !chess_move_do_if_legal(&position_after_move, move)) {
+						continue;
+					}
+
+					bool is_generated = false;
+					for (size_t j = 0; j < moves.count; j++) {
+						is_generated = is_generated || memcmp(&moves.moves[j], &move, sizeof(move)) == 0;
+					}
+					assert_true(is_generated);
+					legal_count++;
+				}
+			}
+		}
+		assert_int_equal(legal_count, moves.count);
+
+		// A move whose recorded state does not match the position is rejected.
+		for (size_t j = 0; j < moves.count; j++) {
+			ChessMove move      = moves.moves[j];
+			move.captured_piece = move.captured_piece == CHESS_PIECE_NONE ? CHESS_PIECE_WHITE_KNIGHT : CHESS_PIECE_NONE;
+			assert_false(chess_move_is_pseudolegal(&position, move));
+			move                          = moves.moves[j];
+			move.previous_half_move_clock = 5;
+			assert_false(chess_move_is_pseudolegal(&position, move));
+		}
+	}
+}
+
+static void test_chess_move_gives_check(void **state) {
+	(void)state;
+
+	static const char *const fens[] = {
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+		"n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+		"8/8/8/1k1pP2R/8/8/8/4K3 w - d6 0 1",
+		"3k4/8/8/8/8/8/8/R3K2R w KQ - 0 1",
+		"1k6/1P6/8/8/8/8/8/4K3 w - - 0 1",
+	};
+
+	// Every legal move along a few games from each position is checked against the move played out.
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(fens); i++) {
+		ChessPosition position;
+		assert_int_not_equal(chess_position_from_fen(&position, fens[i]), 0);
+		for (size_t ply = 0; ply < 40; ply++) {
+			ChessMoves moves = chess_moves_generate(&position);
+			if (moves.count == 0) {
+				break;
+			}
+
+			ChessMoveCheckInfo info = chess_move_check_info_new(&position);
+			for (size_t j = 0; j < moves.count; j++) {
+				ChessPosition position_after_move = position;
+				chess_move_do_unchecked(&position_after_move, moves.moves[j]);
+				assert_int_equal(chess_move_gives_check_with_info(&position, &info, moves.moves[j]), chess_position_is_check(&position_after_move));
+			}
+			assert_true(chess_move_do(&position, moves.moves[(ply * 7 + i) % moves.count]));
+		}
+	}
+
+	// The check suffixes of the algebraic notation follow from it, here for a discovered check and a checkmate.
+	ChessPosition position;
+	assert_int_not_equal(chess_position_from_fen(&position, "4k3/8/8/8/8/8/4N3/4R1K1 w - - 0 1"), 0);
+	ChessMove move;
+	char string[16];
+	assert_int_not_equal(chess_move_from_algebraic(&position, &move, "Nc3+"), 0);
+	assert_int_equal(chess_move_from_algebraic(&position, &move, "Ng3+"), 4);
+	assert_int_equal(chess_move_from_algebraic(&position, &move, "Ng3#"), 0);
+	assert_int_equal(chess_move_to_algebraic(&position, move, string, sizeof(string)), 4);
+	assert_string_equal(string, "Ng3+");
+
+	assert_int_not_equal(chess_position_from_fen(&position, "6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1"), 0);
+	assert_int_equal(chess_move_from_algebraic(&position, &move, "Ra8#"), 4);
+	assert_int_equal(chess_move_to_algebraic(&position, move, string, sizeof(string)), 4);
+	assert_string_equal(string, "Ra8#");
+	assert_int_equal(chess_move_from_algebraic(&position, &move, "Ra7+"), 0);
+}
+
 int main(void) {
 	const struct CMUnitTest tests[] = {
 		cmocka_unit_test(test_chess_move_is_valid),
+		cmocka_unit_test(test_chess_move_uci),
+		cmocka_unit_test(test_chess_position_apply_moves),
+		cmocka_unit_test(test_chess_move_new_if_pseudolegal),
+		cmocka_unit_test(test_chess_move_gives_check),
 	};
 
 	return cmocka_run_group_tests(tests, CHESS_NULL, CHESS_NULL);
@@ -37,8 +37,6 @@ static inline unsigned long chess_moves_perft(const char *fen, unsigned int dept
 
 	unsigned long result = chess_moves_perft_recursive(&position, depth);
 
-	chess_position_drop(&position);
-
 	return result;
 }
 
@@ -0,0 +1,182 @@
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmocka.h>
+
+#include <chess/network.h>
+
+#include <chess/move.h>
+#include <chess/moves.h>
+#include <chess/position.h>
+#include <chess/search.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *const network_path = "test_network.bin";
+CHESS_DEFINE_INTEGRAL_CONSTANT(size_t, hidden_size, 32);
+
+static void write_value(FILE *file, uint32_t value, size_t size) {
+	for (size_t i = 0; i < size; i++) {
+		fputc((int)((value >> (8 * i)) & 0xFF), file);
+	}
+}
+static int setup(void **state) {
+	(void)state;
+
+	FILE *file = fopen(network_path, "wb");
+	if (file == CHESS_NULL) {
+		return -1;
+	}
+
+	uint32_t random_state = 12345;
+	fwrite("CHNN", 1, 4, file);
+	write_value(file, 1, 4);
+	write_value(file, hidden_size, 4);
+	for (size_t i = 0; i < (CHESS_NETWORK_FEATURE_COUNT + 3) * hidden_size; i++) {
+		random_state = random_state * 1103515245 + 12345;
+		write_value(file, (uint32_t)((int32_t)((random_state >> 16) % 128) - 64), 2);
+	}
+	write_value(file, 100, 4);
+
+	return fclose(file);
+}
+static int teardown(void **state) {
+	(void)state;
+
+	return remove(network_path);
+}
+
+static void test_chess_network_load(void **state) {
+	(void)state;
+
+	ChessNetwork network = { 0 };
+	assert_false(chess_network_load(&network, "missing_network.bin"));
+
+	FILE *file = fopen("invalid_network.bin", "wb");
+	assert_non_null(file);
+	fwrite("NNHC", 1, 4, file);
+	fclose(file);
+	assert_false(chess_network_load(&network, "invalid_network.bin"));
+	remove("invalid_network.bin");
+
+	assert_true(chess_network_load(&network, network_path));
+	assert_true(chess_network_is_valid(&network));
+	assert_int_equal(network.hidden_size, hidden_size);
+	assert_int_equal(chess_network_accumulator_size(&network), 2 * hidden_size);
+	assert_int_equal(network.output_bias, 100);
+
+	chess_network_drop(&network);
+}
+static void test_chess_network_accumulator_update(void **state) {
+	(void)state;
+
+	static const char *const fens[] = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b KQkq - 0 1",
+		"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+		"n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+	};
+
+	ChessNetwork network = { 0 };
+	assert_true(chess_network_load(&network, network_path));
+
+	int16_t accumulator[2 * hidden_size];
+	int16_t accumulator_after_move[2 * hidden_size];
+	int16_t expected_accumulator[2 * hidden_size];
+
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(fens); i++) {
+		ChessPosition position = chess_position_new();
+		assert_true(chess_position_from_fen(&position, fens[i]));
+		chess_network_accumulator_refresh(&network, &position, accumulator);
+
+		ChessMoves moves = chess_moves_generate(&position);
+		for (size_t j = 0; j < moves.count; j++) {
+			chess_network_accumulator_update(&network, &position, moves.moves[j], accumulator, accumulator_after_move);
+
+			assert_true(chess_move_do(&position, moves.moves[j]));
+			chess_network_accumulator_refresh(&network, &position, expected_accumulator);
+			assert_memory_equal(accumulator_after_move, expected_accumulator, sizeof(expected_accumulator));
+
+			ChessScore score                    = chess_network_evaluate(&network, accumulator_after_move, position.side_to_move);
+			ChessNetworkInstructionSet detected = network.instruction_set;
+			for (ChessNetworkInstructionSet instruction_set = CHESS_NETWORK_INSTRUCTION_SET_SCALAR; instruction_set < detected; instruction_set++) {
+				network.instruction_set = instruction_set;
+				assert_int_equal(chess_network_evaluate(&network, accumulator_after_move, position.side_to_move), score);
+				chess_network_accumulator_refresh(&network, &position, expected_accumulator);
+				assert_memory_equal(accumulator_after_move, expected_accumulator, sizeof(expected_accumulator));
+			}
+			network.instruction_set = detected;
+
+			assert_true(chess_move_undo(&position, moves.moves[j]));
+		}
+	}
+
+	chess_network_drop(&network);
+}
+static void test_chess_network_output_overflow(void **state) {
+	(void)state;
+
+	ChessNetwork network;
+	assert_true(chess_network_load(&network, network_path));
+
+	// Half of the products of the largest hidden layer, all summed in the same lanes by the vectorised output, add up
+	// to more than fits in 32 bits, though the whole output, offset by the bias, is 0.
+	int16_t *weights = calloc(2 * CHESS_NETWORK_MAXIMUM_HIDDEN_SIZE, sizeof(*weights));
+	int16_t *values  = malloc(2 * CHESS_NETWORK_MAXIMUM_HIDDEN_SIZE * sizeof(*values));
+	assert_non_null(weights);
+	assert_non_null(values);
+	for (size_t i = 0; i < 2 * CHESS_NETWORK_MAXIMUM_HIDDEN_SIZE; i++) {
+		values[i] = CHESS_NETWORK_HIDDEN_QUANTISATION;
+		if (i < CHESS_NETWORK_MAXIMUM_HIDDEN_SIZE && i % 16 < 2) {
+			weights[i] = INT16_MAX;
+		} else if (i < CHESS_NETWORK_MAXIMUM_HIDDEN_SIZE && i % 16 < 4) {
+			weights[i] = -16384;
+		}
+	}
+
+	ChessNetwork wide_network = {
+		.hidden_size     = CHESS_NETWORK_MAXIMUM_HIDDEN_SIZE,
+		.feature_weights = network.feature_weights,
+		.feature_biases  = network.feature_biases,
+		.output_weights  = weights,
+		.output_bias     = -(int32_t)(CHESS_NETWORK_MAXIMUM_HIDDEN_SIZE / 8 * CHESS_NETWORK_HIDDEN_QUANTISATION * (INT16_MAX - 16384)),
+		.instruction_set = network.instruction_set,
+	};
+	for (ChessNetworkInstructionSet instruction_set = CHESS_NETWORK_INSTRUCTION_SET_SCALAR; instruction_set <= network.instruction_set; instruction_set++) {
+		wide_network.instruction_set = instruction_set;
+		assert_int_equal(chess_network_evaluate(&wide_network, values, CHESS_COLOR_WHITE), 0);
+	}
+
+	free(values);
+	free(weights);
+	chess_network_drop(&network);
+}
+static void test_chess_network_search(void **state) {
+	(void)state;
+
+	ChessNetwork network = { 0 };
+	assert_true(chess_network_load(&network, network_path));
+
+	ChessPosition position   = chess_position_new();
+	ChessSearchResult result = chess_search(&position, (ChessSearchLimits){ .depth = 3, .network = &network });
+	assert_int_equal(result.depth, 3);
+	assert_true(chess_move_is_legal(&position, result.best_move));
+
+	chess_network_drop(&network);
+}
+
+int main(void) {
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_chess_network_load),
+		cmocka_unit_test(test_chess_network_accumulator_update),
+		cmocka_unit_test(test_chess_network_output_overflow),
+		cmocka_unit_test(test_chess_network_search),
+	};
+
+	return cmocka_run_group_tests(tests, setup, teardown);
+}
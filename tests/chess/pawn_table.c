@@ -0,0 +1,113 @@
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmocka.h>
+
+#include <chess/pawn_table.h>
+
+#include <chess/move.h>
+#include <chess/moves.h>
+#include <chess/position.h>
+
+static void test_chess_pawn_table_new(void **state) {
+	(void)state;
+
+	ChessPawnTable table = chess_pawn_table_new(1000);
+	assert_true(chess_pawn_table_is_valid(&table));
+	assert_int_equal(table.size, 512);
+
+	chess_pawn_table_clear(&table);
+	assert_true(chess_pawn_table_is_valid(&table));
+
+	chess_pawn_table_drop(&table);
+	assert_true(chess_pawn_table_is_valid(&table));
+	assert_int_equal(table.size, 0);
+}
+static void test_chess_pawn_table_probe(void **state) {
+	(void)state;
+
+	static const char *const fens[] = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+		"4k3/8/8/8/8/8/8/4K3 w - - 0 1",
+	};
+
+	ChessPawnTable table = chess_pawn_table_new(64);
+
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(fens); i++) {
+		ChessPosition position = chess_position_new();
+		assert_true(chess_position_from_fen(&position, fens[i]));
+
+		ChessPawnTableEntry expected = chess_pawn_table_probe(CHESS_NULL, &position);
+		assert_int_equal(expected.key, position.pawn_hash);
+
+		for (size_t j = 0; j < 2; j++) {
+			ChessPawnTableEntry entry = chess_pawn_table_probe(&table, &position);
+			assert_int_equal(entry.key, expected.key);
+			assert_int_equal(entry.score, expected.score);
+			assert_memory_equal(entry.files, expected.files, sizeof(entry.files));
+		}
+
+		assert_int_equal(chess_position_evaluate_with_pawn_table(&position, &table), chess_position_evaluate(&position));
+	}
+
+	chess_pawn_table_drop(&table);
+}
+static void test_chess_pawn_table_pawn_hash(void **state) {
+	(void)state;
+
+	ChessPosition position = chess_position_new();
+	assert_true(chess_position_from_fen(&position, "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"));
+
+	uint64_t pawn_hash = position.pawn_hash;
+	ChessMoves moves   = chess_moves_generate(&position);
+	for (size_t i = 0; i < moves.count; i++) {
+		ChessPosition position_after_move = chess_position_new();
+		char fen[128]                     = { 0 };
+		bool moves_pawn                   = chess_piece_type(position.board[moves.moves[i].from]) == CHESS_PIECE_TYPE_PAWN ||
+		                  chess_piece_type(moves.moves[i].captured_piece) == CHESS_PIECE_TYPE_PAWN;
+
+		assert_true(chess_move_do(&position, moves.moves[i]));
+		chess_position_to_fen(&position, fen, sizeof(fen));
+		assert_true(chess_position_from_fen(&position_after_move, fen));
+		assert_int_equal(position.pawn_hash, position_after_move.pawn_hash);
+		if (moves_pawn) {
+			assert_true(position.pawn_hash != pawn_hash);
+		} else {
+			assert_int_equal(position.pawn_hash, pawn_hash);
+		}
+
+		assert_true(chess_move_undo(&position, moves.moves[i]));
+		assert_int_equal(position.pawn_hash, pawn_hash);
+	}
+}
+static void test_chess_pawn_table_blocker(void **state) {
+	(void)state;
+
+	ChessPawnTable table = chess_pawn_table_new(64);
+
+	// A knight standing in front of a pawn leaves the pawns as they were, so the cached entry must still be right.
+	ChessPosition position = chess_position_new();
+	assert_true(chess_position_from_fen(&position, "4k3/8/8/8/8/8/4P3/4K1N1 w - - 0 1"));
+	assert_int_equal(chess_position_evaluate_with_pawn_table(&position, &table), chess_position_evaluate(&position));
+
+	assert_true(chess_position_from_fen(&position, "4k3/8/8/8/8/4N3/4P3/4K3 w - - 0 1"));
+	assert_int_equal(chess_pawn_table_probe(&table, &position).score, chess_pawn_table_probe(CHESS_NULL, &position).score);
+	assert_int_equal(chess_position_evaluate_with_pawn_table(&position, &table), chess_position_evaluate(&position));
+
+	chess_pawn_table_drop(&table);
+}
+
+int main(void) {
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_chess_pawn_table_new),
+		cmocka_unit_test(test_chess_pawn_table_probe),
+		cmocka_unit_test(test_chess_pawn_table_pawn_hash),
+		cmocka_unit_test(test_chess_pawn_table_blocker),
+	};
+
+	return cmocka_run_group_tests(tests, CHESS_NULL, CHESS_NULL);
+}
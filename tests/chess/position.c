@@ -0,0 +1,41 @@
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmocka.h>
+
+#include <chess/position.h>
+
+static void test_chess_position_evaluate_mobility(void **state) {
+	(void)state;
+
+	// With only kings and pawns the score is that of the endgame, in which the king is worth as much on d1 as on e1, so
+	// moving it there only frees it from the pawns, adding a single square to the ones it can move to.
+	typedef struct TestCase {
+		const char *fen;
+		ChessScore score;
+	} TestCase;
+
+	static const TestCase test_cases[] = {
+		{ .fen = "3k4/2pp4/8/8/8/8/2PP4/3K4 w - - 0 1", .score = 0 },
+		{ .fen = "3k4/2pp4/8/8/8/8/2PP4/4K3 w - - 0 1", .score = 10 },
+		{ .fen = "4k3/2pp4/8/8/8/8/2PP4/3K4 w - - 0 1", .score = -10 },
+		{ .fen = "4k3/2pp4/8/8/8/8/2PP4/4K3 w - - 0 1", .score = 0 },
+	};
+
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(test_cases); i++) {
+		ChessPosition position = chess_position_new();
+		assert_true(chess_position_from_fen(&position, test_cases[i].fen));
+
+		assert_int_equal(chess_position_evaluate(&position), test_cases[i].score);
+	}
+}
+
+int main(void) {
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_chess_position_evaluate_mobility),
+	};
+
+	return cmocka_run_group_tests(tests, CHESS_NULL, CHESS_NULL);
+}
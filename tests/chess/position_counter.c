@@ -7,6 +7,8 @@
 
 #include <chess/position_counter.h>
 
+#include <chess/move.h>
+#include <chess/moves.h>
 #include <chess/position.h>
 
 static void test_chess_position_counter_is_valid(void **state) {
@@ -26,9 +28,80 @@ static void test_chess_position_counter_is_valid(void **state) {
 	assert_true(chess_position_counter_is_valid(&counter));
 }
 
+static void test_chess_position_counter_increment(void **state) {
+	(void)state;
+
+	// Plays a long deterministic game, so that the table grows several times before every position is removed again.
+	static ChessPosition positions[512];
+	size_t position_count       = 0;
+	positions[position_count++] = chess_position_new();
+	while (position_count < CHESS_ARRAY_LENGTH(positions)) {
+		ChessPosition position = positions[position_count - 1];
+		ChessMoves moves       = chess_moves_generate(&position);
+		if (moves.count == 0) {
+			break;
+		}
+		assert_true(chess_move_do(&position, moves.moves[(position_count * 7) % moves.count]));
+		positions[position_count++] = position;
+	}
+
+	ChessPositionCounter counter = chess_position_counter_new();
+	for (size_t i = 0; i < position_count; i++) {
+		assert_true(chess_position_counter_increment(&counter, &positions[i]));
+	}
+	assert_true(chess_position_counter_is_valid(&counter));
+
+	for (size_t i = 0; i < position_count; i++) {
+		unsigned int count = 0;
+		for (size_t j = 0; j < position_count; j++) {
+			count += chess_position_hash(&positions[j]) == chess_position_hash(&positions[i]);
+		}
+		assert_int_equal(chess_position_counter_count(&counter, &positions[i]), count);
+	}
+
+	for (size_t i = position_count; i-- > 0;) {
+		assert_true(chess_position_counter_decrement(&counter, &positions[i]));
+		assert_true(chess_position_counter_is_valid(&counter));
+
+		unsigned int count = 0;
+		for (size_t j = 0; j < i; j++) {
+			count += chess_position_hash(&positions[j]) == chess_position_hash(&positions[i]);
+		}
+		assert_int_equal(chess_position_counter_count(&counter, &positions[i]), count);
+	}
+	assert_int_equal(counter.count, 0);
+	assert_false(chess_position_counter_decrement(&counter, &positions[0]));
+
+	chess_position_counter_drop(&counter);
+}
+
+static void test_chess_position_counter_reserve(void **state) {
+	(void)state;
+
+	ChessPositionCounter counter = chess_position_counter_new();
+	assert_true(chess_position_counter_reserve(&counter, 300));
+	assert_true(chess_position_counter_is_valid(&counter));
+
+	size_t size            = counter.size;
+	ChessPosition position = chess_position_new();
+	for (size_t i = 0; i < 300; i++) {
+		ChessMoves moves = chess_moves_generate(&position);
+		if (moves.count == 0) {
+			break;
+		}
+		assert_true(chess_move_do(&position, moves.moves[(i * 7) % moves.count]));
+		assert_true(chess_position_counter_increment(&counter, &position));
+	}
+	assert_int_equal(counter.size, size);
+
+	chess_position_counter_drop(&counter);
+}
+
 int main(void) {
 	const struct CMUnitTest tests[] = {
 		cmocka_unit_test(test_chess_position_counter_is_valid),
+		cmocka_unit_test(test_chess_position_counter_increment),
+		cmocka_unit_test(test_chess_position_counter_reserve),
 	};
 
 	return cmocka_run_group_tests(tests, CHESS_NULL, CHESS_NULL);
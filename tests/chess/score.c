@@ -0,0 +1,89 @@
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmocka.h>
+
+#include <chess/score.h>
+
+static void test_chess_score_is_mate(void **state) {
+	(void)state;
+
+	typedef struct TestCase {
+		ChessScore score;
+		bool is_mate;
+	} TestCase;
+
+	static const TestCase test_cases[] = {
+		{ .score = CHESS_SCORE_DRAW, .is_mate = false },
+		{ .score = 150, .is_mate = false },
+		{ .score = -2500, .is_mate = false },
+		{ .score = CHESS_SCORE_MATE_BOUND - 1, .is_mate = false },
+		{ .score = CHESS_SCORE_MATE_BOUND, .is_mate = true },
+		{ .score = CHESS_SCORE_MATE, .is_mate = true },
+		{ .score = -CHESS_SCORE_MATE, .is_mate = true },
+		{ .score = CHESS_SCORE_INFINITE, .is_mate = false },
+		{ .score = -CHESS_SCORE_INFINITE, .is_mate = false },
+	};
+
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(test_cases); i++) {
+		bool is_mate = chess_score_is_mate(test_cases[i].score);
+		if (test_cases[i].is_mate) {
+			assert_true(is_mate);
+		} else {
+			assert_false(is_mate);
+		}
+	}
+}
+static void test_chess_score_mate_plies(void **state) {
+	(void)state;
+
+	for (unsigned int plies = 0; plies <= 100; plies++) {
+		ChessScore mate  = chess_score_mate_in(plies);
+		ChessScore mated = chess_score_mated_in(plies);
+		assert_true(chess_score_is_mate(mate));
+		assert_true(chess_score_is_mate(mated));
+		assert_true(mate > 0 && mated < 0);
+		assert_int_equal(chess_score_mate_plies(mate), plies);
+		assert_int_equal(chess_score_mate_plies(mated), plies);
+		assert_true(chess_score_mate_in(plies + 1) < mate);
+		assert_true(chess_score_mated_in(plies + 1) > mated);
+	}
+}
+static void test_chess_score_to_string(void **state) {
+	(void)state;
+
+	typedef struct TestCase {
+		ChessScore score;
+		const char *string;
+		size_t written;
+	} TestCase;
+
+	static const TestCase test_cases[] = {
+		{ .score = CHESS_SCORE_DRAW, .string = "+0.00", .written = 5 },
+		{ .score = 35, .string = "+0.35", .written = 5 },
+		{ .score = -100, .string = "-1.00", .written = 5 },
+		{ .score = 1205, .string = "+12.05", .written = 6 },
+		{ .score = CHESS_SCORE_MATE - 1, .string = "#1", .written = 2 },
+		{ .score = CHESS_SCORE_MATE - 5, .string = "#3", .written = 2 },
+		{ .score = -CHESS_SCORE_MATE + 4, .string = "#-2", .written = 3 },
+	};
+
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(test_cases); i++) {
+		char string[16] = { 0 };
+		size_t written  = chess_score_to_string(test_cases[i].score, string, sizeof(string));
+		assert_string_equal(string, test_cases[i].string);
+		assert_int_equal(written, test_cases[i].written);
+	}
+}
+
+int main(void) {
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_chess_score_is_mate),
+		cmocka_unit_test(test_chess_score_mate_plies),
+		cmocka_unit_test(test_chess_score_to_string),
+	};
+
+	return cmocka_run_group_tests(tests, CHESS_NULL, CHESS_NULL);
+}
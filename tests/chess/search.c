@@ -0,0 +1,217 @@
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmocka.h>
+
+#include <chess/search.h>
+
+#include <chess/move.h>
+#include <chess/move_private.h>
+#include <chess/position.h>
+#include <chess/transposition_table.h>
+
+static void test_chess_search_depth(void **state) {
+	(void)state;
+
+	ChessPosition position = chess_position_new();
+
+	ChessSearchResult result = chess_search(&position, (ChessSearchLimits){ .depth = 3 });
+	assert_int_equal(result.depth, 3);
+	assert_true(chess_move_is_legal(&position, result.best_move));
+}
+
+static void test_chess_search_nodes(void **state) {
+	(void)state;
+
+	ChessPosition position = chess_position_new();
+
+	ChessSearchResult result = chess_search(&position, (ChessSearchLimits){ .nodes = 5000 });
+	assert_true(result.nodes <= 5000);
+	assert_true(result.depth < CHESS_SEARCH_MAXIMUM_DEPTH);
+	assert_true(chess_move_is_legal(&position, result.best_move));
+}
+
+static void test_chess_search_time(void **state) {
+	(void)state;
+
+	ChessPosition position = chess_position_new();
+
+	ChessSearchResult result = chess_search(&position, (ChessSearchLimits){ .time = 50 });
+	assert_true(result.time < 1000);
+	assert_true(chess_move_is_legal(&position, result.best_move));
+}
+
+static void test_chess_search_stop(void **state) {
+	(void)state;
+
+	ChessPosition position = chess_position_new();
+
+	CHESS_ATOMIC(bool) stop  = true;
+	ChessSearchResult result = chess_search(&position, (ChessSearchLimits){ .stop = &stop });
+	assert_int_equal(result.depth, 0);
+	assert_true(result.nodes <= CHESS_SEARCH_POLL_INTERVAL);
+	assert_true(chess_move_is_legal(&position, result.best_move));
+}
+
+static void test_chess_search_no_moves(void **state) {
+	(void)state;
+
+	ChessPosition position = chess_position_new();
+	assert_true(chess_position_from_fen(&position, "7k/5Q2/6K1/8/8/8/8/8 b - - 0 1"));
+
+	ChessSearchResult result = chess_search(&position, (ChessSearchLimits){ .depth = 2 });
+	assert_int_equal(result.best_move.from, CHESS_SQUARE_NONE);
+	assert_int_equal(result.best_move.to, CHESS_SQUARE_NONE);
+}
+
+static void test_chess_search_mate(void **state) {
+	(void)state;
+
+	ChessPosition position = chess_position_new();
+	assert_true(chess_position_from_fen(&position, "6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1"));
+
+	ChessSearchResult result = chess_search(&position, (ChessSearchLimits){ .depth = 3 });
+	assert_int_equal(result.best_move.from, CHESS_SQUARE_A1);
+	assert_int_equal(result.best_move.to, CHESS_SQUARE_A8);
+	assert_int_equal(result.score, chess_score_mate_in(1));
+}
+
+static void test_chess_search_lines(void **state) {
+	(void)state;
+
+	ChessPosition position   = chess_position_new();
+
+	ChessSearchResult result = chess_search(&position, (ChessSearchLimits){ .depth = 4, .line_count = 3 });
+	assert_int_equal(result.line_count, 3);
+	assert_int_equal(result.lines[0].score, result.score);
+	assert_int_equal(result.lines[0].moves[0].from, result.best_move.from);
+	assert_int_equal(result.lines[0].moves[0].to, result.best_move.to);
+
+	for (size_t i = 0; i < result.line_count; i++) {
+		const ChessSearchLine *line = &result.lines[i];
+		assert_true(line->move_count >= 1 && line->move_count <= 4);
+		if (i > 0) {
+			assert_true(line->score <= result.lines[i - 1].score);
+			assert_false(line->moves[0].from == result.lines[i - 1].moves[0].from && line->moves[0].to == result.lines[i - 1].moves[0].to);
+		}
+
+		ChessPosition position_after_line = position;
+		for (size_t j = 0; j < line->move_count; j++) {
+			assert_true(chess_move_is_legal(&position_after_line, line->moves[j]));
+			chess_move_do_unchecked(&position_after_line, line->moves[j]);
+		}
+	}
+
+	// There are fewer legal moves than lines asked for.
+	assert_true(chess_position_from_fen(&position, "k7/8/8/8/8/8/1R6/7K b - - 0 1"));
+	result = chess_search(&position, (ChessSearchLimits){ .depth = 2, .line_count = 5 });
+	assert_int_equal(result.line_count, 1);
+}
+
+static void test_chess_search_table(void **state) {
+	(void)state;
+
+	ChessPosition position        = chess_position_new();
+	ChessTranspositionTable table = chess_transposition_table_new(1U << 16U);
+
+	// The table is kept warm across searches, so a second search of the same position costs fewer nodes.
+	ChessSearchResult first  = chess_search(&position, (ChessSearchLimits){ .depth = 4, .table = &table });
+	ChessSearchResult second = chess_search(&position, (ChessSearchLimits){ .depth = 4, .table = &table });
+	assert_true(second.nodes < first.nodes);
+	assert_int_equal(second.score, first.score);
+	assert_true(chess_move_is_legal(&position, second.best_move));
+
+	chess_transposition_table_drop(&table);
+}
+
+typedef struct TestIterations {
+	ChessSearchStatistics statistics[CHESS_SEARCH_MAXIMUM_DEPTH];
+	size_t count;
+} TestIterations;
+
+static void test_chess_search_statistics_callback(const ChessSearchStatistics *statistics, void *data) {
+	TestIterations *iterations = data;
+	assert_true(iterations->count < CHESS_SEARCH_MAXIMUM_DEPTH);
+	iterations->statistics[iterations->count++] = *statistics;
+}
+
+static void test_chess_search_statistics(void **state) {
+	(void)state;
+
+	ChessPosition position    = chess_position_new();
+
+	TestIterations iterations = { .count = 0 };
+	ChessSearchResult result  = chess_search(&position, (ChessSearchLimits){ .depth = 4, .callback = test_chess_search_statistics_callback, .callback_data = &iterations });
+	assert_int_equal(iterations.count, 4);
+
+	uint64_t nodes             = 0;
+	for (size_t i = 0; i < iterations.count; i++) {
+		const ChessSearchStatistics *statistics = &iterations.statistics[i];
+		assert_int_equal(statistics->depth, i + 1);
+		assert_true(statistics->selective_depth >= 1 && statistics->selective_depth <= statistics->depth);
+		assert_true(statistics->leaf_nodes <= statistics->nodes);
+		assert_true(statistics->table_hits <= statistics->table_probes);
+		assert_true(statistics->first_move_cutoff_count <= statistics->cutoff_count);
+		assert_true(chess_move_is_legal(&position, statistics->best_move));
+
+		nodes += statistics->nodes;
+		assert_int_equal(statistics->total_nodes, nodes);
+		if (i == 0) {
+			assert_true(statistics->effective_branching_factor <= 0.0);
+		} else {
+			assert_true(statistics->effective_branching_factor > 0.0);
+		}
+	}
+
+	const ChessSearchStatistics *last = &iterations.statistics[iterations.count - 1];
+	assert_int_equal(result.nodes, nodes);
+	assert_int_equal(result.statistics.depth, last->depth);
+	assert_int_equal(result.statistics.nodes, last->nodes);
+	assert_int_equal(result.statistics.score, result.score);
+	assert_true(last->cutoff_count > 0);
+	assert_true(last->table_probes > 0);
+}
+
+static void test_chess_search_repetition(void **state) {
+	(void)state;
+
+	ChessPosition position = chess_position_new();
+	assert_true(chess_position_from_fen(&position, "2q4k/8/8/8/8/8/8/7K w - - 10 60"));
+
+	ChessSearchResult result = chess_search(&position, (ChessSearchLimits){ .depth = 3 });
+	assert_true(result.score < -500);
+
+	// The position after Kg2 was played three plies before the root, so reaching it again draws the lost game.
+	ChessPosition position_after_move = position;
+	chess_move_do_unchecked(&position_after_move, chess_move_new(&position, CHESS_SQUARE_H1, CHESS_SQUARE_G2, CHESS_PIECE_TYPE_NONE));
+	uint64_t keys[] = { chess_position_hash(&position_after_move), 1, 2 };
+
+	result          = chess_search(&position, (ChessSearchLimits){ .depth = 3, .keys = keys, .key_count = CHESS_ARRAY_LENGTH(keys) });
+	assert_int_equal(result.best_move.from, CHESS_SQUARE_H1);
+	assert_int_equal(result.best_move.to, CHESS_SQUARE_G2);
+	assert_int_equal(result.score, CHESS_SCORE_DRAW);
+
+	// Beyond the half-move clock, the same keys cannot be repeated.
+	assert_true(chess_position_from_fen(&position, "2q4k/8/8/8/8/8/8/7K w - - 2 60"));
+	result = chess_search(&position, (ChessSearchLimits){ .depth = 3, .keys = keys, .key_count = CHESS_ARRAY_LENGTH(keys) });
+	assert_true(result.score < -500);
+}
+
+int main(void) {
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_chess_search_depth),
+		cmocka_unit_test(test_chess_search_nodes),
+		cmocka_unit_test(test_chess_search_time),
+		cmocka_unit_test(test_chess_search_stop),
+		cmocka_unit_test(test_chess_search_no_moves),
+		cmocka_unit_test(test_chess_search_mate),
+		cmocka_unit_test(test_chess_search_lines),
+		cmocka_unit_test(test_chess_search_table),
+		cmocka_unit_test(test_chess_search_statistics),
+		cmocka_unit_test(test_chess_search_repetition),
+	};
+
+	return cmocka_run_group_tests(tests, CHESS_NULL, CHESS_NULL);
+}
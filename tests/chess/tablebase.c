@@ -0,0 +1,126 @@
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmocka.h>
+
+#include <chess/tablebase.h>
+
+#include <chess/position.h>
+#include <chess/score.h>
+#include <chess/search.h>
+#include <chess/square.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char *const table_path = "./KQvK.ctb";
+
+static int setup(void **state) {
+	ChessTablebase *tablebase = malloc(sizeof(*tablebase));
+	if (tablebase == CHESS_NULL) {
+		return -1;
+	}
+
+	*tablebase = chess_tablebase_new();
+	if (!chess_tablebase_generate(tablebase, ".", "KvKQ")) {
+		free(tablebase);
+		return -1;
+	}
+
+	*state = tablebase;
+
+	return 0;
+}
+static int teardown(void **state) {
+	ChessTablebase *tablebase = *state;
+
+	chess_tablebase_drop(tablebase);
+	free(tablebase);
+
+	return remove(table_path);
+}
+
+static void test_chess_tablebase_load(void **state) {
+	(void)state;
+
+	ChessTablebase tablebase = chess_tablebase_new();
+	assert_false(chess_tablebase_load(&tablebase, "missing_table.ctb"));
+
+	FILE *file = fopen("invalid_table.ctb", "wb");
+	assert_non_null(file);
+	fwrite("CHTB", 1, 4, file);
+	fclose(file);
+	assert_false(chess_tablebase_load(&tablebase, "invalid_table.ctb"));
+	remove("invalid_table.ctb");
+
+	assert_true(chess_tablebase_load(&tablebase, table_path));
+	assert_int_equal(tablebase.table_count, 1);
+	assert_int_equal(tablebase.maximum_piece_count, 3);
+	assert_false(chess_tablebase_load(&tablebase, table_path));
+
+	chess_tablebase_drop(&tablebase);
+}
+
+static void test_chess_tablebase_probe(void **state) {
+	const ChessTablebase *tablebase = *state;
+
+	static const struct {
+		const char *fen;
+		ChessTablebaseOutcome outcome;
+		unsigned int moves;
+	} test_cases[] = {
+		{ "7k/8/6K1/8/8/8/8/1Q6 w - - 0 1", CHESS_TABLEBASE_OUTCOME_WIN, 1 },
+		{ "7K/8/6k1/8/8/8/8/1q6 b - - 0 1", CHESS_TABLEBASE_OUTCOME_WIN, 1 },
+		{ "1Q5k/8/6K1/8/8/8/8/8 b - - 0 1", CHESS_TABLEBASE_OUTCOME_LOSS, 0 },
+		{ "7k/5Q2/6K1/8/8/8/8/8 b - - 0 1", CHESS_TABLEBASE_OUTCOME_DRAW, 0 },
+		{ "7k/8/8/8/8/8/8/Kq6 w - - 0 1", CHESS_TABLEBASE_OUTCOME_DRAW, 0 },
+		{ "8/8/8/3k4/8/8/8/KQ6 w - - 0 1", CHESS_TABLEBASE_OUTCOME_WIN, 9 },
+	};
+
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(test_cases); i++) {
+		ChessPosition position = chess_position_new();
+		assert_true(chess_position_from_fen(&position, test_cases[i].fen));
+
+		ChessTablebaseResult result;
+		assert_true(chess_tablebase_probe(tablebase, &position, &result));
+		assert_int_equal(result.outcome, test_cases[i].outcome);
+		assert_int_equal(result.moves, test_cases[i].moves);
+	}
+
+	ChessPosition position = chess_position_new();
+	assert_false(chess_tablebase_probe(tablebase, &position, &(ChessTablebaseResult){ 0 }));
+
+	assert_true(chess_position_from_fen(&position, "4k3/8/8/8/8/8/8/4K2R w K - 0 1"));
+	assert_false(chess_tablebase_probe(tablebase, &position, &(ChessTablebaseResult){ 0 }));
+}
+
+static void test_chess_tablebase_search(void **state) {
+	const ChessTablebase *tablebase = *state;
+
+	ChessPosition position          = chess_position_new();
+	assert_true(chess_position_from_fen(&position, "7k/8/6K1/8/8/8/8/1Q6 w - - 0 1"));
+
+	ChessSearchResult result = chess_search(&position, (ChessSearchLimits){ .depth = 1, .tablebase = tablebase });
+	assert_int_equal(result.best_move.from, CHESS_SQUARE_B1);
+	assert_int_equal(result.best_move.to, CHESS_SQUARE_B8);
+	assert_int_equal(result.score, chess_score_mate_in(1));
+
+	ChessTablebaseResult tablebase_result;
+	assert_true(chess_position_from_fen(&position, "8/8/8/3k4/8/8/8/KQ6 w - - 0 1"));
+	assert_true(chess_tablebase_probe(tablebase, &position, &tablebase_result));
+
+	result = chess_search(&position, (ChessSearchLimits){ .depth = 1, .tablebase = tablebase });
+	assert_int_equal(result.score, chess_score_mate_in(2 * tablebase_result.moves - 1));
+}
+
+int main(void) {
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_chess_tablebase_load),
+		cmocka_unit_test(test_chess_tablebase_probe),
+		cmocka_unit_test(test_chess_tablebase_search),
+	};
+
+	return cmocka_run_group_tests(tests, setup, teardown);
+}
@@ -0,0 +1,172 @@
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmocka.h>
+
+#include <chess/transposition_table.h>
+
+#include <chess/piece_type.h>
+#include <chess/score.h>
+#include <chess/square.h>
+
+static void test_chess_transposition_table_new(void **state) {
+	(void)state;
+
+	ChessTranspositionTable table = chess_transposition_table_new(1000);
+	assert_true(chess_transposition_table_is_valid(&table));
+	assert_int_equal(table.size, 512);
+
+	chess_transposition_table_clear(&table);
+	assert_true(chess_transposition_table_is_valid(&table));
+
+	chess_transposition_table_drop(&table);
+	assert_true(chess_transposition_table_is_valid(&table));
+	assert_int_equal(table.size, 0);
+}
+
+static void test_chess_transposition_table_probe(void **state) {
+	(void)state;
+
+	ChessTranspositionTable table = chess_transposition_table_new(64);
+
+	// A cleared table holds no entry, not even for a key of 0.
+	ChessTranspositionTableEntry entry;
+	assert_false(chess_transposition_table_probe(&table, 0, &entry));
+
+	chess_transposition_table_store(
+	    &table,
+	    (ChessTranspositionTableEntry){
+	        .key            = 0x1234,
+	        .score          = 25,
+	        .depth          = 4,
+	        .bound          = CHESS_TRANSPOSITION_TABLE_BOUND_EXACT,
+	        .from           = CHESS_SQUARE_E2,
+	        .to             = CHESS_SQUARE_E4,
+	        .promotion_type = CHESS_PIECE_TYPE_NONE,
+	    }
+	);
+	assert_true(chess_transposition_table_probe(&table, 0x1234, &entry));
+	assert_int_equal(entry.score, 25);
+	assert_int_equal(entry.depth, 4);
+	assert_int_equal(entry.from, CHESS_SQUARE_E2);
+	assert_int_equal(entry.to, CHESS_SQUARE_E4);
+
+	// The same slot, but another position.
+	assert_false(chess_transposition_table_probe(&table, 0x1234 + 64, &entry));
+
+	// A shallower bound does not replace the entry of the same position.
+	chess_transposition_table_store(
+	    &table,
+	    (ChessTranspositionTableEntry){
+	        .key            = 0x1234,
+	        .score          = 100,
+	        .depth          = 2,
+	        .bound          = CHESS_TRANSPOSITION_TABLE_BOUND_LOWER,
+	        .from           = CHESS_SQUARE_D2,
+	        .to             = CHESS_SQUARE_D4,
+	        .promotion_type = CHESS_PIECE_TYPE_NONE,
+	    }
+	);
+	assert_true(chess_transposition_table_probe(&table, 0x1234, &entry));
+	assert_int_equal(entry.score, 25);
+
+	// A deeper entry without a best move keeps the best move already stored.
+	chess_transposition_table_store(
+	    &table,
+	    (ChessTranspositionTableEntry){
+	        .key            = 0x1234,
+	        .score          = -10,
+	        .depth          = 5,
+	        .bound          = CHESS_TRANSPOSITION_TABLE_BOUND_UPPER,
+	        .from           = CHESS_SQUARE_NONE,
+	        .to             = CHESS_SQUARE_NONE,
+	        .promotion_type = CHESS_PIECE_TYPE_NONE,
+	    }
+	);
+	assert_true(chess_transposition_table_probe(&table, 0x1234, &entry));
+	assert_int_equal(entry.score, -10);
+	assert_int_equal(entry.bound, CHESS_TRANSPOSITION_TABLE_BOUND_UPPER);
+	assert_int_equal(entry.from, CHESS_SQUARE_E2);
+	assert_int_equal(entry.to, CHESS_SQUARE_E4);
+
+	// Another position always replaces the entry of its slot.
+	chess_transposition_table_store(
+	    &table,
+	    (ChessTranspositionTableEntry){
+	        .key            = 0x1234 + 64,
+	        .score          = 0,
+	        .depth          = 1,
+	        .bound          = CHESS_TRANSPOSITION_TABLE_BOUND_LOWER,
+	        .from           = CHESS_SQUARE_G1,
+	        .to             = CHESS_SQUARE_F3,
+	        .promotion_type = CHESS_PIECE_TYPE_NONE,
+	    }
+	);
+	assert_true(chess_transposition_table_probe(&table, 0x1234 + 64, &entry));
+	assert_false(chess_transposition_table_probe(&table, 0x1234, &entry));
+
+	chess_transposition_table_clear(&table);
+	assert_false(chess_transposition_table_probe(&table, 0x1234 + 64, &entry));
+
+	chess_transposition_table_drop(&table);
+}
+
+static void test_chess_transposition_table_torn_slot(void **state) {
+	(void)state;
+
+	ChessTranspositionTable table = chess_transposition_table_new(64);
+	ChessTranspositionTableEntry entry;
+
+	chess_transposition_table_store(
+	    &table,
+	    (ChessTranspositionTableEntry){
+	        .key            = 0x1234,
+	        .score          = -150,
+	        .depth          = 7,
+	        .bound          = CHESS_TRANSPOSITION_TABLE_BOUND_EXACT,
+	        .from           = CHESS_SQUARE_A7,
+	        .to             = CHESS_SQUARE_A8,
+	        .promotion_type = CHESS_PIECE_TYPE_QUEEN,
+	    }
+	);
+	assert_true(chess_transposition_table_probe(&table, 0x1234, &entry));
+	assert_int_equal(entry.score, -150);
+	assert_int_equal(entry.depth, 7);
+	assert_int_equal(entry.bound, CHESS_TRANSPOSITION_TABLE_BOUND_EXACT);
+	assert_int_equal(entry.from, CHESS_SQUARE_A7);
+	assert_int_equal(entry.to, CHESS_SQUARE_A8);
+	assert_int_equal(entry.promotion_type, CHESS_PIECE_TYPE_QUEEN);
+
+	// A slot whose entry was half overwritten by another thread matches neither position.
+	ChessTranspositionTableSlot *slot = &table.slots[0x1234 & (table.size - 1)];
+	uint64_t key                      = slot->key;
+	chess_transposition_table_store(
+	    &table,
+	    (ChessTranspositionTableEntry){
+	        .key            = 0x1234 + 64,
+	        .score          = 30,
+	        .depth          = 2,
+	        .bound          = CHESS_TRANSPOSITION_TABLE_BOUND_LOWER,
+	        .from           = CHESS_SQUARE_G1,
+	        .to             = CHESS_SQUARE_F3,
+	        .promotion_type = CHESS_PIECE_TYPE_NONE,
+	    }
+	);
+	slot->key = key;
+	assert_false(chess_transposition_table_probe(&table, 0x1234, &entry));
+	assert_false(chess_transposition_table_probe(&table, 0x1234 + 64, &entry));
+
+	chess_transposition_table_drop(&table);
+}
+
+int main(void) {
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_chess_transposition_table_new),
+		cmocka_unit_test(test_chess_transposition_table_probe),
+		cmocka_unit_test(test_chess_transposition_table_torn_slot),
+	};
+
+	return cmocka_run_group_tests(tests, CHESS_NULL, CHESS_NULL);
+}
@@ -0,0 +1,112 @@
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmocka.h>
+
+#include <chess/unmoves.h>
+
+#include <chess/move_private.h>
+#include <chess/moves.h>
+#include <chess/position.h>
+
+#include <string.h>
+
+static void chess_unmoves_check_recursive(const ChessPosition *position, unsigned int depth) {
+	ChessMoves moves = chess_moves_generate(position);
+	for (size_t i = 0; i < moves.count; i++) {
+		ChessMove move                    = moves.moves[i];
+
+		ChessPosition position_after_move = *position;
+		chess_move_do_unchecked(&position_after_move, move);
+
+		ChessUnmoves unmoves = chess_unmoves_generate(&position_after_move);
+
+		// Every unmove leads back to a legal position, from which it is legal.
+		for (size_t j = 0; j < unmoves.count; j++) {
+			ChessPosition position_before_move = position_after_move;
+			chess_move_undo_unchecked(&position_before_move, unmoves.unmoves[j]);
+			assert_true(chess_position_is_valid(&position_before_move));
+			assert_true(chess_move_is_legal(&position_before_move, unmoves.unmoves[j]));
+
+			chess_move_do_unchecked(&position_before_move, unmoves.unmoves[j]);
+			assert_memory_equal(position_before_move.board, position_after_move.board, sizeof(position_after_move.board));
+			if (position_after_move.half_move_clock != 0) {
+				assert_int_equal(position_before_move.half_move_clock, position_after_move.half_move_clock);
+			}
+		}
+
+		// Every move which keeps the castling rights is among the unmoves of the position it leads to.
+		if (position->castling_rights == position_after_move.castling_rights) {
+			bool is_found = false;
+			for (size_t j = 0; j < unmoves.count && !is_found; j++) {
+				is_found = unmoves.unmoves[j].from == move.from &&
+				           unmoves.unmoves[j].to == move.to &&
+				           unmoves.unmoves[j].promotion_type == move.promotion_type &&
+				           unmoves.unmoves[j].captured_piece == move.captured_piece &&
+				           unmoves.unmoves[j].previous_en_passant_square == move.previous_en_passant_square;
+			}
+			assert_true(is_found);
+		}
+
+		if (depth > 1) {
+			chess_unmoves_check_recursive(&position_after_move, depth - 1);
+		}
+	}
+}
+
+static void test_chess_unmoves_generate(void **state) {
+	(void)state;
+
+	static const struct {
+		const char *fen;
+		size_t count;
+		size_t quiet_count;
+	} test_cases[] = {
+		{ "4k3/8/8/8/8/8/8/4K3 b - - 0 1", 25, 5 },
+		{ "4k3/8/8/8/8/8/8/4K3 w - - 0 1", 25, 5 },
+		{ "4k3/8/8/8/4P3/8/8/4K3 b - e3 0 1", 1, 1 },
+		{ "4k3/8/8/8/4P3/8/8/4K3 w - - 0 1", 40, 10 },
+		{ "4k3/8/8/8/4P3/8/8/4K3 w - - 1 1", 10, 10 },
+		{ "4k3/8/8/8/4P3/8/8/4K3 b - e3 1 1", 0, 0 },
+		{ "4k3/8/8/8/8/8/8/R3K3 b Q - 0 1", 0, 0 },
+		{ "4k3/8/8/8/8/8/8/q3K3 w - - 0 1", 60, 11 },
+		{ "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 4, 4 },
+	};
+
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(test_cases); i++) {
+		ChessPosition position = chess_position_new();
+		assert_true(chess_position_from_fen(&position, test_cases[i].fen));
+
+		assert_int_equal(chess_unmoves_generate(&position).count, test_cases[i].count);
+		assert_int_equal(chess_unmoves_generate_quiet(&position).count, test_cases[i].quiet_count);
+	}
+}
+
+static void test_chess_unmoves_round_trip(void **state) {
+	(void)state;
+
+	static const char *const fens[] = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+		"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+	};
+
+	for (size_t i = 0; i < CHESS_ARRAY_LENGTH(fens); i++) {
+		ChessPosition position = chess_position_new();
+		assert_true(chess_position_from_fen(&position, fens[i]));
+
+		chess_unmoves_check_recursive(&position, 2);
+	}
+}
+
+int main(void) {
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_chess_unmoves_generate),
+		cmocka_unit_test(test_chess_unmoves_round_trip),
+	};
+
+	return cmocka_run_group_tests(tests, CHESS_NULL, CHESS_NULL);
+}